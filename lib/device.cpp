@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -29,9 +29,30 @@ device::device()
 {
 }
 
+device::device(const std::string& device_name, const std::string& device_origin)
+: name(device_name),
+  origin(device_origin)
+{
+}
+
 bool device::filled() const
 {
   return !name.empty() && !origin.empty();
 }
 
+bool device::operator==(const device& other) const
+{
+  return (name == other.name) && (origin == other.origin);
+}
+
+bool device::operator<(const device& other) const
+{
+  const int cmp = origin.compare(other.origin);
+  if (cmp != 0)
+  {
+    return cmp < 0;
+  }
+  return name < other.name;
+}
+
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -31,6 +31,13 @@ struct device
 {
   device();
 
+  /** \brief Constructs a device with the given name and origin.
+   *
+   * \param device_name     name of the device
+   * \param device_origin   origin / identifier of the device
+   */
+  device(const std::string& device_name, const std::string& device_origin);
+
   /** \brief Checks whether this instance has valid data.
    *
    * \return Returns true, if this instance has valid data.
@@ -38,6 +45,22 @@ struct device
    */
   bool filled() const;
 
+  /** \brief Checks whether two devices are equal, i. e. whether they have
+   *         the same name and the same origin.
+   *
+   * \param other   the other device
+   * \return Returns true, if both devices are equal.
+   */
+  bool operator==(const device& other) const;
+
+  /** \brief Orders devices by origin, then by name.
+   *
+   * \param other   the other device
+   * \return Returns true, if this device shall be ordered before other.
+   * \remarks This allows to use devices as keys in ordered containers.
+   */
+  bool operator<(const device& other) const;
+
   std::string name;   /**< name of the device */
   std::string origin; /**< origin / identifier of the device */
 };
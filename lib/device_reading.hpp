@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -24,7 +24,7 @@
 #include <chrono>
 #include <cstdint>
 #include <limits>
-#include "device.hpp"
+#include "device_registry.hpp"
 #include "reading_base.hpp"
 
 namespace thermos
@@ -34,7 +34,7 @@ template<typename reading_t>
 struct device_reading
 {
   device_reading()
-  : dev(device()),
+  : dev(device_registry::no_device),
     reading(reading_t())
   {
   }
@@ -48,13 +48,13 @@ struct device_reading
    */
   bool filled() const
   {
-    return dev.filled()
+    return device_registry::get(dev).filled()
       && (reading.value != std::numeric_limits<decltype(reading.value)>::min())
       && (reading.time != reading_base::reading_time_t());
   }
 
 
-  device dev; /**< device from which the reading was obtained */
+  device_handle dev; /**< handle of the device from which the reading was obtained */
   reading_t reading; /**< value and time of the reading */
 };
 
@@ -0,0 +1,95 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "device_registry.hpp"
+#include <deque>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+
+namespace thermos
+{
+
+namespace
+{
+
+/** \brief Data of the registry. */
+struct registry_state
+{
+  registry_state()
+  {
+    devices.emplace_back();
+    handles[devices.front()] = device_registry::no_device;
+  }
+
+  std::shared_mutex mutex; /**< guards devices and handles */
+  std::deque<device> devices; /**< known devices, index is the handle */
+  std::map<device, device_handle> handles; /**< handles of known devices */
+};
+
+registry_state& state()
+{
+  static registry_state registry;
+  return registry;
+}
+
+} // anonymous namespace
+
+device_handle device_registry::intern(const device& dev)
+{
+  auto& registry = state();
+  {
+    std::shared_lock lock(registry.mutex);
+    const auto iter = registry.handles.find(dev);
+    if (iter != registry.handles.end())
+    {
+      return iter->second;
+    }
+  }
+
+  std::unique_lock lock(registry.mutex);
+  // Another thread may have added the device in the meantime.
+  const auto [iter, inserted] = registry.handles.emplace(dev, static_cast<device_handle>(registry.devices.size()));
+  if (inserted)
+  {
+    registry.devices.push_back(dev);
+  }
+  return iter->second;
+}
+
+const device& device_registry::get(const device_handle handle)
+{
+  auto& registry = state();
+  std::shared_lock lock(registry.mutex);
+  if (handle >= registry.devices.size())
+  {
+    return registry.devices.front();
+  }
+  return registry.devices[handle];
+}
+
+std::size_t device_registry::size()
+{
+  auto& registry = state();
+  std::shared_lock lock(registry.mutex);
+  return registry.devices.size();
+}
+
+} // namespace
@@ -0,0 +1,73 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_DEVICE_REGISTRY_HPP
+#define THERMOS_DEVICE_REGISTRY_HPP
+
+#include <cstdint>
+#include "device.hpp"
+
+namespace thermos
+{
+
+/// small integer that identifies a device interned in the device_registry
+using device_handle = uint32_t;
+
+/** \brief Process-wide table of known devices.
+ *
+ * Every distinct device is stored only once. Readings refer to it via a
+ * device_handle instead of carrying their own copies of name and origin.
+ * Devices are never removed, so handles and references returned by get()
+ * stay valid for the whole lifetime of the program. All functions are safe
+ * to call from several threads at once.
+ */
+class device_registry
+{
+  public:
+    /// handle of the empty device, i. e. a device without name and origin
+    static constexpr device_handle no_device = 0;
+
+    /** \brief Gets the handle of a device, adding the device to the registry
+     *         if it is not known yet.
+     *
+     * \param dev   the device
+     * \return Returns the handle of the device.
+     */
+    static device_handle intern(const device& dev);
+
+    /** \brief Gets the device for a handle.
+     *
+     * \param handle   the handle of the device
+     * \return Returns the device for the given handle.
+     *         Returns the empty device, if the handle is unknown.
+     */
+    static const device& get(const device_handle handle);
+
+    /** \brief Gets the number of devices in the registry, including the
+     *         empty device.
+     *
+     * \return Returns the number of known devices.
+     */
+    static std::size_t size();
+};
+
+} // namespace
+
+#endif // THERMOS_DEVICE_REGISTRY_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -64,8 +64,8 @@ nonstd::expected<thermos::load::device_reading, std::string> calculator::current
   const std::uint64_t idle_delta = idle - previous_idle;
 
   thermos::load::device_reading result;
-  result.dev.name = "load";
-  result.dev.origin = "GetSystemTimes";
+  static const device_handle system_times = device_registry::intern(device("load", "GetSystemTimes"));
+  result.dev = system_times;
   result.reading.time = now;
 
   if (total_delta != 0)
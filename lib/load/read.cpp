@@ -19,6 +19,7 @@
 */
 
 #include "read.hpp"
+#include <utility>
 #if defined(_WIN32) || defined(_WIN64)
   #include "read_windows.hpp"
 #elif defined(__linux__) || defined(linux)
@@ -39,4 +40,30 @@ nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_a
   #endif
 }
 
+nonstd::expected<std::vector<thermos::load::device_reading>, std::string> reader::read()
+{
+  #if defined(_WIN32) || defined(_WIN64)
+    return thermos::windows::load::read_all();
+  #elif defined(__linux__) || defined(linux)
+    if (!loadavg.has_value())
+    {
+      auto opened = thermos::linux_like::load::loadavg_reader::open();
+      if (!opened.has_value())
+      {
+        return nonstd::make_unexpected(opened.error());
+      }
+      loadavg.emplace(std::move(opened.value()));
+    }
+    auto readings = loadavg.value().read();
+    if (!readings.has_value())
+    {
+      // Try again with a newly opened file next time.
+      loadavg.reset();
+    }
+    return readings;
+  #else
+    #error Unknown or unsupported operating system!
+  #endif
+}
+
 } // namespace
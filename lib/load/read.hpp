@@ -21,10 +21,14 @@
 #ifndef THERMOS_LOAD_READ_HPP
 #define THERMOS_LOAD_READ_HPP
 
+#include <optional>
 #include <string>
 #include <vector>
 #include "../../third-party/nonstd/expected.hpp"
 #include "reading.hpp"
+#if defined(__linux__) || defined(linux)
+  #include "read_linux.hpp"
+#endif
 
 namespace thermos::load
 {
@@ -37,6 +41,27 @@ namespace thermos::load
  */
 nonstd::expected<std::vector<device_reading>, std::string> read_all();
 
+/** \brief Reads all CPU load data repeatedly.
+ *
+ * On Linux the file /proc/loadavg is opened by the first reading and kept
+ * open for the following ones, as long as it can be read.
+ */
+class reader
+{
+  public:
+    /** \brief Reads all CPU load data.
+     *
+     * \return Returns a vector containing the device readings.
+     *         Returns a string containing an error message, if no readings
+     *         were available.
+     */
+    nonstd::expected<std::vector<device_reading>, std::string> read();
+  private:
+    #if defined(__linux__) || defined(linux)
+    std::optional<linux_like::load::loadavg_reader> loadavg; /**< open /proc/loadavg, if any */
+    #endif
+}; // class
+
 } // namespace
 
 #endif // THERMOS_LOAD_READ_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -20,58 +20,116 @@
 
 #include "read_linux.hpp"
 #if defined(__linux__) || defined(linux)
-#include <filesystem>
-#include <fstream>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace thermos::linux_like::load
 {
 
-nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_proc_loadavg()
+loadavg_reader::loadavg_reader(const std::filesystem::path& file_path, const int descriptor)
+: path(file_path),
+  fd(descriptor)
 {
-  const std::filesystem::path loadavg ("/proc/loadavg");
-  std::error_code error;
-  if (!std::filesystem::exists(loadavg, error) || error)
-    return nonstd::make_unexpected("File " + loadavg.string() + " does not exist.");
-
-  std::ifstream stream(loadavg);
-  double load = -1.0;
-  if (!(stream >> load))
+}
+
+nonstd::expected<loadavg_reader, std::string> loadavg_reader::open(const std::filesystem::path& root)
+{
+  const std::filesystem::path loadavg (root / "proc" / "loadavg");
+  const int descriptor = ::open(loadavg.c_str(), O_RDONLY | O_CLOEXEC);
+  if (descriptor < 0)
+  {
+    return nonstd::make_unexpected("File " + loadavg.string() + " does not exist or cannot be opened.");
+  }
+  return loadavg_reader(loadavg, descriptor);
+}
+
+loadavg_reader::loadavg_reader(loadavg_reader&& other) noexcept
+: path(std::move(other.path)),
+  fd(other.fd)
+{
+  other.fd = -1;
+}
+
+loadavg_reader& loadavg_reader::operator=(loadavg_reader&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (fd >= 0)
+    {
+      close(fd);
+    }
+    path = std::move(other.path);
+    fd = other.fd;
+    other.fd = -1;
+  }
+  return *this;
+}
+
+loadavg_reader::~loadavg_reader()
+{
+  if (fd >= 0)
+  {
+    close(fd);
+  }
+}
+
+nonstd::expected<std::vector<thermos::load::device_reading>, std::string> loadavg_reader::read() const
+{
+  // procfs generates the content anew when the file is read from offset
+  // zero, so there is no need to seek or to reopen the file. The whole file
+  // fits into the buffer, so a single read is enough.
+  char buffer[128];
+  const ssize_t count = pread(fd, buffer, sizeof(buffer) - 1, 0);
+  if (count < 0)
   {
-    return nonstd::make_unexpected("Error while reading load average (1 min) from /proc/loadavg.");
+    return nonstd::make_unexpected("Cannot read from file " + path.string() + ".");
   }
+  buffer[count] = '\0';
+
+  // The devices never change, so they only need to be interned once.
+  static const device_handle devices[3] = {
+    device_registry::intern(device("loadavg1", "/proc/loadavg_1")),
+    device_registry::intern(device("loadavg5", "/proc/loadavg_5")),
+    device_registry::intern(device("loadavg15", "/proc/loadavg_15"))
+  };
+  const char* const spans[3] = { "1 min", "5 min", "15 min" };
+
   const auto now = std::chrono::system_clock::now();
   std::vector<thermos::load::device_reading> result;
   thermos::load::device_reading data;
-  data.dev.name = "loadavg1";
-  data.dev.origin = "/proc/loadavg_1";
-  data.reading.time = now;
-  data.reading.value = static_cast<int64_t>(load * 100.0);
-  result.push_back(data);
-  if (!(stream >> load))
+  const char* position = buffer;
+  for (std::size_t i = 0; i < 3; ++i)
   {
-    return nonstd::make_unexpected("Error while reading load average (5 min) from /proc/loadavg.");
+    char* end = nullptr;
+    const double load = std::strtod(position, &end);
+    if (end == position)
+    {
+      return nonstd::make_unexpected("Error while reading load average (" + std::string(spans[i]) + ") from " + path.string() + ".");
+    }
+    position = end;
+    data.dev = devices[i];
+    data.reading.time = now;
+    data.reading.value = static_cast<int64_t>(load * 100.0);
+    result.push_back(data);
   }
-  data.dev.name = "loadavg5";
-  data.dev.origin = "/proc/loadavg_5";
-  data.reading.time = now;
-  data.reading.value = static_cast<int64_t>(load * 100.0);
-  result.push_back(data);
-  if (!(stream >> load))
-  {
-    return nonstd::make_unexpected("Error while reading load average (15 min) from /proc/loadavg.");
-  }
-  data.dev.name = "loadavg15";
-  data.dev.origin = "/proc/loadavg_15";
-  data.reading.time = now;
-  data.reading.value = static_cast<int64_t>(load * 100.0);
-  result.push_back(data);
 
   return result;
 }
 
-nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_all()
+nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_proc_loadavg(const std::filesystem::path& root)
+{
+  const auto reader = loadavg_reader::open(root);
+  if (!reader.has_value())
+  {
+    return nonstd::make_unexpected(reader.error());
+  }
+  return reader.value().read();
+}
+
+nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_all(const std::filesystem::path& root)
 {
-  return read_proc_loadavg();
+  return read_proc_loadavg(root);
 }
 
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,6 +21,7 @@
 #ifndef THERMOS_READ_LOAD_LINUX_HPP
 #define THERMOS_READ_LOAD_LINUX_HPP
 
+#include <filesystem>
 #include <string>
 #include <vector>
 #include "../../third-party/nonstd/expected.hpp"
@@ -30,12 +31,59 @@
 namespace thermos::linux_like::load
 {
 
+/** \brief Reader for /proc/loadavg that keeps the file open between readings.
+ *
+ * Every reading re-reads the file from the start via pread(), so taking a
+ * reading costs a single system call.
+ */
+class loadavg_reader
+{
+  public:
+    /** \brief Opens /proc/loadavg.
+     *
+     * \param root   the directory that contains the proc directory, usually "/"
+     * \return Returns the reader in case of success.
+     *         Returns an error message, if the file could not be opened.
+     */
+    static nonstd::expected<loadavg_reader, std::string> open(const std::filesystem::path& root = "/");
+
+    loadavg_reader(const loadavg_reader& other) = delete;
+    loadavg_reader& operator=(const loadavg_reader& other) = delete;
+    loadavg_reader(loadavg_reader&& other) noexcept;
+    loadavg_reader& operator=(loadavg_reader&& other) noexcept;
+    ~loadavg_reader();
+
+    /** \brief Reads the current load averages.
+     *
+     * \return Returns a vector containing the device readings, if successful.
+     *         Returns an error message, if the file could not be read.
+     */
+    nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read() const;
+  private:
+    loadavg_reader(const std::filesystem::path& file_path, const int descriptor);
+
+    std::filesystem::path path; /**< path of the file, for error messages */
+    int fd; /**< file descriptor of the file, or -1 */
+}; // class
+
 /** \brief Reads all CPU load data.
  *
+ * \param root   the directory that contains the proc directory, usually "/";
+ *               other values are mostly useful for tests
  * \return Returns a vector containing the device readings, if successful.
  *         Returns an error message, if no readings were available.
  */
-nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_all();
+nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_all(const std::filesystem::path& root = "/");
+
+/** \brief Reads the load averages from /proc/loadavg.
+ *
+ * \param root   the directory that contains the proc directory, usually "/"
+ * \return Returns a vector containing the device readings, if successful.
+ *         Returns an error message, if the file could not be read.
+ * \remarks This opens the file for a single reading. Use loadavg_reader to
+ *          take several readings from the same file.
+ */
+nonstd::expected<std::vector<thermos::load::device_reading>, std::string> read_proc_loadavg(const std::filesystem::path& root = "/");
 
 } // namespace
 #endif // Linux
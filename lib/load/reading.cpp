@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -30,12 +30,7 @@ reading::reading()
 
 double reading::percent() const
 {
-  return static_cast<double>(value);
-}
-
-reading_type reading::type() const
-{
-  return reading_type::load;
+  return to_percent(value);
 }
 
 } // namespace
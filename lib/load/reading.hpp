@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,8 +21,10 @@
 #ifndef THERMOS_LOAD_READING_HPP
 #define THERMOS_LOAD_READING_HPP
 
+#include <type_traits>
 #include "../device_reading.hpp"
 #include "../reading_base.hpp"
+#include "../reading_batch.hpp"
 
 namespace thermos::load
 {
@@ -37,14 +39,33 @@ struct reading: public thermos::reading_base
    */
   double percent() const;
 
+  /** \brief Converts a load value to a percentage.
+   *
+   * \param load   the CPU load as stored in value
+   * \return Returns the CPU load in percent.
+   */
+  static double to_percent(const int64_t load)
+  {
+    return static_cast<double>(load);
+  }
+
   /** \brief Gets the type of the reading, hinting at the implementation.
    *
    * \return Returns the type of the reading.
    */
-  virtual reading_type type() const;
+  static constexpr reading_type type()
+  {
+    return reading_type::load;
+  }
 };
 
+static_assert(std::is_trivially_copyable<reading>::value,
+              "Readings must be trivially copyable.");
+static_assert(sizeof(reading) == sizeof(int64_t) + sizeof(reading::reading_time_t),
+              "Readings must not contain anything but value and time.");
+
 using device_reading = thermos::device_reading<reading>;
+using reading_batch = thermos::reading_batch<reading>;
 
 } // namespace
 
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -28,21 +28,20 @@
 namespace thermos
 {
 
+/** \brief Common data of all readings.
+ *
+ * Readings are plain values without virtual functions: derived types only add
+ * member functions and a static constexpr type(), so that the type of a
+ * reading is known at compile time and readings can be copied with memcpy
+ * and stored contiguously.
+ */
 struct reading_base
 {
   reading_base();
-  virtual ~reading_base() = default;
 
   /// shorthand for time point type
   using reading_time_t = std::chrono::time_point<std::chrono::system_clock>;
 
-
-  /** \brief Gets the type of the reading, hinting at the implementation.
-   *
-   * \return Returns the type of the reading.
-   */
-  virtual reading_type type() const = 0;
-
   int64_t value; /**< value of the reading; meaning depends on type */
   reading_time_t time; /**< time of the reading */
 };
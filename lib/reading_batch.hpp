@@ -0,0 +1,127 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_READING_BATCH_HPP
+#define THERMOS_READING_BATCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "device_reading.hpp"
+#include "device_registry.hpp"
+
+namespace thermos
+{
+
+/** \brief Column-wise container for readings of one type.
+ *
+ * Devices, times and values are kept in separate contiguous arrays, so that
+ * code that only looks at one of them, e. g. when converting all values,
+ * walks over densely packed data.
+ * \param reading_t  type of the readings, e. g. thermal::reading
+ */
+template<typename reading_t>
+struct reading_batch
+{
+  /** \brief Gets the number of readings in the batch.
+   *
+   * \return Returns the number of readings.
+   */
+  std::size_t size() const
+  {
+    return values.size();
+  }
+
+  /** \brief Checks whether the batch contains no readings.
+   *
+   * \return Returns true, if the batch is empty.
+   */
+  bool empty() const
+  {
+    return values.empty();
+  }
+
+  /** \brief Removes all readings from the batch.
+   */
+  void clear()
+  {
+    devices.clear();
+    times.clear();
+    values.clear();
+  }
+
+  /** \brief Reserves space for a number of readings.
+   *
+   * \param count   the number of readings
+   */
+  void reserve(const std::size_t count)
+  {
+    devices.reserve(count);
+    times.reserve(count);
+    values.reserve(count);
+  }
+
+  /** \brief Appends a reading.
+   *
+   * \param dev     handle of the device
+   * \param time    time of the reading in seconds since the Unix epoch
+   * \param value   value of the reading
+   */
+  void push_back(const device_handle dev, const int64_t time, const int64_t value)
+  {
+    devices.push_back(dev);
+    times.push_back(time);
+    values.push_back(value);
+  }
+
+  /** \brief Appends a reading.
+   *
+   * \param reading   the reading to append
+   * \remarks Fractions of a second of the reading time are discarded.
+   */
+  void push_back(const device_reading<reading_t>& reading)
+  {
+    push_back(reading.dev,
+              std::chrono::floor<std::chrono::seconds>(reading.reading.time.time_since_epoch()).count(),
+              reading.reading.value);
+  }
+
+  /** \brief Gets a reading from the batch.
+   *
+   * \param index   zero-based index of the reading, must be less than size()
+   * \return Returns the reading at the given index.
+   */
+  device_reading<reading_t> get(const std::size_t index) const
+  {
+    device_reading<reading_t> result;
+    result.dev = devices[index];
+    result.reading.time = typename reading_t::reading_time_t(std::chrono::seconds(times[index]));
+    result.reading.value = values[index];
+    return result;
+  }
+
+  std::vector<device_handle> devices; /**< device of each reading */
+  std::vector<int64_t> times; /**< time of each reading in seconds since the Unix epoch */
+  std::vector<int64_t> values; /**< value of each reading */
+};
+
+} // namespace
+
+#endif // THERMOS_READING_BATCH_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos, with earlier code from botvinnik Matrix bot.
-    Copyright (C) 2020, 2022  Dirk Stolle
+    Copyright (C) 2020, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,7 @@
 */
 
 #include "database.hpp"
+#include <algorithm>
 #include <iostream>
 #include <limits>
 
@@ -26,10 +27,69 @@
 namespace thermos::sqlite
 {
 
-nonstd::expected<database, std::string> database::open(const std::string& fileName)
+namespace
+{
+
+/** \brief Creates an URI for a database file that can be passed to
+ *         sqlite3_open_v2() with the flag SQLITE_OPEN_URI.
+ *
+ * \param fileName   name of the database file
+ * \param query      query parameters without the leading '?'
+ * \return Returns the URI.
+ */
+std::string file_uri(const std::string& fileName, const std::string& query)
+{
+  std::string uri = "file:";
+  #if defined(_WIN32)
+  // Absolute paths with drive letters need a leading slash.
+  if ((fileName.size() >= 2) && (fileName[1] == ':'))
+  {
+    uri.push_back('/');
+  }
+  #endif
+  for (const char c: fileName)
+  {
+    switch (c)
+    {
+      case '%':
+           uri.append("%25");
+           break;
+      case '?':
+           uri.append("%3f");
+           break;
+      case '#':
+           uri.append("%23");
+           break;
+      #if defined(_WIN32)
+      case '\\':
+           uri.push_back('/');
+           break;
+      #endif
+      default:
+           uri.push_back(c);
+           break;
+    }
+  }
+  return uri.append("?").append(query);
+}
+
+} // anonymous namespace
+
+nonstd::expected<database, std::string> database::open(const std::string& fileName, const options& opts)
 {
   sqlite3* dbPtr = nullptr;
-  const int errorCode = sqlite3_open(fileName.c_str(), &dbPtr);
+  int errorCode = SQLITE_OK;
+  if (opts.immutable)
+  {
+    const std::string uri = file_uri(fileName, "immutable=1");
+    errorCode = sqlite3_open_v2(uri.c_str(), &dbPtr, SQLITE_OPEN_READONLY | SQLITE_OPEN_URI, nullptr);
+  }
+  else
+  {
+    const int flags = opts.read_only ? SQLITE_OPEN_READONLY
+                                     : (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    errorCode = sqlite3_open_v2(fileName.c_str(), &dbPtr, flags, nullptr);
+  }
   if (errorCode != SQLITE_OK)
   {
     std::string message = "Error: Could not open database " + fileName
@@ -38,11 +98,73 @@ nonstd::expected<database, std::string> database::open(const std::string& fileNa
     return nonstd::make_unexpected(message);
   }
 
-  return database({ dbPtr, sqlite3_close });
+  // sqlite3_close_v2() defers closing until all statements of the connection
+  // have been finalized, so statements may outlive the database instance.
+  database db({ dbPtr, sqlite3_close_v2 });
+  const auto error = db.apply(opts);
+  if (error.has_value())
+  {
+    return nonstd::make_unexpected("Error: Could not configure database "
+        + fileName + ": " + error.value());
+  }
+  return db;
+}
+
+std::optional<std::string> database::apply(const options& opts)
+{
+  if (opts.busy_timeout.count() > 0)
+  {
+    const auto timeout = std::min<int64_t>(opts.busy_timeout.count(), std::numeric_limits<int>::max());
+    sqlite3_busy_timeout(handle.get(), static_cast<int>(timeout));
+  }
+
+  if (opts.journal.has_value())
+  {
+    const std::string mode = to_string(opts.journal.value());
+    auto maybe_stmt = prepare("PRAGMA journal_mode = " + mode + ";");
+    if (!maybe_stmt.has_value())
+    {
+      return maybe_stmt.error();
+    }
+    auto& stmt = maybe_stmt.value();
+    if (sqlite3_step(stmt.ptr()) != SQLITE_ROW)
+    {
+      return std::string("Failed to set journal mode: ") + sqlite3_errmsg(handle.get());
+    }
+    // SQLite returns the journal mode that is actually used, e.g. in-memory
+    // databases cannot use a write-ahead log.
+    const auto actual = reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 0));
+    if ((actual == nullptr) || (mode != actual))
+    {
+      return "The journal mode " + mode + " is not available, the database uses "
+          + (actual != nullptr ? std::string(actual) : std::string("an unknown mode"))
+          + " instead.";
+    }
+  }
+
+  if (opts.synchronous.has_value()
+      && !exec("PRAGMA synchronous = " + to_string(opts.synchronous.value()) + ";"))
+  {
+    return "Failed to set synchronous level.";
+  }
+  if (opts.mmap_size.has_value()
+      && !exec("PRAGMA mmap_size = " + std::to_string(opts.mmap_size.value()) + ";"))
+  {
+    return "Failed to set size of memory-mapped I/O.";
+  }
+  // Negative values of cache_size are in KiB instead of pages.
+  if (opts.cache_size.has_value()
+      && !exec("PRAGMA cache_size = -" + std::to_string(opts.cache_size.value()) + ";"))
+  {
+    return "Failed to set cache size.";
+  }
+
+  return std::nullopt;
 }
 
 database::database(std::unique_ptr<sqlite3, decltype(&sqlite3_close)>&& the_handle)
-: handle(std::move(the_handle))
+: handle(std::move(the_handle)),
+  statements(std::make_shared<statement_cache>(default_cache_capacity))
 {
 }
 
@@ -81,7 +203,11 @@ nonstd::expected<statement, std::string> database::prepare(const std::string& sq
   {
     return nonstd::make_unexpected("SQL statement is too long to be prepared!");
   }
-  sqlite3_stmt * stmt = nullptr;
+  sqlite3_stmt * stmt = statements->take(sqlStmt);
+  if (stmt != nullptr)
+  {
+    return statement(stmt, sqlStmt, statements);
+  }
   const int errorCode = sqlite3_prepare_v2(handle.get(), sqlStmt.c_str(), static_cast<int>(len), &stmt, nullptr);
   if (errorCode != SQLITE_OK)
   {
@@ -90,7 +216,7 @@ nonstd::expected<statement, std::string> database::prepare(const std::string& sq
     return nonstd::make_unexpected(message);
   }
 
-  return statement({ stmt, sqlite3_finalize });
+  return statement(stmt, sqlStmt, statements);
 }
 
 int64_t database::last_insert_id() const
@@ -98,6 +224,39 @@ int64_t database::last_insert_id() const
   return sqlite3_last_insert_rowid(handle.get());
 }
 
+int64_t database::changes() const
+{
+  return sqlite3_changes64(handle.get());
+}
+
+nonstd::expected<int64_t, std::string> database::user_version()
+{
+  auto maybe_stmt = prepare("PRAGMA user_version;");
+  if (!maybe_stmt.has_value())
+  {
+    return nonstd::make_unexpected(maybe_stmt.error());
+  }
+  auto& stmt = maybe_stmt.value();
+  if (sqlite3_step(stmt.ptr()) != SQLITE_ROW)
+  {
+    return nonstd::make_unexpected(std::string("Error while retrieving user version of database: ")
+                                   + sqlite3_errmsg(handle.get()));
+  }
+  return sqlite3_column_int64(stmt.ptr(), 0);
+}
+
+bool database::set_user_version(const int64_t version)
+{
+  // Pragmas do not support bound parameters, so the value has to be part of
+  // the SQL text.
+  return exec("PRAGMA user_version = " + std::to_string(version) + ";");
+}
+
+const statement_cache& database::cached_statements() const
+{
+  return *statements;
+}
+
 nonstd::expected<bool, std::string> database::table_exists(const std::string& table)
 {
   auto maybe_stmt = prepare("SELECT COUNT(*) FROM sqlite_master WHERE type='table' AND name = @tn;");
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos, with earlier code from botvinnik Matrix bot.
-    Copyright (C) 2020, 2022, 2025  Dirk Stolle
+    Copyright (C) 2020, 2022, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -24,10 +24,13 @@
 #if !defined(THERMOS_NO_SQLITE)
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <sqlite3.h>
 #include "../../third-party/nonstd/expected.hpp"
+#include "options.hpp"
 #include "statement.hpp"
+#include "statement_cache.hpp"
 
 namespace thermos::sqlite
 {
@@ -38,12 +41,17 @@ class database
     /** \brief Opens a new SQLite 3 database connection.
      *
      * If a file with the given name already exists, it will be opened.
-     * If no such file exists, it will be created.
+     * If no such file exists, it will be created, unless the database is
+     * opened read-only. Immutable databases are opened read-only via an URI
+     * with the immutable parameter, so SQLite does not use any locks. That
+     * is only safe, if no other connection writes to the file.
      * \param fileName   name of the database file to open / create
+     * \param opts       settings that are applied to the connection
      * \return Returns database connection.
-     *         If no database could be opened / created, an error message is returned.
+     *         If no database could be opened / created or if the options
+     *         could not be applied, an error message is returned.
      */
-    static nonstd::expected<database, std::string> open(const std::string& fileName);
+    static nonstd::expected<database, std::string> open(const std::string& fileName, const options& opts = options());
 
 
     /** \brief Executes an SQL statement.
@@ -67,6 +75,11 @@ class database
      * \param sqlStmt   SQL for the prepared statement
      * \return Returns the prepared statement.
      *         If no statement could be prepared, an error message is returned.
+     * \remarks Statements are taken from the statement cache of the connection,
+     *          if possible. A statement from the cache has been reset and has
+     *          no bound parameters, so it behaves like a freshly prepared one.
+     *          Statements are handed back to the cache when they go out of
+     *          scope.
      */
     nonstd::expected<statement, std::string> prepare(const std::string& sqlStmt);
 
@@ -77,6 +90,14 @@ class database
      */
     int64_t last_insert_id() const;
 
+    /** \brief Gets the number of rows changed by the latest INSERT, UPDATE or
+     *         DELETE statement.
+     *
+     * \return Returns the number of rows that were modified, inserted or
+     *         deleted by the most recently completed statement.
+     */
+    int64_t changes() const;
+
     /** \brief Checks whether a certain table exists.
      *
      * \param table   name of the table
@@ -84,10 +105,47 @@ class database
      *         If an error occurred, an message is returned instead.
      */
     nonstd::expected<bool, std::string> table_exists(const std::string& table);
+
+    /** \brief Gets the user version of the database, i. e. the value of the
+     *         user_version pragma.
+     *
+     * \return Returns the user version. New databases have version zero.
+     *         If an error occurred, an message is returned instead.
+     */
+    nonstd::expected<int64_t, std::string> user_version();
+
+    /** \brief Sets the user version of the database.
+     *
+     * \param version   the new user version
+     * \return Returns true, if the version was set successfully.
+     *         Returns false otherwise.
+     */
+    bool set_user_version(const int64_t version);
+
+    /** \brief Gets the cache of prepared statements, e. g. to query its
+     *         hit and miss counters.
+     *
+     * \return Returns the statement cache of this connection.
+     */
+    const statement_cache& cached_statements() const;
+
+    /// default maximum number of cached prepared statements per connection
+    static constexpr std::size_t default_cache_capacity = 32;
   private:
+    /** \brief Applies the pragmas of the options to the connection.
+     *
+     * \param opts   the options to apply
+     * \return Returns an empty optional in case of success.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> apply(const options& opts);
+
     database(std::unique_ptr<sqlite3, decltype(&sqlite3_close)>&& the_handle);
 
     std::unique_ptr<sqlite3, decltype(&sqlite3_close)> handle;
+    // Note: The cache has to be declared after the handle, because the cached
+    // statements need to be finalized before the connection can be closed.
+    std::shared_ptr<statement_cache> statements; /**< cache of prepared statements */
 };
 
 }
@@ -0,0 +1,209 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "options.hpp"
+#include <charconv>
+#include <stdexcept>
+
+namespace thermos::sqlite
+{
+
+std::string to_string(const journal_mode mode)
+{
+  switch (mode)
+  {
+    case journal_mode::delete_journal:
+         return "delete";
+    case journal_mode::truncate:
+         return "truncate";
+    case journal_mode::persist:
+         return "persist";
+    case journal_mode::wal:
+         return "wal";
+    default:
+         throw std::invalid_argument("Invalid journal_mode value in to_string!");
+  }
+}
+
+std::optional<journal_mode> parse_journal_mode(const std::string& name)
+{
+  for (const auto mode: { journal_mode::delete_journal, journal_mode::truncate,
+                          journal_mode::persist, journal_mode::wal })
+  {
+    if (name == to_string(mode))
+    {
+      return mode;
+    }
+  }
+  return std::nullopt;
+}
+
+std::string to_string(const synchronous_level level)
+{
+  switch (level)
+  {
+    case synchronous_level::off:
+         return "off";
+    case synchronous_level::normal:
+         return "normal";
+    case synchronous_level::full:
+         return "full";
+    case synchronous_level::extra:
+         return "extra";
+    default:
+         throw std::invalid_argument("Invalid synchronous_level value in to_string!");
+  }
+}
+
+std::optional<synchronous_level> parse_synchronous_level(const std::string& name)
+{
+  for (const auto level: { synchronous_level::off, synchronous_level::normal,
+                           synchronous_level::full, synchronous_level::extra })
+  {
+    if (name == to_string(level))
+    {
+      return level;
+    }
+  }
+  return std::nullopt;
+}
+
+options options::for_writing()
+{
+  options result;
+  result.journal = journal_mode::wal;
+  result.synchronous = synchronous_level::normal;
+  result.busy_timeout = std::chrono::milliseconds(5000);
+  return result;
+}
+
+options options::for_reading()
+{
+  options result;
+  result.mmap_size = 256 * 1024 * 1024;
+  result.busy_timeout = std::chrono::milliseconds(5000);
+  result.read_only = true;
+  return result;
+}
+
+namespace
+{
+
+/** \brief Parses a non-negative integer.
+ *
+ * \param text   the text to parse
+ * \return Returns the number, if the whole text is a non-negative integer.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<int64_t> parse_count(const std::string& text)
+{
+  int64_t value = 0;
+  const char* last = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), last, value);
+  if ((ec != std::errc()) || (ptr != last) || text.empty() || (value < 0))
+  {
+    return std::nullopt;
+  }
+  return value;
+}
+
+} // anonymous namespace
+
+nonstd::expected<options, std::string> options::parse(const std::string& text, const options& base)
+{
+  options result = base;
+
+  std::string::size_type start = 0;
+  while (start <= text.size())
+  {
+    auto end = text.find(',', start);
+    if (end == std::string::npos)
+    {
+      end = text.size();
+    }
+    const std::string entry = text.substr(start, end - start);
+    start = end + 1;
+
+    const auto equals = entry.find('=');
+    if (equals == std::string::npos)
+    {
+      return nonstd::make_unexpected("'" + entry + "' is not a valid SQLite "
+          + "option. Options have to look like 'journal_mode=wal'.");
+    }
+    const std::string name = entry.substr(0, equals);
+    const std::string value = entry.substr(equals + 1);
+
+    if (name == "journal_mode")
+    {
+      result.journal = parse_journal_mode(value);
+      if (!result.journal.has_value())
+      {
+        return nonstd::make_unexpected("'" + value + "' is not a valid journal "
+            + "mode. Allowed modes are delete, truncate, persist and wal.");
+      }
+    }
+    else if (name == "synchronous")
+    {
+      result.synchronous = parse_synchronous_level(value);
+      if (!result.synchronous.has_value())
+      {
+        return nonstd::make_unexpected("'" + value + "' is not a valid "
+            + "synchronous level. Allowed levels are off, normal, full and extra.");
+      }
+    }
+    else if ((name == "mmap_size") || (name == "cache_size") || (name == "busy_timeout"))
+    {
+      const auto count = parse_count(value);
+      if (!count.has_value())
+      {
+        return nonstd::make_unexpected("'" + value + "' is not a valid value "
+            + "for " + name + ". It has to be a non-negative integer.");
+      }
+      if (name == "mmap_size")
+        result.mmap_size = count.value();
+      else if (name == "cache_size")
+        result.cache_size = count.value();
+      else
+        result.busy_timeout = std::chrono::milliseconds(count.value());
+    }
+    else if ((name == "read_only") || (name == "immutable"))
+    {
+      if ((value != "true") && (value != "false"))
+      {
+        return nonstd::make_unexpected("'" + value + "' is not a valid value "
+            + "for " + name + ". It has to be either true or false.");
+      }
+      if (name == "read_only")
+        result.read_only = value == "true";
+      else
+        result.immutable = value == "true";
+    }
+    else
+    {
+      return nonstd::make_unexpected("'" + name + "' is not a known SQLite "
+          + "option. Known options are journal_mode, synchronous, mmap_size, "
+          + "cache_size, busy_timeout, read_only and immutable.");
+    }
+  }
+
+  return result;
+}
+
+} // namespace
@@ -0,0 +1,141 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_SQLITE3_OPTIONS_HPP
+#define THERMOS_SQLITE3_OPTIONS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "../../third-party/nonstd/expected.hpp"
+
+namespace thermos::sqlite
+{
+
+enum class journal_mode
+{
+  /// rollback journal that is deleted at the end of each transaction
+  delete_journal,
+
+  /// rollback journal that is truncated at the end of each transaction
+  truncate,
+
+  /// rollback journal whose header is zeroed at the end of each transaction
+  persist,
+
+  /// write-ahead log, readers do not block the writer and vice versa
+  wal
+};
+
+/** \brief Converts a journal_mode to a string.
+ *
+ * \param mode   the journal mode
+ * \return Returns the name of the mode as used by the journal_mode pragma.
+ */
+std::string to_string(const journal_mode mode);
+
+/** \brief Parses a journal mode from its name.
+ *
+ * \param name   name of the mode, e.g. "wal"
+ * \return Returns the mode, if the name is known.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<journal_mode> parse_journal_mode(const std::string& name);
+
+enum class synchronous_level
+{
+  /// no syncing, data may be lost or corrupted on power loss
+  off,
+
+  /// sync at critical moments, safe from corruption in WAL mode
+  normal,
+
+  /// sync after each transaction, default of SQLite
+  full,
+
+  /// like full, but also syncs the directory after deleting the journal
+  extra
+};
+
+/** \brief Converts a synchronous_level to a string.
+ *
+ * \param level   the synchronous level
+ * \return Returns the name of the level as used by the synchronous pragma.
+ */
+std::string to_string(const synchronous_level level);
+
+/** \brief Parses a synchronous level from its name.
+ *
+ * \param name   name of the level, e.g. "normal"
+ * \return Returns the level, if the name is known.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<synchronous_level> parse_synchronous_level(const std::string& name);
+
+/** \brief Settings that are applied when a database connection is opened.
+ *
+ * Settings that are not set keep the defaults of SQLite or, in case of the
+ * journal mode, the mode that is stored in the database file.
+ */
+struct options
+{
+  std::optional<journal_mode> journal; /**< journal mode of the database */
+  std::optional<synchronous_level> synchronous; /**< how often data is synced to disk */
+  std::optional<int64_t> mmap_size; /**< maximum number of bytes of the file that are memory-mapped */
+  std::optional<int64_t> cache_size; /**< size of the page cache in KiB */
+  std::chrono::milliseconds busy_timeout = std::chrono::milliseconds(0); /**< maximum time to wait for locks of other connections */
+  bool read_only = false; /**< whether the database is opened read-only */
+  bool immutable = false; /**< whether the file is assumed to never change, implies read_only */
+
+  /** \brief Gets the options for connections that log readings.
+   *
+   * \return Returns options with write-ahead log, synchronous level normal
+   *         and a busy timeout of five seconds, so that readers do not block
+   *         the logger.
+   */
+  static options for_writing();
+
+  /** \brief Gets the options for connections that only read readings.
+   *
+   * \return Returns read-only options with 256 MiB of memory-mapped I/O and
+   *         a busy timeout of five seconds.
+   */
+  static options for_reading();
+
+  /** \brief Parses options from a string.
+   *
+   * The string is a comma-separated list of entries like "journal_mode=wal".
+   * Allowed entries are journal_mode (delete, truncate, persist or wal),
+   * synchronous (off, normal, full or extra), mmap_size (in bytes),
+   * cache_size (in KiB), busy_timeout (in milliseconds), read_only and
+   * immutable (both true or false).
+   * \param text   the string to parse
+   * \param base   options whose values are used for all entries that are
+   *               not given in the string
+   * \return Returns the parsed options in case of success.
+   *         Returns an error message, if the string contains invalid entries.
+   */
+  static nonstd::expected<options, std::string> parse(const std::string& text, const options& base);
+};
+
+} // namespace
+
+#endif // THERMOS_SQLITE3_OPTIONS_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos, with earlier code from botvinnik Matrix bot.
-    Copyright (C) 2020, 2022  Dirk Stolle
+    Copyright (C) 2020, 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,29 +19,84 @@
 */
 
 #include "statement.hpp"
+#include <utility>
 
 #if !defined(THERMOS_NO_SQLITE)
 namespace thermos::sqlite
 {
 
-statement::statement(std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>&& s)
-: stmt(std::move(s))
+statement::statement(sqlite3_stmt* s, const std::string& sql_text, std::weak_ptr<statement_cache> the_cache)
+: stmt(s),
+  sql(sql_text),
+  cache(std::move(the_cache))
 {
 }
 
+statement::statement(statement&& other) noexcept
+: stmt(std::exchange(other.stmt, nullptr)),
+  sql(std::move(other.sql)),
+  cache(std::move(other.cache))
+{
+}
+
+statement& statement::operator=(statement&& other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    stmt = std::exchange(other.stmt, nullptr);
+    sql = std::move(other.sql);
+    cache = std::move(other.cache);
+  }
+  return *this;
+}
+
+statement::~statement()
+{
+  release();
+}
+
+void statement::release()
+{
+  if (stmt == nullptr)
+  {
+    return;
+  }
+
+  const auto the_cache = cache.lock();
+  if (the_cache != nullptr)
+  {
+    the_cache->put(sql, stmt);
+  }
+  else
+  {
+    sqlite3_finalize(stmt);
+  }
+  stmt = nullptr;
+}
+
 bool statement::bind(const int index, const std::string& value)
 {
-  return sqlite3_bind_text(stmt.get(), index, value.c_str(), static_cast<int>(value.size()), SQLITE_TRANSIENT) == SQLITE_OK;
+  return sqlite3_bind_text(stmt, index, value.c_str(), static_cast<int>(value.size()), SQLITE_TRANSIENT) == SQLITE_OK;
 }
 
 bool statement::bind(const int index, const int64_t value)
 {
-  return sqlite3_bind_int64(stmt.get(), index, value) == SQLITE_OK;
+  return sqlite3_bind_int64(stmt, index, value) == SQLITE_OK;
+}
+
+bool statement::reset()
+{
+  // Note: sqlite3_reset() returns the error code of the most recent step, if
+  // that step failed. So only the result of clearing the bindings is relevant
+  // to determine whether the statement can be used again.
+  sqlite3_reset(stmt);
+  return sqlite3_clear_bindings(stmt) == SQLITE_OK;
 }
 
 sqlite3_stmt* statement::ptr() const
 {
-  return stmt.get();
+  return stmt;
 }
 
 } // namespace
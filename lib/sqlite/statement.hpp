@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos, with earlier code from botvinnik Matrix bot.
-    Copyright (C) 2020, 2022, 2025  Dirk Stolle
+    Copyright (C) 2020, 2022, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -26,6 +26,7 @@
 #include <memory>
 #include <string>
 #include <sqlite3.h>
+#include "statement_cache.hpp"
 
 namespace thermos::sqlite
 {
@@ -33,9 +34,23 @@ namespace thermos::sqlite
 /// Forward declaration for use in friend declaration.
 class database;
 
+/** \brief Prepared statement of a database connection.
+ *
+ * When the statement is destroyed, it is handed back to the statement cache
+ * of the database connection that prepared it, if that connection is still
+ * open. Otherwise it is finalized.
+ */
 class statement
 {
   public:
+    statement(const statement& other) = delete;
+    statement& operator=(const statement& other) = delete;
+
+    statement(statement&& other) noexcept;
+    statement& operator=(statement&& other) noexcept;
+
+    ~statement();
+
     /** \brief Binds a string parameter to a prepared statement.
      *
      * \param index  index of the parameter to bind (first parameter has index 1)
@@ -53,6 +68,13 @@ class statement
      */
     bool bind(const int index, const int64_t value);
 
+    /** \brief Resets the prepared statement and clears all bound parameters,
+     * so that it can be executed again with new parameter values.
+     *
+     * \return Returns whether the reset was successful.
+     */
+    bool reset();
+
     /** \brief Gets the internal pointer.
      *
      * \return Returns the internal pointer for the prepared statement.
@@ -60,9 +82,14 @@ class statement
     sqlite3_stmt* ptr() const;
   private:
     friend database;
-    statement(std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>&& s);
+    statement(sqlite3_stmt* s, const std::string& sql_text, std::weak_ptr<statement_cache> the_cache);
+
+    /// Hands the statement back to the cache or finalizes it.
+    void release();
 
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> stmt;
+    sqlite3_stmt* stmt; /**< the prepared statement, owned by this instance */
+    std::string sql; /**< SQL text of the statement, used as cache key */
+    std::weak_ptr<statement_cache> cache; /**< cache of the database connection */
 };
 
 }
@@ -0,0 +1,110 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "statement_cache.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+namespace thermos::sqlite
+{
+
+statement_cache::statement_cache(const std::size_t capacity)
+: entries({}),
+  index({}),
+  max_size(capacity),
+  hit_count(0),
+  miss_count(0)
+{
+}
+
+statement_cache::~statement_cache()
+{
+  for (const auto& [sql, stmt]: entries)
+  {
+    sqlite3_finalize(stmt);
+  }
+}
+
+sqlite3_stmt* statement_cache::take(const std::string& sql)
+{
+  const auto iter = index.find(sql);
+  if (iter == index.end())
+  {
+    ++miss_count;
+    return nullptr;
+  }
+
+  ++hit_count;
+  sqlite3_stmt* stmt = iter->second->second;
+  entries.erase(iter->second);
+  index.erase(iter);
+  return stmt;
+}
+
+void statement_cache::put(const std::string& sql, sqlite3_stmt* stmt)
+{
+  if (stmt == nullptr)
+  {
+    return;
+  }
+  if ((max_size == 0) || (index.find(sql) != index.end()))
+  {
+    sqlite3_finalize(stmt);
+    return;
+  }
+
+  // Resetting releases any locks the statement may still hold, even if it
+  // has not been stepped through all result rows.
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  if (entries.size() >= max_size)
+  {
+    const auto& oldest = entries.back();
+    sqlite3_finalize(oldest.second);
+    index.erase(oldest.first);
+    entries.pop_back();
+  }
+  entries.emplace_front(sql, stmt);
+  index[sql] = entries.begin();
+}
+
+std::size_t statement_cache::size() const
+{
+  return entries.size();
+}
+
+std::size_t statement_cache::capacity() const
+{
+  return max_size;
+}
+
+uint64_t statement_cache::hits() const
+{
+  return hit_count;
+}
+
+uint64_t statement_cache::misses() const
+{
+  return miss_count;
+}
+
+} // namespace
+
+#endif // SQLite feature guard
@@ -0,0 +1,115 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_SQLITE3_STATEMENT_CACHE_HPP
+#define THERMOS_SQLITE3_STATEMENT_CACHE_HPP
+
+#if !defined(THERMOS_NO_SQLITE)
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <sqlite3.h>
+
+namespace thermos::sqlite
+{
+
+/** \brief Least recently used (LRU) cache of prepared statements of a single
+ *         database connection, keyed by their SQL text.
+ *
+ * Statements in the cache are not in use. They have been reset and their
+ * bindings have been cleared, so they can be handed out again as if they
+ * had just been prepared.
+ */
+class statement_cache
+{
+  public:
+    /** \brief Creates an empty cache.
+     *
+     * \param capacity   maximum number of statements kept in the cache;
+     *                   zero disables caching
+     */
+    explicit statement_cache(const std::size_t capacity);
+
+    statement_cache(const statement_cache& other) = delete;
+    statement_cache& operator=(const statement_cache& other) = delete;
+
+    /// Finalizes all cached statements.
+    ~statement_cache();
+
+    /** \brief Takes a statement out of the cache.
+     *
+     * \param sql   SQL text of the statement
+     * \return Returns the cached statement, if there is one for the given SQL.
+     *         Returns nullptr otherwise. The caller owns the returned statement
+     *         until it gets handed back via put() or is finalized.
+     */
+    sqlite3_stmt* take(const std::string& sql);
+
+    /** \brief Hands a statement that is no longer used back to the cache.
+     *
+     * The statement gets reset and its bindings are cleared. If the cache is
+     * full, the least recently used statement is finalized. If the cache
+     * already contains a statement with the same SQL, then the given
+     * statement is finalized instead.
+     * \param sql    SQL text of the statement
+     * \param stmt   the statement
+     */
+    void put(const std::string& sql, sqlite3_stmt* stmt);
+
+    /** \brief Gets the number of statements currently in the cache.
+     *
+     * \return Returns the number of cached statements.
+     */
+    std::size_t size() const;
+
+    /** \brief Gets the maximum number of statements in the cache.
+     *
+     * \return Returns the capacity of the cache.
+     */
+    std::size_t capacity() const;
+
+    /** \brief Gets the number of calls to take() that returned a statement.
+     *
+     * \return Returns the number of cache hits.
+     */
+    uint64_t hits() const;
+
+    /** \brief Gets the number of calls to take() that returned nullptr.
+     *
+     * \return Returns the number of cache misses.
+     */
+    uint64_t misses() const;
+  private:
+    using entry = std::pair<std::string, sqlite3_stmt*>;
+
+    std::list<entry> entries; /**< cached statements, most recently used first */
+    std::unordered_map<std::string, std::list<entry>::iterator> index; /**< SQL text to list position */
+    std::size_t max_size; /**< capacity of the cache */
+    uint64_t hit_count; /**< number of cache hits */
+    uint64_t miss_count; /**< number of cache misses */
+};
+
+} // namespace
+
+#endif // SQLite feature guard
+
+#endif // THERMOS_SQLITE3_STATEMENT_CACHE_HPP
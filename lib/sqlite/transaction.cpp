@@ -0,0 +1,89 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "transaction.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+namespace thermos::sqlite
+{
+
+nonstd::expected<transaction, std::string> transaction::begin(database& db)
+{
+  if (!db.exec("BEGIN TRANSACTION;"))
+  {
+    return nonstd::make_unexpected("Error: Could not start database transaction!");
+  }
+
+  return transaction(db);
+}
+
+transaction::transaction(database& the_db)
+: db(&the_db)
+{
+}
+
+transaction::transaction(transaction&& other) noexcept
+: db(other.db)
+{
+  other.db = nullptr;
+}
+
+transaction::~transaction()
+{
+  if (active())
+  {
+    rollback();
+  }
+}
+
+std::optional<std::string> transaction::commit()
+{
+  if (!active())
+  {
+    return "Error: Transaction is not active and cannot be committed!";
+  }
+  if (!db->exec("COMMIT TRANSACTION;"))
+  {
+    return "Error: Could not commit database transaction!";
+  }
+
+  db = nullptr;
+  return std::nullopt;
+}
+
+bool transaction::rollback()
+{
+  if (!active())
+  {
+    return false;
+  }
+  const bool success = db->exec("ROLLBACK TRANSACTION;");
+  db = nullptr;
+  return success;
+}
+
+bool transaction::active() const
+{
+  return db != nullptr;
+}
+
+} // namespace
+
+#endif // SQLite feature guard
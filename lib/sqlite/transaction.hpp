@@ -0,0 +1,87 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_SQLITE3_TRANSACTION_HPP
+#define THERMOS_SQLITE3_TRANSACTION_HPP
+
+#if !defined(THERMOS_NO_SQLITE)
+#include <optional>
+#include <string>
+#include "../../third-party/nonstd/expected.hpp"
+#include "database.hpp"
+
+namespace thermos::sqlite
+{
+
+/** \brief Scope guard for a database transaction.
+ *
+ * If the transaction has not been committed when the instance goes out of
+ * scope, then the transaction is rolled back.
+ */
+class transaction
+{
+  public:
+    /** \brief Starts a new transaction.
+     *
+     * \param db   the database on which the transaction shall be started
+     * \return Returns the transaction object, if the transaction was started.
+     *         Returns an error message otherwise.
+     */
+    static nonstd::expected<transaction, std::string> begin(database& db);
+
+    transaction(const transaction& other) = delete;
+    transaction& operator=(const transaction& other) = delete;
+    transaction(transaction&& other) noexcept;
+    transaction& operator=(transaction&& other) = delete;
+
+    /** \brief Destructor; rolls back the transaction, if it is still active.
+     */
+    ~transaction();
+
+    /** \brief Commits the transaction.
+     *
+     * \return Returns an empty optional, if the transaction was committed.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> commit();
+
+    /** \brief Rolls back the transaction.
+     *
+     * \return Returns whether the rollback was successful.
+     */
+    bool rollback();
+
+    /** \brief Checks whether the transaction is still active, i. e. whether it
+     *         was neither committed nor rolled back yet.
+     *
+     * \return Returns true, if the transaction is still active.
+     */
+    bool active() const;
+  private:
+    explicit transaction(database& db);
+
+    database* db; /**< database of the transaction; nullptr, if inactive */
+};
+
+} // namespace
+
+#endif // SQLite feature guard
+
+#endif // THERMOS_SQLITE3_TRANSACTION_HPP
@@ -0,0 +1,100 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "buffered_writer.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace thermos::storage
+{
+
+nonstd::expected<buffered_writer, std::string> buffered_writer::open(const std::string& file_name, const std::size_t capacity)
+{
+  buffered_writer writer(file_name, capacity);
+  if (!writer.stream.good())
+  {
+    return nonstd::make_unexpected("Failed to create or open file " + file_name + ".");
+  }
+  return writer;
+}
+
+buffered_writer::buffered_writer(const std::string& file_name, const std::size_t capacity)
+: name(file_name),
+  stream(file_name, std::ios_base::out | std::ios_base::app),
+  buffer(std::max(capacity, minimum_capacity)),
+  used(0)
+{
+}
+
+buffered_writer::buffered_writer(buffered_writer&& other) noexcept
+: name(std::move(other.name)),
+  stream(std::move(other.stream)),
+  buffer(std::move(other.buffer)),
+  used(other.used)
+{
+  other.used = 0;
+}
+
+buffered_writer& buffered_writer::operator=(buffered_writer&& other)
+{
+  if (this != &other)
+  {
+    if (stream.is_open())
+    {
+      flush_buffer();
+    }
+    name = std::move(other.name);
+    stream = std::move(other.stream);
+    buffer = std::move(other.buffer);
+    used = other.used;
+    other.used = 0;
+  }
+  return *this;
+}
+
+buffered_writer::~buffered_writer()
+{
+  if (stream.is_open())
+  {
+    flush_buffer();
+  }
+}
+
+void buffered_writer::flush_buffer()
+{
+  if (used > 0)
+  {
+    stream.write(buffer.data(), used);
+    used = 0;
+  }
+}
+
+std::optional<std::string> buffered_writer::flush()
+{
+  flush_buffer();
+  stream.flush();
+  if (!stream.good())
+  {
+    return "Writing to " + name + " failed.";
+  }
+  return std::nullopt;
+}
+
+} // namespace
@@ -0,0 +1,156 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_STORAGE_BUFFERED_WRITER_HPP
+#define THERMOS_STORAGE_BUFFERED_WRITER_HPP
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../third-party/nonstd/expected.hpp"
+
+namespace thermos::storage
+{
+
+/** \brief Appends data to a file through a large in-memory buffer.
+ *
+ * Writes only copy into the buffer. The buffer is handed to the file in one
+ * piece whenever it is full, when flush() is called and on destruction.
+ */
+class buffered_writer
+{
+  public:
+    /// default size of the buffer in bytes
+    static constexpr std::size_t default_capacity = 1024 * 1024;
+
+    /// smallest size of the buffer in bytes, smaller requests are raised to it
+    static constexpr std::size_t minimum_capacity = 64;
+
+    /** \brief Opens a file for appending data to it.
+     *
+     * \param file_name   path of the file, will be created if it does not exist
+     * \param capacity    size of the buffer in bytes
+     * \return Returns the writer, if the file could be opened.
+     *         Returns an error message otherwise.
+     */
+    static nonstd::expected<buffered_writer, std::string> open(const std::string& file_name, const std::size_t capacity = default_capacity);
+
+    /** \brief Takes over the file and the buffered data of another writer.
+     *
+     * \param other   the writer to move from, it holds no data afterwards
+     */
+    buffered_writer(buffered_writer&& other) noexcept;
+
+    /** \brief Flushes the data buffered so far and then takes over the file
+     * and the buffered data of another writer.
+     *
+     * \param other   the writer to move from, it holds no data afterwards
+     */
+    buffered_writer& operator=(buffered_writer&& other);
+
+    buffered_writer(const buffered_writer& other) = delete;
+    buffered_writer& operator=(const buffered_writer& other) = delete;
+
+    /** \brief Flushes remaining data to the file.
+     */
+    ~buffered_writer();
+
+    /** \brief Appends a string.
+     *
+     * \param data   the characters to append
+     */
+    void write(const std::string_view data)
+    {
+      if (data.size() > buffer.size() - used)
+      {
+        flush_buffer();
+        if (data.size() > buffer.size())
+        {
+          stream.write(data.data(), data.size());
+          return;
+        }
+      }
+      std::memcpy(buffer.data() + used, data.data(), data.size());
+      used += data.size();
+    }
+
+    /** \brief Appends a single character.
+     *
+     * \param c   the character to append
+     */
+    void write(const char c)
+    {
+      if (used == buffer.size())
+      {
+        flush_buffer();
+      }
+      buffer[used] = c;
+      ++used;
+    }
+
+    /** \brief Appends the decimal representation of an integer.
+     *
+     * \param value   the integer to append
+     */
+    void write(const int64_t value)
+    {
+      // 20 characters are enough for any 64 bit integer including the sign.
+      constexpr std::size_t max_digits = 20;
+      if (buffer.size() - used < max_digits)
+      {
+        flush_buffer();
+      }
+      char* begin = buffer.data() + used;
+      const auto result = std::to_chars(begin, begin + max_digits, value);
+      used += static_cast<std::size_t>(result.ptr - begin);
+    }
+
+    /** \brief Writes all buffered data to the file.
+     *
+     * \return Returns an empty optional, if all data written so far reached
+     *         the file. Returns an error message otherwise.
+     */
+    std::optional<std::string> flush();
+  private:
+    /** \brief Constructor, use open() to create an instance.
+     *
+     * \param file_name   name of the file
+     * \param capacity    size of the buffer in bytes
+     */
+    buffered_writer(const std::string& file_name, const std::size_t capacity);
+
+    /** \brief Hands the buffer content to the underlying stream.
+     */
+    void flush_buffer();
+
+    std::string name; /**< name of the file */
+    std::ofstream stream; /**< stream to the file */
+    std::vector<char> buffer; /**< data not yet handed to the stream */
+    std::size_t used; /**< number of used bytes in buffer */
+};
+
+} // namespace
+
+#endif // THERMOS_STORAGE_BUFFERED_WRITER_HPP
@@ -0,0 +1,182 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "compaction.hpp"
+#if !defined(THERMOS_NO_SQLITE)
+#include <utility>
+
+namespace thermos::storage
+{
+
+namespace
+{
+
+/// value of the auto_vacuum pragma for incremental auto vacuum
+constexpr int64_t incremental_auto_vacuum = 2;
+
+/// table that may contain expired rows
+struct expiring_table
+{
+  const char* delete_sql;  /**< statement that deletes a batch of rows */
+  std::chrono::seconds bucket_length; /**< length of a bucket, zero for raw readings */
+};
+
+/** \brief Deletes one batch of rows that are older than a given time.
+ *
+ * \param db           the database connection
+ * \param table        the table to delete from
+ * \param cutoff       rows that end before this time are deleted
+ * \param batch_size   maximum number of rows to delete
+ * \return Returns the number of deleted rows in case of success.
+ *         Returns an error message, if an error occurred.
+ */
+nonstd::expected<int64_t, std::string> delete_batch(sqlite::database& db, const expiring_table& table, const int64_t cutoff, const int64_t batch_size)
+{
+  auto maybe_stmt = db.prepare(table.delete_sql);
+  if (!maybe_stmt.has_value())
+  {
+    return nonstd::make_unexpected(maybe_stmt.error());
+  }
+  auto& stmt = maybe_stmt.value();
+  // A bucket of a rollup is only expired, if its whole time range is.
+  if (!stmt.bind(1, cutoff - table.bucket_length.count())
+      || !stmt.bind(2, batch_size))
+  {
+    return nonstd::make_unexpected("Failed to bind parameters to prepared statement.");
+  }
+  if (sqlite3_step(stmt.ptr()) != SQLITE_DONE)
+  {
+    return nonstd::make_unexpected("Failed to delete expired readings.");
+  }
+  return db.changes();
+}
+
+/** \brief Gets the value of a pragma that returns a single integer.
+ *
+ * \param db       the database connection
+ * \param pragma   name of the pragma
+ * \return Returns the value of the pragma in case of success.
+ *         Returns an error message, if an error occurred.
+ */
+nonstd::expected<int64_t, std::string> pragma_value(sqlite::database& db, const std::string& pragma)
+{
+  auto maybe_stmt = db.prepare("PRAGMA " + pragma + ";");
+  if (!maybe_stmt.has_value())
+  {
+    return nonstd::make_unexpected(maybe_stmt.error());
+  }
+  auto& stmt = maybe_stmt.value();
+  if (sqlite3_step(stmt.ptr()) != SQLITE_ROW)
+  {
+    return nonstd::make_unexpected("Failed to query the " + pragma + " pragma.");
+  }
+  return sqlite3_column_int64(stmt.ptr(), 0);
+}
+
+} // anonymous namespace
+
+nonstd::expected<int64_t, std::string> compaction::step(sqlite::database& db, const retention_policy& policy, const int64_t now, const int64_t batch_size)
+{
+  const std::pair<std::optional<std::chrono::hours>, expiring_table> tables[] = {
+    { policy.raw, { "DELETE FROM reading WHERE readingId IN (SELECT readingId FROM reading WHERE date < @cutoff LIMIT @n);",
+                    std::chrono::seconds(0) } },
+    { policy.hourly, { "DELETE FROM rollup_hour WHERE (deviceId, type, bucket) IN (SELECT deviceId, type, bucket FROM rollup_hour WHERE bucket <= @cutoff LIMIT @n);",
+                       std::chrono::hours(1) } },
+    { policy.daily, { "DELETE FROM rollup_day WHERE (deviceId, type, bucket) IN (SELECT deviceId, type, bucket FROM rollup_day WHERE bucket <= @cutoff LIMIT @n);",
+                      std::chrono::hours(24) } }
+  };
+
+  for (const auto& [retention, table] : tables)
+  {
+    if (!retention.has_value())
+    {
+      continue;
+    }
+    const int64_t cutoff = now - std::chrono::seconds(retention.value()).count();
+    const auto deleted = delete_batch(db, table, cutoff, batch_size);
+    if (!deleted.has_value() || (deleted.value() > 0))
+    {
+      return deleted;
+    }
+  }
+
+  return 0;
+}
+
+nonstd::expected<int64_t, std::string> compaction::run(sqlite::database& db, const retention_policy& policy, const int64_t now, const std::chrono::steady_clock::duration budget, const int64_t batch_size)
+{
+  if (policy.keeps_everything())
+  {
+    return 0;
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + budget;
+  int64_t total = 0;
+  do
+  {
+    const auto deleted = step(db, policy, now, batch_size);
+    if (!deleted.has_value())
+    {
+      return deleted;
+    }
+    if (deleted.value() == 0)
+    {
+      break;
+    }
+    total += deleted.value();
+  } while (std::chrono::steady_clock::now() < deadline);
+
+  if (total == 0)
+  {
+    return 0;
+  }
+  const auto error = vacuum(db);
+  if (error.has_value())
+  {
+    return nonstd::make_unexpected(error.value());
+  }
+  return total;
+}
+
+std::optional<std::string> compaction::vacuum(sqlite::database& db, const int64_t max_pages)
+{
+  const auto mode = pragma_value(db, "auto_vacuum");
+  if (!mode.has_value())
+  {
+    return mode.error();
+  }
+  if (mode.value() != incremental_auto_vacuum)
+  {
+    // Switching to incremental auto vacuum would need a full VACUUM, which
+    // rewrites the whole file and locks the database for a long time. Free
+    // pages are still reused for new readings, so the file does not grow.
+    return std::nullopt;
+  }
+
+  if (!db.exec("PRAGMA incremental_vacuum(" + std::to_string(max_pages) + ");"))
+  {
+    return "Failed to release free pages of the database.";
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+#endif // SQLite feature guard
@@ -0,0 +1,97 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_STORAGE_COMPACTION_HPP
+#define THERMOS_STORAGE_COMPACTION_HPP
+
+#if !defined(THERMOS_NO_SQLITE)
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "../../third-party/nonstd/expected.hpp"
+#include "../sqlite/database.hpp"
+#include "retention.hpp"
+
+namespace thermos::storage
+{
+
+/** \brief Removes readings that are older than allowed by a retention policy
+ *         from SQLite 3 databases and gives the freed space back.
+ *
+ * Rows are deleted in small batches, each of them in its own implicit
+ * transaction, so that the database is never locked for a long time and the
+ * work can be spread over several calls. Raw readings do not have to be
+ * downsampled before they are deleted, because the rollup tables are kept up
+ * to date by a trigger whenever a reading is inserted.
+ */
+struct compaction
+{
+  /// default maximum number of rows that are deleted by a single step
+  static constexpr int64_t default_batch_size = 5000;
+
+  /// default maximum number of free pages that are released by one vacuum
+  static constexpr int64_t default_vacuum_pages = 1000;
+
+  /** \brief Deletes a single batch of expired rows.
+   *
+   * \param db           the database connection
+   * \param policy       the retention policy
+   * \param now          current time as seconds since the Unix epoch
+   * \param batch_size   maximum number of rows to delete
+   * \return Returns the number of deleted rows. Zero means that no expired
+   *         rows are left. Returns an error message, if an error occurred.
+   */
+  static nonstd::expected<int64_t, std::string> step(sqlite::database& db, const retention_policy& policy, const int64_t now, const int64_t batch_size = default_batch_size);
+
+  /** \brief Deletes batches of expired rows until no expired rows are left or
+   *         the time budget is used up, and releases the freed pages, if any
+   *         rows were deleted.
+   *
+   * \param db           the database connection
+   * \param policy       the retention policy
+   * \param now          current time as seconds since the Unix epoch
+   * \param budget       time after which no further batch is started
+   * \param batch_size   maximum number of rows to delete per batch
+   * \return Returns the number of deleted rows in case of success.
+   *         Returns an error message, if an error occurred.
+   */
+  static nonstd::expected<int64_t, std::string> run(sqlite::database& db, const retention_policy& policy, const int64_t now, const std::chrono::steady_clock::duration budget, const int64_t batch_size = default_batch_size);
+
+  /** \brief Releases free pages of the database file.
+   *
+   * \param db          the database connection
+   * \param max_pages   maximum number of pages to release
+   * \return Returns an empty optional in case of success.
+   *         Returns an error message, if an error occurred.
+   * \remarks Pages are only released in databases that use incremental auto
+   *          vacuum, which is the case for all databases created by this
+   *          version. Older databases are left as they are, because switching
+   *          them would require a full VACUUM. This must not be called within
+   *          a transaction.
+   */
+  static std::optional<std::string> vacuum(sqlite::database& db, const int64_t max_pages = default_vacuum_pages);
+};
+
+} // namespace
+
+#endif // SQLite feature guard
+
+#endif // THERMOS_STORAGE_COMPACTION_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -57,9 +57,62 @@ class csv: public store
       return save_impl(data, file_name);
     }
 
+    /** \brief Saves a batch of thermal readings to a file.
+     *
+     * \param data        the readings that shall be stored
+     * \param file_name   the file to which the data shall be saved
+     * \return Returns an empty optional, if the data was written successfully.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> save(const thermal::reading_batch& data, const std::string& file_name)
+    {
+      return save_batch_impl(data, file_name);
+    }
+
+    /** \brief Saves a batch of CPU load readings to a file.
+     *
+     * \param data        the readings that shall be stored
+     * \param file_name   the file to which the data shall be saved
+     * \return Returns an empty optional, if the data was written successfully.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> save(const load::reading_batch& data, const std::string& file_name)
+    {
+      return save_batch_impl(data, file_name);
+    }
+
   private:
     template<typename T>
     std::optional<std::string> save_impl(const std::vector<T>& data, const std::string& file_name)
+    {
+      using read_t = decltype(T::reading);
+      return write_rows<read_t>(data.size(), file_name,
+          [&data](const std::size_t i) { return data[i].dev; },
+          [&data](const std::size_t i) { return data[i].reading.time; },
+          [&data](const std::size_t i) { return data[i].reading.value; });
+    }
+
+    template<typename read_t>
+    std::optional<std::string> save_batch_impl(const reading_batch<read_t>& data, const std::string& file_name)
+    {
+      return write_rows<read_t>(data.size(), file_name,
+          [&data](const std::size_t i) { return data.devices[i]; },
+          [&data](const std::size_t i) { return epoch_to_time(data.times[i]); },
+          [&data](const std::size_t i) { return data.values[i]; });
+    }
+
+    /** \brief Appends readings to a file.
+     *
+     * \param count       number of readings
+     * \param file_name   the file to which the data shall be saved
+     * \param dev_at      function that returns the device handle of a reading
+     * \param time_at     function that returns the time of a reading
+     * \param value_at    function that returns the value of a reading
+     * \return Returns an empty optional, if the data was written successfully.
+     *         Returns an error message otherwise.
+     */
+    template<typename read_t, typename dev_fn, typename time_fn, typename value_fn>
+    std::optional<std::string> write_rows(const std::size_t count, const std::string& file_name, const dev_fn& dev_at, const time_fn& time_at, const value_fn& value_at)
     {
       const char separator = ';';
 
@@ -69,16 +122,30 @@ class csv: public store
         return "Failed to create or open file " + file_name + ".";
       }
 
-      for(const auto& reading: data)
+      const std::string type_name = to_string(read_t::type());
+      time_formatter formatter;
+      time_formatter::buffer_t time_buffer;
+      device_handle last_handle = device_registry::no_device;
+      const device* dev = &device_registry::get(last_handle);
+      for (std::size_t i = 0; i < count; ++i)
       {
-        const auto time_string = time_to_string(reading.reading.time);
-        if (!time_string.has_value())
+        const auto error = formatter.format(time_at(i), time_buffer);
+        if (error.has_value())
+        {
+          return error;
+        }
+        // Readings of the same device usually come in runs, so the registry
+        // only has to be asked when the device changes.
+        const device_handle handle = dev_at(i);
+        if (handle != last_handle)
         {
-          return time_string.error();
+          last_handle = handle;
+          dev = &device_registry::get(last_handle);
         }
-        stream << reading.dev.name << separator << reading.dev.origin << separator
-               << reading.reading.type() << separator << reading.reading.value << separator
-               << time_string.value() << "\n";
+        stream << dev->name << separator << dev->origin << separator
+               << type_name << separator << value_at(i) << separator;
+        stream.write(time_buffer.data(), time_buffer.size());
+        stream << "\n";
       }
       stream.flush();
       stream.close();
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -20,27 +20,65 @@
 
 #if !defined(THERMOS_NO_SQLITE)
 #include "db.hpp"
+#include "compaction.hpp"
+#include "schema.hpp"
 
 namespace thermos::storage
 {
 
-nonstd::expected<sqlite::database, std::string> db::prepare_db(const std::string& file_name)
+db::db(const sqlite::options& connection)
+: connection_options(connection),
+  current_session(std::nullopt),
+  reader(std::nullopt)
 {
-  // Open the database.
-  auto maybe_db = sqlite::database::open(file_name);
+}
+
+nonstd::expected<session*, std::string> db::get_session(const std::string& file_name)
+{
+  if (current_session.has_value() && (current_session.value().file_name() == file_name))
+  {
+    return &current_session.value();
+  }
+
+  // Close any previous session before opening a new one.
+  current_session.reset();
+  auto maybe_session = session::open(file_name, connection_options);
+  if (!maybe_session.has_value())
+  {
+    return nonstd::make_unexpected(maybe_session.error());
+  }
+  current_session.emplace(std::move(maybe_session.value()));
+  return &current_session.value();
+}
+
+nonstd::expected<sqlite::database*, std::string> db::get_connection(const std::string& file_name)
+{
+  if (current_session.has_value() && (current_session.value().file_name() == file_name))
+  {
+    return &current_session.value().database();
+  }
+  if (reader.has_value() && (reader.value().first == file_name))
+  {
+    return &reader.value().second;
+  }
+
+  // Close any previous connection before opening a new one.
+  reader.reset();
+  auto maybe_db = sqlite::database::open(file_name, connection_options);
   if (!maybe_db.has_value())
   {
     return nonstd::make_unexpected(maybe_db.error());
   }
-  auto& db_ = maybe_db.value();
-  // Make sure the schema is correct.
-  const auto existence = ensure_tables_exist(db_);
-  if (existence.has_value())
+  // Older databases store dates in a different format, so the schema has to
+  // be up to date before any readings can be retrieved. Only the logger
+  // upgrades databases, readers never change them.
+  const auto error = schema::check_current(maybe_db.value());
+  if (error.has_value())
   {
-    return nonstd::make_unexpected(existence.value());
+    return nonstd::make_unexpected(error.value());
   }
-
-  return std::move(db_);
+  reader.emplace(file_name, std::move(maybe_db.value()));
+  return &reader.value().second;
 }
 
 std::optional<std::string> db::save(const std::vector<thermos::thermal::device_reading>& data, const std::string& file_name)
@@ -63,94 +101,35 @@ std::optional<std::string> db::load(std::vector<thermos::load::device_reading>&
   return load_impl<thermos::load::device_reading>(data, file_name);
 }
 
-std::optional<std::string> db::ensure_tables_exist(sqlite::database& dbase)
+std::optional<std::string> db::load(const std::string& file_name, const device_visitor& on_device, const reading_visitor<thermal::reading>& on_reading)
 {
-  auto exists = dbase.table_exists("device");
-  if (!exists.has_value())
-  {
-    return exists.error();
-  }
-  if (!exists.value())
-  {
-    const std::string statement = R"SQL(
-        CREATE TABLE device (
-          deviceId INTEGER PRIMARY KEY NOT NULL,
-          name TEXT NOT NULL,
-          origin TEXT NOT NULL
-        );
-        CREATE TABLE reading (
-          readingId INTEGER PRIMARY KEY NOT NULL,
-          deviceId INTEGER NOT NULL,
-          type TEXT,
-          date TEXT,
-          value INTEGER
-        );
-        )SQL";
-    if (!dbase.exec(statement))
-      return "Failed to create tables.";
-  }
-
-  return std::nullopt;
+  return stream_impl<thermal::reading>(file_name, on_device, on_reading);
 }
 
-nonstd::expected<int64_t, std::string> db::find_or_create_device(sqlite::database& dbase, const device& dev)
+std::optional<std::string> db::load(thermal::reading_batch& batch, const std::string& file_name)
 {
-  {
-    auto maybe_stmt = dbase.prepare("SELECT deviceId FROM device WHERE origin = @ori AND name = @name LIMIT 1;");
-    if (!maybe_stmt.has_value())
-    {
-      return nonstd::make_unexpected(maybe_stmt.error());
-    }
-    auto& stmt = maybe_stmt.value();
-    if (!stmt.bind(1, dev.origin) || !stmt.bind(2, dev.name))
-    {
-      return nonstd::make_unexpected("Could not bind device data to prepared statement!");
-    }
+  return load_impl(batch, file_name);
+}
 
-    const int rc = sqlite3_step(stmt.ptr());
-    if (rc == SQLITE_ROW)
-    {
-      return sqlite3_column_int(stmt.ptr(), 0);
-    }
-    if (rc != SQLITE_DONE)
-    {
-      // An error occurred.
-      return nonstd::make_unexpected("Failed to retrieve data from database query.");
-    }
-    // End of statement scope ensures statement is finalized.
-  }
+std::optional<std::string> db::load(const std::string& file_name, const device_visitor& on_device, const reading_visitor<load::reading>& on_reading)
+{
+  return stream_impl<load::reading>(file_name, on_device, on_reading);
+}
 
-  // SQLITE_DONE means "no more data", so the device does not exist yet.
-  auto maybe_stmt = dbase.prepare("INSERT INTO device (origin, name) VALUES (@ori, @name);");
-  if (!maybe_stmt.has_value())
-  {
-    return nonstd::make_unexpected(maybe_stmt.error());
-  }
-  auto& stmt = maybe_stmt.value();
-  if (!stmt.bind(1, dev.origin) || !stmt.bind(2, dev.name))
-  {
-    return nonstd::make_unexpected("Could not bind device data to prepared statement!");
-  }
-  const auto ret = sqlite3_step(stmt.ptr());
-  if ((ret != SQLITE_OK) && (ret != SQLITE_DONE))
-  {
-    std::string message{"Error: Could not insert device data for '"};
-    message.append(dev.name).append("' / '").append(dev.origin)
-           .append("' into database!");
-    return nonstd::make_unexpected(message);
-  }
-  return dbase.last_insert_id();
+std::optional<std::string> db::load(load::reading_batch& batch, const std::string& file_name)
+{
+  return load_impl(batch, file_name);
 }
 
 std::optional<std::string> db::get_devices(std::vector<thermos::device>& data, const thermos::reading_type type, const std::string& file_name)
 {
   // Open the database.
-  auto maybe_db = sqlite::database::open(file_name);
+  auto maybe_db = get_connection(file_name);
   if (!maybe_db.has_value())
   {
     return maybe_db.error();
   }
-  auto& dbase = maybe_db.value();
+  auto& dbase = *maybe_db.value();
 
   auto maybe_stmt = dbase.prepare(R"(SELECT deviceId, name, origin FROM device JOIN
                                        (SELECT DISTINCT deviceId AS devid, type FROM reading WHERE reading.type=@t)
@@ -188,12 +167,16 @@ std::optional<std::string> db::get_devices(std::vector<thermos::device>& data, c
 
 nonstd::expected<int64_t, std::string> db::get_device_id(const thermos::device& dev, const std::string& file_name)
 {
-  auto maybe_db = sqlite::database::open(file_name);
+  auto maybe_db = get_connection(file_name);
   if (!maybe_db.has_value())
   {
     return nonstd::make_unexpected(maybe_db.error());
   }
-  auto& dbase = maybe_db.value();
+  return find_device_id(*maybe_db.value(), dev);
+}
+
+nonstd::expected<int64_t, std::string> db::find_device_id(sqlite::database& dbase, const thermos::device& dev)
+{
   auto maybe_stmt = dbase.prepare("SELECT deviceId FROM device WHERE name=@nom AND origin=@ori LIMIT 1;");
   if (!maybe_stmt.has_value())
   {
@@ -226,5 +209,227 @@ std::optional<std::string> db::get_device_readings(const thermos::device& dev, s
   return get_device_readings_impl(dev, data, file_name, time_span);
 }
 
+std::optional<std::string> db::get_device_readings(const thermos::device& dev, load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span)
+{
+  return get_device_readings_impl(dev, batch, file_name, time_span);
+}
+
+std::optional<std::string> db::get_device_readings(const thermos::device& dev, thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span)
+{
+  return get_device_readings_impl(dev, batch, file_name, time_span);
+}
+
+std::optional<std::string> db::get_latest_readings(load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span)
+{
+  return get_latest_readings_impl(batch, file_name, time_span);
+}
+
+std::optional<std::string> db::get_latest_readings(thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span)
+{
+  return get_latest_readings_impl(batch, file_name, time_span);
+}
+
+std::optional<std::string> db::get_device_readings(const thermos::device& dev, load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup)
+{
+  const auto res = covering_resolution(load::reading::type(), file_name, time_span, coarsest_resolution(max_interval));
+  if (!res.has_value())
+  {
+    return res.error();
+  }
+  return get_device_readings_impl(dev, batch, file_name, time_span, res.value(), rollup);
+}
+
+std::optional<std::string> db::get_device_readings(const thermos::device& dev, thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup)
+{
+  const auto res = covering_resolution(thermal::reading::type(), file_name, time_span, coarsest_resolution(max_interval));
+  if (!res.has_value())
+  {
+    return res.error();
+  }
+  return get_device_readings_impl(dev, batch, file_name, time_span, res.value(), rollup);
+}
+
+std::optional<std::string> db::get_latest_readings(load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup)
+{
+  const auto res = covering_resolution(load::reading::type(), file_name, time_span, coarsest_resolution(max_interval));
+  if (!res.has_value())
+  {
+    return res.error();
+  }
+  return get_latest_readings_impl(batch, file_name, time_span, res.value(), rollup);
+}
+
+std::optional<std::string> db::get_latest_readings(load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const resolution res, const rollup_value rollup)
+{
+  return get_latest_readings_impl(batch, file_name, time_span, res, rollup);
+}
+
+std::optional<std::string> db::get_latest_readings(thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup)
+{
+  const auto res = covering_resolution(thermal::reading::type(), file_name, time_span, coarsest_resolution(max_interval));
+  if (!res.has_value())
+  {
+    return res.error();
+  }
+  return get_latest_readings_impl(batch, file_name, time_span, res.value(), rollup);
+}
+
+std::optional<std::string> db::get_latest_readings(thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const resolution res, const rollup_value rollup)
+{
+  return get_latest_readings_impl(batch, file_name, time_span, res, rollup);
+}
+
+resolution db::coarsest_resolution(const std::chrono::seconds max_interval)
+{
+  if (max_interval >= std::chrono::hours(24))
+  {
+    return resolution::daily;
+  }
+  if (max_interval >= std::chrono::hours(1))
+  {
+    return resolution::hourly;
+  }
+  return resolution::raw;
+}
+
+nonstd::expected<resolution, std::string> db::covering_resolution(const thermos::reading_type type, const std::string& file_name, const std::chrono::hours time_span, const resolution finest)
+{
+  auto maybe_db = get_connection(file_name);
+  if (!maybe_db.has_value())
+  {
+    return nonstd::make_unexpected(maybe_db.error());
+  }
+  auto& dbase = *maybe_db.value();
+  const int64_t span = std::abs(std::chrono::duration_cast<std::chrono::seconds>(time_span).count());
+
+  resolution res = finest;
+  while (res != resolution::daily)
+  {
+    const auto coarser = (res == resolution::raw) ? resolution::hourly : resolution::daily;
+    const int64_t bucket_size = (coarser == resolution::hourly) ? 3600 : 86400;
+    const auto fine = source_of(res, rollup_value::average);
+    const auto coarse = source_of(coarser, rollup_value::average);
+
+    const auto oldest = query_date(dbase, "SELECT MIN(" + fine.date + ") FROM " + fine.table + " WHERE type = @t;", type);
+    if (!oldest.has_value())
+    {
+      return nonstd::make_unexpected(oldest.error());
+    }
+    std::optional<int64_t> older_in_coarse;
+    if (!oldest.value().has_value())
+    {
+      // All readings of that resolution are gone, but the coarser one may
+      // still have some.
+      const auto any = query_date(dbase, "SELECT MIN(" + coarse.date + ") FROM " + coarse.table + " WHERE type = @t;", type);
+      if (!any.has_value())
+      {
+        return nonstd::make_unexpected(any.error());
+      }
+      older_in_coarse = any.value();
+    }
+    else
+    {
+      const auto latest = query_date(dbase, "SELECT MAX(" + fine.date + ") FROM " + fine.table + " WHERE type = @t;", type);
+      if (!latest.has_value())
+      {
+        return nonstd::make_unexpected(latest.error());
+      }
+      // The bucket that contains the start of the time span counts, too.
+      const int64_t start = latest.value().value() - span - bucket_size + 1;
+      const auto first_bucket = query_date(dbase, "SELECT MIN(" + coarse.date + ") FROM " + coarse.table + " WHERE type = @t AND " + coarse.date + " >= @d;", type, start);
+      if (!first_bucket.has_value())
+      {
+        return nonstd::make_unexpected(first_bucket.error());
+      }
+      const int64_t oldest_bucket = oldest.value().value() - oldest.value().value() % bucket_size;
+      if (first_bucket.value().has_value() && (first_bucket.value().value() < oldest_bucket))
+      {
+        older_in_coarse = first_bucket.value();
+      }
+    }
+
+    if (!older_in_coarse.has_value())
+    {
+      // Nothing within the time span has been deleted from this resolution.
+      break;
+    }
+    res = coarser;
+  }
+  return res;
+}
+
+nonstd::expected<std::optional<int64_t>, std::string> db::query_date(sqlite::database& dbase, const std::string& sql, const thermos::reading_type type, const std::optional<int64_t> date)
+{
+  auto maybe_stmt = dbase.prepare(sql);
+  if (!maybe_stmt.has_value())
+  {
+    return nonstd::make_unexpected(maybe_stmt.error());
+  }
+  auto& stmt = maybe_stmt.value();
+  if (!stmt.bind(1, to_string(type)) || (date.has_value() && !stmt.bind(2, date.value())))
+  {
+    return nonstd::make_unexpected("Could not bind reading type and date to prepared statement!");
+  }
+  switch (sqlite3_step(stmt.ptr()))
+  {
+    case SQLITE_ROW:
+         if (sqlite3_column_type(stmt.ptr(), 0) == SQLITE_NULL)
+         {
+           return std::optional<int64_t>();
+         }
+         return std::optional<int64_t>(sqlite3_column_int64(stmt.ptr(), 0));
+    case SQLITE_DONE:
+         return std::optional<int64_t>();
+    default:
+         return nonstd::make_unexpected("Failed to retrieve date value from database.");
+  }
+}
+
+nonstd::expected<int64_t, std::string> db::compact(const std::string& file_name, const retention_policy& policy, const std::chrono::steady_clock::duration budget)
+{
+  auto maybe_session = get_session(file_name);
+  if (!maybe_session.has_value())
+  {
+    return nonstd::make_unexpected(maybe_session.error());
+  }
+  const auto now = std::chrono::duration_cast<std::chrono::seconds>(
+      std::chrono::system_clock::now().time_since_epoch());
+  return compaction::run(maybe_session.value()->database(), policy, now.count(), budget);
+}
+
+db::reading_source db::source_of(const resolution res, const rollup_value rollup)
+{
+  std::string table;
+  switch (res)
+  {
+    case resolution::hourly:
+         table = "rollup_hour";
+         break;
+    case resolution::daily:
+         table = "rollup_day";
+         break;
+    case resolution::raw:
+    default:
+         return { "reading", "date", "value", "" };
+  }
+  if (rollup == rollup_value::extremes)
+  {
+    return { table, "bucket", "min_value", "max_value" };
+  }
+  // Rounding of the average happens in floating point, because integer
+  // division would truncate towards zero.
+  return { table, "bucket", "CAST(ROUND(CAST(value_sum AS REAL) / value_count) AS INTEGER)", "" };
+}
+
+std::optional<std::string> db::get_device_readings(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const reading_visitor<load::reading>& on_reading)
+{
+  return get_device_readings_impl<load::reading>(dev, file_name, time_span, on_reading);
+}
+
+std::optional<std::string> db::get_device_readings(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const reading_visitor<thermal::reading>& on_reading)
+{
+  return get_device_readings_impl<thermal::reading>(dev, file_name, time_span, on_reading);
+}
+
 } // namespace
 #endif // SQLite
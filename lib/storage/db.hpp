@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022, 2023  Dirk Stolle
+    Copyright (C) 2022, 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -23,20 +23,56 @@
 
 #if !defined(THERMOS_NO_SQLITE)
 #include <cmath>
+#include <utility>
+#include <unordered_map>
 #include "retrieve.hpp"
+#include "session.hpp"
 #include "store.hpp"
 #include "../../third-party/nonstd/expected.hpp"
 #include "../sqlite/database.hpp"
+#include "retention.hpp"
 #include "utilities.hpp"
 
 namespace thermos::storage
 {
 
+/** \brief Resolution of readings retrieved from a database.
+ */
+enum class resolution
+{
+  /// readings as they were logged
+  raw,
+
+  /// one reading per device and hour, taken from the rollup_hour table
+  hourly,
+
+  /// one reading per device and day (UTC), taken from the rollup_day table
+  daily
+};
+
+/** \brief Values that represent an hour or a day of readings in a rollup.
+ */
+enum class rollup_value
+{
+  /// rounded average of the readings
+  average,
+
+  /// minimum and maximum of the readings, as two readings with the same time
+  extremes
+};
+
 /** \brief Class for storing device readings in a SQLite 3 database.
  */
 class db: public store, public retrieve
 {
   public:
+    /** \brief Creates a new instance.
+     *
+     * \param connection   options for all database connections that are
+     *                     opened by this instance
+     */
+    explicit db(const sqlite::options& connection = sqlite::options());
+
     /** \brief Saves thermal device readings to a file.
      *
      * \param data        the device readings that shall be stored
@@ -77,6 +113,56 @@ class db: public store, public retrieve
     std::optional<std::string> load(std::vector<thermos::load::device_reading>& data, const std::string& file_name) final;
 
 
+    /** \brief Streams thermal device readings from a file, one at a time.
+     *
+     * First on_device is called for every device with thermal readings. After
+     * that on_reading is called for every reading, ordered by device and time.
+     * \param file_name    the file from which the data shall be loaded
+     * \param on_device    function that receives the devices
+     * \param on_reading   function that receives the readings
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if one of the functions stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> load(const std::string& file_name, const device_visitor& on_device, const reading_visitor<thermal::reading>& on_reading) final;
+
+
+    /** \brief Loads thermal device readings from a file into a batch.
+     *
+     * \param batch       the batch where the readings shall be appended,
+     *                    ordered by device and time
+     * \param file_name   the file from which the data shall be loaded
+     * \return Returns an empty optional, if the data was read successfully.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> load(thermal::reading_batch& batch, const std::string& file_name);
+
+
+    /** \brief Streams CPU load readings from a file, one at a time.
+     *
+     * First on_device is called for every device with CPU load readings. After
+     * that on_reading is called for every reading, ordered by device and time.
+     * \param file_name    the file from which the data shall be loaded
+     * \param on_device    function that receives the devices
+     * \param on_reading   function that receives the readings
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if one of the functions stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> load(const std::string& file_name, const device_visitor& on_device, const reading_visitor<load::reading>& on_reading) final;
+
+
+    /** \brief Loads CPU load readings from a file into a batch.
+     *
+     * \param batch       the batch where the readings shall be appended,
+     *                    ordered by device and time
+     * \param file_name   the file from which the data shall be loaded
+     * \return Returns an empty optional, if the data was read successfully.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> load(load::reading_batch& batch, const std::string& file_name);
+
+
     /** \brief Loads all available devices (NOT their readings) from a file.
      *
      * \param data        the vector where the devices shall be stored
@@ -113,139 +199,330 @@ class db: public store, public retrieve
      */
     std::optional<std::string> get_device_readings(const thermos::device& dev, std::vector<load::reading>& data, const std::string& file_name, const std::chrono::hours time_span);
     std::optional<std::string> get_device_readings(const thermos::device& dev, std::vector<thermal::reading>& data, const std::string& file_name, const std::chrono::hours time_span);
-  private:
-    /** \brief Ensures that the tables needed to save information exist.
+
+
+    /** \brief Loads readings of a devices from a file into a batch.
      *
-     * \param db   the database
-     * \return Returns an empty optional, if tables existed or were created.
+     * \param dev         the device for which the readings shall be retrieved
+     * \param batch       the batch where the readings shall be stored
+     * \param file_name   the file from which the data shall be loaded
+     * \param time_span   the time span from which the data shall be included;
+     *                    Settings this to e. g. two hours will retrieve the
+     *                    data from the latest time up to two hours back.
+     * \return Returns an empty optional, if the data was read successfully.
      *         Returns an error message otherwise.
      */
-    std::optional<std::string> ensure_tables_exist(sqlite::database& db);
+    std::optional<std::string> get_device_readings(const thermos::device& dev, load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span);
+    std::optional<std::string> get_device_readings(const thermos::device& dev, thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span);
+
 
-    /** \brief Prepares a database file for writing.
+    /** \brief Loads readings of a devices from a file into a batch, using the
+     *         coarsest resolution that is still fine enough.
      *
-     * \param file_name   the file to which the data shall be saved
-     * \return Returns an database object, if the database was created successfully.
+     * \param dev          the device for which the readings shall be retrieved
+     * \param batch        the batch where the readings shall be stored
+     * \param file_name    the file from which the data shall be loaded
+     * \param time_span    the time span from which the data shall be included
+     * \param max_interval maximum acceptable time between two readings; if it
+     *                     is at least an hour or a day, then hourly or daily
+     *                     rollups are retrieved instead of the raw readings
+     * \param rollup       values that are retrieved from rollups
+     * \return Returns an empty optional, if the data was read successfully.
      *         Returns an error message otherwise.
      */
-    nonstd::expected<sqlite::database, std::string> prepare_db(const std::string& file_name);
+    std::optional<std::string> get_device_readings(const thermos::device& dev, load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup = rollup_value::average);
+    std::optional<std::string> get_device_readings(const thermos::device& dev, thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup = rollup_value::average);
+
 
-    /** \brief Finds a device in the database or creates it, if it is missing.
+    /** \brief Loads the latest readings of all devices from a file.
      *
-     * \param db   the database
-     * \param dev  the device to find or to create
-     * \return Returns the id of the device used in the database in case of
-     *         success. Returns an error message, if an error occurred.
+     * This is the same as calling get_device_readings() for every device with
+     * readings of the batch's type, but it only needs one connection and one
+     * query.
+     * \param batch       the batch where the readings shall be stored, ordered
+     *                    by device name and then by time
+     * \param file_name   the file from which the data shall be loaded
+     * \param time_span   the time span from which the data shall be included;
+     *                    it is measured back from the latest reading of each
+     *                    device
+     * \return Returns an empty optional, if the data was read successfully.
+     *         Returns an error message otherwise.
      */
-    nonstd::expected<int64_t, std::string> find_or_create_device(sqlite::database& db, const device& dev);
+    std::optional<std::string> get_latest_readings(load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span);
+    std::optional<std::string> get_latest_readings(thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span);
 
-    /** \brief Inserts a new device reading into the database.
+
+    /** \brief Loads the latest readings of all devices from a file, using the
+     *         coarsest resolution that is still fine enough.
      *
-     * \param db   the database
-     * \param reading  the reading to insert
-     * \return Returns an empty optional, if insertion was successful.
+     * \param batch        the batch where the readings shall be stored, ordered
+     *                     by device name and then by time
+     * \param file_name    the file from which the data shall be loaded
+     * \param time_span    the time span from which the data shall be included
+     * \param max_interval maximum acceptable time between two readings; if it
+     *                     is at least an hour or a day, then hourly or daily
+     *                     rollups are retrieved instead of the raw readings
+     * \param rollup       values that are retrieved from rollups
+     * \return Returns an empty optional, if the data was read successfully.
      *         Returns an error message otherwise.
+     * \remarks If the readings of that resolution do not cover the time span
+     *          any more, then a coarser resolution is used that does, see
+     *          covering_resolution().
      */
+    std::optional<std::string> get_latest_readings(load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup = rollup_value::average);
+    std::optional<std::string> get_latest_readings(thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const std::chrono::seconds max_interval, const rollup_value rollup = rollup_value::average);
+
+
+    /** \brief Loads the latest readings of all devices from a file in a
+     *         given resolution.
+     *
+     * \param batch        the batch where the readings shall be stored, ordered
+     *                     by device name and then by time
+     * \param file_name    the file from which the data shall be loaded
+     * \param time_span    the time span from which the data shall be included
+     * \param res          resolution of the readings, it is used as it is
+     * \param rollup       values that are retrieved from rollups
+     * \return Returns an empty optional, if the data was read successfully.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> get_latest_readings(load::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const resolution res, const rollup_value rollup = rollup_value::average);
+    std::optional<std::string> get_latest_readings(thermal::reading_batch& batch, const std::string& file_name, const std::chrono::hours time_span, const resolution res, const rollup_value rollup = rollup_value::average);
+
+
+    /** \brief Gets the finest resolution whose readings still cover a time
+     *         span, after older readings have been deleted by the retention
+     *         policy.
+     *
+     * Raw readings are usually kept for a shorter time than the hourly
+     * rollups, and those are kept for a shorter time than the daily rollups.
+     * A resolution covers the time span, unless the next coarser one has
+     * readings within the time span that are older than its own readings.
+     * \param type        type of the readings
+     * \param file_name   the database file
+     * \param time_span   the time span, counted back from the latest reading
+     * \param finest      the finest acceptable resolution
+     * \return Returns the resolution, it is never finer than finest.
+     *         Returns an error message, if an error occurred.
+     */
+    nonstd::expected<resolution, std::string> covering_resolution(const thermos::reading_type type, const std::string& file_name, const std::chrono::hours time_span, const resolution finest);
+
+
+    /** \brief Gets the coarsest resolution whose readings are not further
+     *         apart than a given interval.
+     *
+     * \param max_interval maximum acceptable time between two readings
+     * \return Returns the resolution to use.
+     */
+    static resolution coarsest_resolution(const std::chrono::seconds max_interval);
+
+    /** \brief Deletes readings that have expired according to a retention
+     *         policy from a database file and releases the freed space.
+     *
+     * \param file_name   the database file
+     * \param policy      the retention policy
+     * \param budget      time after which no further batch of rows is deleted
+     * \return Returns the number of deleted rows in case of success.
+     *         Returns an error message, if an error occurred.
+     * \remarks This uses the same connection as save(), so it can be called
+     *          between two saves without opening the file again. Expired rows
+     *          that are left when the budget is used up are deleted by the
+     *          next call.
+     */
+    nonstd::expected<int64_t, std::string> compact(const std::string& file_name, const retention_policy& policy, const std::chrono::steady_clock::duration budget);
+
+
+    /** \brief Streams readings of a device from a file, one at a time.
+     *
+     * \param dev          the device for which the readings shall be retrieved
+     * \param file_name    the file from which the data shall be loaded
+     * \param time_span    the time span from which the data shall be included;
+     *                     Settings this to e. g. two hours will retrieve the
+     *                     data from the latest time up to two hours back.
+     * \param on_reading   function that receives the readings, ordered by time
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if on_reading stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> get_device_readings(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const reading_visitor<load::reading>& on_reading) final;
+    std::optional<std::string> get_device_readings(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const reading_visitor<thermal::reading>& on_reading) final;
+  private:
+    /** \brief Gets the session for writing to a database file, opening the
+     *         file, if necessary.
+     *
+     * \param file_name   the file to which the data shall be saved
+     * \return Returns a pointer to the session, if it could be opened.
+     *         Returns an error message otherwise.
+     * \remarks The session is kept open until data is saved to another file
+     *          or until the db instance is destroyed, so repeated calls of
+     *          save() with the same file do not need to reopen the database.
+     */
+    nonstd::expected<session*, std::string> get_session(const std::string& file_name);
+
     template<typename T>
-    std::optional<std::string> insert_reading(sqlite::database& sql_db, const device_reading<T>& reading)
+    std::optional<std::string> save_impl(const std::vector<T>& data, const std::string& file_name)
     {
-      const auto dev_id = find_or_create_device(sql_db, reading.dev);
-      if (!dev_id.has_value())
+      auto maybe_session = get_session(file_name);
+      if (!maybe_session.has_value())
       {
-        return dev_id.error();
-      }
-      const auto time_string = time_to_string(reading.reading.time);
-      if (!time_string.has_value())
-      {
-        return time_string.error();
+        return maybe_session.error();
       }
 
-      const std::string sql = "INSERT INTO reading (deviceId, type, date, value) VALUES ("
-          + std::to_string(dev_id.value()) + ", '" + to_string(reading.reading.type())
-          + "', '" + time_string.value() + "', " + std::to_string(reading.reading.value)
-          + ");";
-      if (!sql_db.exec(sql))
+      const auto error = maybe_session.value()->insert(data);
+      if (error.has_value())
       {
-        return "Could not insert new device reading into database!";
+        // The connection may be in an unusable state after an error, so the
+        // next save operation shall start with a fresh connection.
+        current_session.reset();
       }
+      return error;
+    }
 
-      // Insertion was successful.
-      return std::nullopt;
+    /** \brief Gets a connection for reading from a database file, opening
+     *         the file and checking its schema version, if necessary.
+     *
+     * \param file_name   the database file to open
+     * \return Returns a pointer to the database connection, if it could be
+     *         opened and has the current schema version.
+     *         Returns an error message otherwise.
+     * \remarks The connection is kept open until data is read from another
+     *          file, so the schema is only checked once and prepared
+     *          statements are reused between queries. If a session for
+     *          writing to the same file is open, its connection is used.
+     *          Instances of this class are not thread-safe, so reader
+     *          threads use one instance each to get one connection per thread.
+     */
+    nonstd::expected<sqlite::database*, std::string> get_connection(const std::string& file_name);
+
+    /** \brief Gets the internal id of a device from an open database.
+     *
+     * \param dbase   the database connection
+     * \param dev     the device for which the id shall be retrieved
+     * \return Returns the id, if the database contains a matching device.
+     *         Returns zero, if the database does not contain a matching device.
+     *         Returns an error message otherwise.
+     */
+    static nonstd::expected<int64_t, std::string> find_device_id(sqlite::database& dbase, const thermos::device& dev);
+
+    /// SQL expressions to query readings in a certain resolution
+    struct reading_source
+    {
+      std::string table; /**< name of the table */
+      std::string date;  /**< expression for the date in epoch seconds */
+      std::string value; /**< expression for the value */
+      std::string extra; /**< expression for a second value of the same date, may be empty */
+    };
+
+    /** \brief Gets the SQL expressions to query readings in a resolution.
+     *
+     * \param res     the resolution
+     * \param rollup  values that are retrieved from rollups
+     * \return Returns table name and column expressions. Rollups deliver the
+     *         start of the hour or day as date and either the rounded average
+     *         as value or the minimum as value and the maximum as extra value.
+     */
+    static reading_source source_of(const resolution res, const rollup_value rollup);
+
+    /** \brief Gets a single date from a database query.
+     *
+     * \param dbase   the database connection
+     * \param sql     the query, its first parameter is the reading type and
+     *                its second parameter, if any, is the given date
+     * \param type    type of the readings
+     * \param date    value of the second parameter
+     * \return Returns the date in seconds since the Unix epoch, or an empty
+     *         optional, if the query delivered NULL.
+     *         Returns an error message, if an error occurred.
+     */
+    static nonstd::expected<std::optional<int64_t>, std::string> query_date(sqlite::database& dbase, const std::string& sql, const thermos::reading_type type, const std::optional<int64_t> date = std::nullopt);
+
+    template<typename read_t>
+    std::optional<std::string> stream_impl(const std::string& file_name, const device_visitor& on_device, const reading_visitor<read_t>& on_reading)
+    {
+      read_t r;
+      const auto on_row = [&](const int64_t device_id, const int64_t date, const int64_t value)
+      {
+        r.time = epoch_to_time(date);
+        r.value = value;
+        return on_reading(device_id, r);
+      };
+      return stream_rows<read_t>(file_name, on_device, on_row);
     }
 
-    template<typename T>
-    std::optional<std::string> save_impl(const std::vector<T>& data, const std::string& file_name)
+    /** \brief Streams devices and the raw rows of their readings from a file.
+     *
+     * \param file_name   the file from which the data shall be loaded
+     * \param on_device   function that receives the database id and the data
+     *                    of every device, returns false to stop
+     * \param on_row      function that receives device id, date in seconds
+     *                    since the Unix epoch and value of every reading,
+     *                    returns false to stop
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if one of the functions stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    template<typename read_t, typename device_fn, typename row_fn>
+    std::optional<std::string> stream_rows(const std::string& file_name, const device_fn& on_device, const row_fn& on_row)
     {
       // Open the database.
-      auto maybe_db = prepare_db(file_name);
+      auto maybe_db = get_connection(file_name);
       if (!maybe_db.has_value())
       {
         return maybe_db.error();
       }
-      auto& dbase = maybe_db.value();
+      auto& dbase = *maybe_db.value();
+      const std::string type = to_string(read_t::type());
 
-      for(const auto& reading: data)
       {
-        // Note: Potentially, this loop could be optimized by avoiding to look up
-        //       the device ids repeatedly for the same devices. However, currently
-        //       the code does not use multiple readings for the same device in one
-        //       call to the save() method yet, so we should still be fine.
-        auto insert = insert_reading(dbase, reading);
-        if (insert.has_value())
+        auto maybe_stmt = dbase.prepare("SELECT deviceId, name, origin FROM device WHERE deviceId IN (SELECT DISTINCT deviceId FROM reading WHERE type = @t) ORDER BY deviceId ASC;");
+        if (!maybe_stmt.has_value())
         {
-          return insert;
+          return maybe_stmt.error();
+        }
+        auto& stmt = maybe_stmt.value();
+        if (!stmt.bind(1, type))
+        {
+          return "Failed to bind reading type to prepared statement.";
         }
-      }
-
-      return std::nullopt;
-    }
 
-    template<typename T>
-    std::optional<std::string> load_impl(std::vector<T>& data, const std::string& file_name)
-    {
-      // Open the database.
-      auto maybe_db = sqlite::database::open(file_name);
-      if (!maybe_db.has_value())
-      {
-        return maybe_db.error();
+        device dev;
+        int rc = -1;
+        while ((rc = sqlite3_step(stmt.ptr())) == SQLITE_ROW)
+        {
+          dev.name = std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 1)));
+          dev.origin = std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 2)));
+          if (!on_device(sqlite3_column_int64(stmt.ptr(), 0), dev))
+          {
+            return std::nullopt;
+          }
+        }
+        if (rc != SQLITE_DONE)
+        {
+          // An error occurred.
+          return "Failed to retrieve devices from database query.";
+        }
       }
-      auto& dbase = maybe_db.value();
 
-      auto maybe_stmt = dbase.prepare("SELECT name, origin, reading.deviceId, date, value FROM reading JOIN device ON reading.deviceId=device.deviceId WHERE type=@t ORDER BY reading.deviceId ASC, date ASC;");
+      // Readings are fetched one at a time from the cursor, so they never
+      // have to be held in memory all at once.
+      auto maybe_stmt = dbase.prepare("SELECT reading.deviceId, date, value FROM reading JOIN device ON reading.deviceId=device.deviceId WHERE type=@t ORDER BY reading.deviceId ASC, date ASC;");
       if (!maybe_stmt.has_value())
       {
         return maybe_stmt.error();
       }
       auto& stmt = maybe_stmt.value();
-
-      T dr;
-      if (!stmt.bind(1, to_string(dr.reading.type())))
+      if (!stmt.bind(1, type))
       {
         return "Failed to bind reading type to prepared statement.";
       }
 
-      int last_device_id = -1;
-      dr.dev.name = "uninitialized";
-      dr.dev.origin = "uninitialized";
       int rc = -1;
       while ((rc = sqlite3_step(stmt.ptr())) == SQLITE_ROW)
       {
-        const int current_device_id = sqlite3_column_int(stmt.ptr(), 2);
-        if (current_device_id != last_device_id)
+        if (!on_row(sqlite3_column_int64(stmt.ptr(), 0), sqlite3_column_int64(stmt.ptr(), 1),
+                    sqlite3_column_int64(stmt.ptr(), 2)))
         {
-          dr.dev.name = std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 0)));
-          dr.dev.origin = std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 1)));
-          last_device_id = current_device_id;
+          return std::nullopt;
         }
-        const std::string date(reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 3)));
-        const auto maybe_time = string_to_time(date);
-        if (!maybe_time.has_value())
-        {
-          return maybe_time.error();
-        }
-        dr.reading.time = maybe_time.value();
-        dr.reading.value = sqlite3_column_int64(stmt.ptr(), 4);
-        data.push_back(dr);
       }
       if (rc != SQLITE_DONE)
       {
@@ -256,37 +533,161 @@ class db: public store, public retrieve
       return std::nullopt;
     }
 
+    template<typename T>
+    std::optional<std::string> load_impl(std::vector<T>& data, const std::string& file_name)
+    {
+      using read_t = decltype(T::reading);
+      std::unordered_map<int64_t, device_handle> devices;
+      const auto on_device = [&devices](const int64_t device_id, const device& dev)
+      {
+        devices[device_id] = device_registry::intern(dev);
+        return true;
+      };
+      T dr;
+      int64_t last_device_id = -1;
+      const auto on_row = [&](const int64_t device_id, const int64_t date, const int64_t value)
+      {
+        if (device_id != last_device_id)
+        {
+          dr.dev = devices[device_id];
+          last_device_id = device_id;
+        }
+        dr.reading.time = epoch_to_time(date);
+        dr.reading.value = value;
+        data.push_back(dr);
+        return true;
+      };
+      return stream_rows<read_t>(file_name, on_device, on_row);
+    }
+
+    template<typename read_t>
+    std::optional<std::string> load_impl(reading_batch<read_t>& batch, const std::string& file_name)
+    {
+      std::unordered_map<int64_t, device_handle> devices;
+      const auto on_device = [&devices](const int64_t device_id, const device& dev)
+      {
+        devices[device_id] = device_registry::intern(dev);
+        return true;
+      };
+      device_handle handle = device_registry::no_device;
+      int64_t last_device_id = -1;
+      const auto on_row = [&](const int64_t device_id, const int64_t date, const int64_t value)
+      {
+        if (device_id != last_device_id)
+        {
+          handle = devices[device_id];
+          last_device_id = device_id;
+        }
+        batch.push_back(handle, date, value);
+        return true;
+      };
+      return stream_rows<read_t>(file_name, on_device, on_row);
+    }
+
     template<typename read_t>
     std::optional<std::string> get_device_readings_impl(const thermos::device& dev, std::vector<read_t>& data, const std::string& file_name, const std::chrono::hours time_span)
     {
-      const auto maybe_id = get_device_id(dev, file_name);
-      if (!maybe_id.has_value())
+      data.clear();
+      read_t r;
+      const auto on_row = [&](const int64_t date, const int64_t value)
       {
-        return maybe_id.error();
-      }
+        r.time = epoch_to_time(date);
+        r.value = value;
+        data.push_back(r);
+        return true;
+      };
+      return device_rows<read_t>(dev, file_name, time_span, on_row);
+    }
+
+    template<typename read_t>
+    std::optional<std::string> get_device_readings_impl(const thermos::device& dev, reading_batch<read_t>& batch, const std::string& file_name, const std::chrono::hours time_span, const resolution res = resolution::raw, const rollup_value rollup = rollup_value::average)
+    {
+      batch.clear();
+      const device_handle handle = device_registry::intern(dev);
+      const auto on_row = [&](const int64_t date, const int64_t value)
+      {
+        batch.push_back(handle, date, value);
+        return true;
+      };
+      return device_rows<read_t>(dev, file_name, time_span, on_row, nullptr, res, rollup);
+    }
 
-      auto maybe_db = sqlite::database::open(file_name);
+    template<typename read_t>
+    std::optional<std::string> get_device_readings_impl(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const reading_visitor<read_t>& on_reading)
+    {
+      int64_t device_id = 0;
+      read_t r;
+      const auto on_row = [&](const int64_t date, const int64_t value)
+      {
+        r.time = epoch_to_time(date);
+        r.value = value;
+        return on_reading(device_id, r);
+      };
+      return device_rows<read_t>(dev, file_name, time_span, on_row, &device_id);
+    }
+
+    /** \brief Streams the raw rows of the latest readings of a device.
+     *
+     * \param dev         the device for which the readings shall be retrieved
+     * \param file_name   the file from which the data shall be loaded
+     * \param time_span   the time span from which the data shall be included
+     * \param on_row      function that receives date in seconds since the Unix
+     *                    epoch and value of every reading, returns false to stop
+     * \param device_id   if not null, receives the database id of the device
+     *                    before the first row is passed to on_row
+     * \param res         resolution of the readings
+     * \param rollup      values that are retrieved from rollups; extremes are
+     *                    passed to on_row as two rows with the same date,
+     *                    unless minimum and maximum are equal
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if on_row stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    template<typename read_t, typename row_fn>
+    std::optional<std::string> device_rows(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const row_fn& on_row, int64_t* device_id = nullptr, const resolution res = resolution::raw, const rollup_value rollup = rollup_value::average)
+    {
+      const auto source = source_of(res, rollup);
+      auto maybe_db = get_connection(file_name);
       if (!maybe_db.has_value())
       {
         return maybe_db.error();
       }
-      auto& dbase = maybe_db.value();
+      auto& dbase = *maybe_db.value();
 
-      std::string max_date;
+      const auto maybe_id = find_device_id(dbase, dev);
+      if (!maybe_id.has_value())
       {
-        auto maybe_stmt = dbase.prepare("SELECT MAX(date) FROM reading WHERE deviceId ="
-                                       + std::to_string(maybe_id.value()) + " LIMIT 1;");
+        return maybe_id.error();
+      }
+      if (device_id != nullptr)
+      {
+        *device_id = maybe_id.value();
+      }
+
+      int64_t max_date = 0;
+      {
+        // Filtering by type allows to answer this query with a single lookup
+        // in the reading index.
+        auto maybe_stmt = dbase.prepare("SELECT MAX(" + source.date + ") FROM " + source.table + " WHERE deviceId = @dev AND type = @t LIMIT 1;");
         if (!maybe_stmt.has_value())
         {
           return maybe_stmt.error();
         }
         auto& stmt = maybe_stmt.value();
-        data.clear();
+        if (!stmt.bind(1, maybe_id.value()) || !stmt.bind(2, to_string(read_t::type())))
+        {
+          return "Could not bind device id and reading type to prepared statement!";
+        }
         const int rc = sqlite3_step(stmt.ptr());
         switch (rc)
         {
           case SQLITE_ROW:
-               max_date = reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 0));
+               if (sqlite3_column_type(stmt.ptr(), 0) == SQLITE_NULL)
+               {
+                 // No readings of that type for the device.
+                 return std::nullopt;
+               }
+               max_date = sqlite3_column_int64(stmt.ptr(), 0);
                break;
           case SQLITE_DONE:
                // No data.
@@ -296,32 +697,35 @@ class db: public store, public retrieve
         }
       }
 
-      const auto hours = std::to_string(std::abs(static_cast<long long int>(time_span.count())));
-      auto maybe_stmt = dbase.prepare("SELECT date, value FROM reading WHERE deviceId ="
-          + std::to_string(maybe_id.value())
-          + " AND type = @t AND date >= datetime(@max_d, '-" + hours + " hours');");
+      // The SQL text does not depend on device or time span, so the
+      // statement can be reused from the statement cache of the connection.
+      const int64_t span = std::abs(std::chrono::duration_cast<std::chrono::seconds>(time_span).count());
+      const std::string extra = source.extra.empty() ? "" : ", " + source.extra;
+      auto maybe_stmt = dbase.prepare("SELECT " + source.date + ", " + source.value + extra + " FROM " + source.table
+          + " WHERE deviceId = @dev AND type = @t AND " + source.date + " >= @min_d ORDER BY " + source.date + " ASC;");
       if (!maybe_stmt.has_value())
       {
         return maybe_stmt.error();
       }
       auto& stmt = maybe_stmt.value();
-      read_t r;
-      if (!stmt.bind(1, to_string(r.type())) || !stmt.bind(2, max_date))
+      if (!stmt.bind(1, maybe_id.value()) || !stmt.bind(2, to_string(read_t::type()))
+          || !stmt.bind(3, max_date - span))
       {
-        return "Could not bind reading data and maximum date to prepared statement!";
+        return "Could not bind reading data and minimum date to prepared statement!";
       }
       int rc = -1;
       while ((rc = sqlite3_step(stmt.ptr())) == SQLITE_ROW)
       {
-        const std::string date(reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 0)));
-        const auto maybe_time = string_to_time(date);
-        if (!maybe_time.has_value())
+        const int64_t date = sqlite3_column_int64(stmt.ptr(), 0);
+        if (!on_row(date, sqlite3_column_int64(stmt.ptr(), 1)))
         {
-          return maybe_time.error();
+          return std::nullopt;
+        }
+        if (!extra.empty() && (sqlite3_column_int64(stmt.ptr(), 2) != sqlite3_column_int64(stmt.ptr(), 1))
+            && !on_row(date, sqlite3_column_int64(stmt.ptr(), 2)))
+        {
+          return std::nullopt;
         }
-        r.time = maybe_time.value();
-        r.value = sqlite3_column_int64(stmt.ptr(), 1);
-        data.push_back(r);
       }
       if (rc != SQLITE_DONE)
       {
@@ -331,6 +735,74 @@ class db: public store, public retrieve
 
       return std::nullopt;
     }
+
+    template<typename read_t>
+    std::optional<std::string> get_latest_readings_impl(reading_batch<read_t>& batch, const std::string& file_name, const std::chrono::hours time_span, const resolution res = resolution::raw, const rollup_value rollup = rollup_value::average)
+    {
+      const auto source = source_of(res, rollup);
+      batch.clear();
+      auto maybe_db = get_connection(file_name);
+      if (!maybe_db.has_value())
+      {
+        return maybe_db.error();
+      }
+      auto& dbase = *maybe_db.value();
+
+      // The latest date of each device is a single lookup in the reading
+      // index, and so is the start of the range scan for its readings.
+      // Column names of the reading source do not clash with the columns of
+      // the device table, so they need no table prefix.
+      const std::string extra = source.extra.empty() ? "" : ", " + source.extra;
+      auto maybe_stmt = dbase.prepare("SELECT device.deviceId, device.name, device.origin, " + source.date + ", " + source.value + extra
+          + " FROM (SELECT deviceId AS devid,"
+          + " (SELECT MAX(" + source.date + ") FROM " + source.table + " AS src WHERE src.deviceId = device.deviceId AND src.type = @t) AS max_date"
+          + " FROM device) AS latest"
+          + " JOIN device ON device.deviceId = latest.devid"
+          + " JOIN " + source.table + " AS src ON src.deviceId = latest.devid"
+          + " WHERE latest.max_date IS NOT NULL AND src.type = @t AND " + source.date + " >= latest.max_date - @span"
+          + " ORDER BY device.name ASC, device.deviceId ASC, " + source.date + " ASC;");
+      if (!maybe_stmt.has_value())
+      {
+        return maybe_stmt.error();
+      }
+      auto& stmt = maybe_stmt.value();
+      const int64_t span = std::abs(std::chrono::duration_cast<std::chrono::seconds>(time_span).count());
+      if (!stmt.bind(1, to_string(read_t::type())) || !stmt.bind(2, span))
+      {
+        return "Could not bind reading type and time span to prepared statement!";
+      }
+
+      int64_t last_device_id = -1;
+      device_handle handle = device_registry::no_device;
+      int rc = -1;
+      while ((rc = sqlite3_step(stmt.ptr())) == SQLITE_ROW)
+      {
+        const int64_t device_id = sqlite3_column_int64(stmt.ptr(), 0);
+        if (device_id != last_device_id)
+        {
+          const device dev(reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 1)),
+                           reinterpret_cast<const char*>(sqlite3_column_text(stmt.ptr(), 2)));
+          handle = device_registry::intern(dev);
+          last_device_id = device_id;
+        }
+        batch.push_back(handle, sqlite3_column_int64(stmt.ptr(), 3), sqlite3_column_int64(stmt.ptr(), 4));
+        if (!extra.empty() && (sqlite3_column_int64(stmt.ptr(), 5) != sqlite3_column_int64(stmt.ptr(), 4)))
+        {
+          batch.push_back(handle, sqlite3_column_int64(stmt.ptr(), 3), sqlite3_column_int64(stmt.ptr(), 5));
+        }
+      }
+      if (rc != SQLITE_DONE)
+      {
+        // An error occurred.
+        return "Failed to retrieve data from database query.";
+      }
+
+      return std::nullopt;
+    }
+
+    sqlite::options connection_options; /**< options for new database connections */
+    std::optional<session> current_session; /**< session for write operations, if any */
+    std::optional<std::pair<std::string, sqlite::database>> reader; /**< file name and connection for read operations, if any */
 };
 
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -27,13 +27,13 @@
 namespace thermos::storage
 {
 
-std::unique_ptr<store> factory::create(const type t)
+std::unique_ptr<store> factory::create(const type t, [[maybe_unused]] const sqlite::options& connection)
 {
   switch (t)
   {
     #if !defined(THERMOS_NO_SQLITE)
     case type::db:
-         return std::make_unique<db>();
+         return std::make_unique<db>(connection);
     #endif
     case type::csv:
          return std::make_unique<csv>();
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,6 +22,7 @@
 #define THERMOS_STORAGE_FACTORY_HPP
 
 #include <memory>
+#include "../sqlite/options.hpp"
 #include "store.hpp"
 #include "type.hpp"
 
@@ -34,11 +35,13 @@ struct factory
 {
   /** \brief Creates a store instance based on the given type.
    *
-   * \param t     type of the store instance to create
+   * \param t            type of the store instance to create
+   * \param connection   options for database connections, only used by
+   *                     stores of type db
    * \return Returns a unique_ptr to the created instance.
    *         Returns nullptr, if the type is not supported.
    */
-  static std::unique_ptr<store> create(const type t);
+  static std::unique_ptr<store> create(const type t, const sqlite::options& connection = sqlite::options());
 };
 
 } // namespace
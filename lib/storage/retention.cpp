@@ -0,0 +1,150 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "retention.hpp"
+#include <charconv>
+#include <limits>
+
+namespace thermos::storage
+{
+
+bool retention_policy::keeps_everything() const
+{
+  return !raw.has_value() && !hourly.has_value() && !daily.has_value();
+}
+
+namespace
+{
+
+/** \brief Parses the duration part of a retention entry.
+ *
+ * \param text   the duration, e. g. "14d" or "forever"
+ * \return Returns the duration, or an empty optional for "forever".
+ *         Returns an error message, if the duration is invalid.
+ */
+nonstd::expected<std::optional<std::chrono::hours>, std::string> parse_duration(const std::string& text)
+{
+  if (text == "forever")
+  {
+    return std::optional<std::chrono::hours>();
+  }
+  if (text.size() < 2)
+  {
+    return nonstd::make_unexpected("'" + text + "' is not a valid duration.");
+  }
+
+  int64_t hours_per_unit = 0;
+  switch (text.back())
+  {
+    case 'h':
+         hours_per_unit = 1;
+         break;
+    case 'd':
+         hours_per_unit = 24;
+         break;
+    case 'y':
+         hours_per_unit = 24 * 365;
+         break;
+    default:
+         return nonstd::make_unexpected("'" + text + "' has no valid unit. "
+             + "Allowed units are h (hours), d (days) and y (years).");
+  }
+
+  int64_t count = 0;
+  const char* first = text.data();
+  const char* last = text.data() + text.size() - 1;
+  const auto [ptr, ec] = std::from_chars(first, last, count);
+  if ((ec != std::errc()) || (ptr != last) || (count <= 0)
+      || (count > std::numeric_limits<int32_t>::max() / hours_per_unit))
+  {
+    return nonstd::make_unexpected("'" + text + "' is not a valid duration.");
+  }
+
+  return std::optional<std::chrono::hours>(std::chrono::hours(count * hours_per_unit));
+}
+
+} // anonymous namespace
+
+nonstd::expected<retention_policy, std::string> retention_policy::parse(const std::string& text)
+{
+  retention_policy policy;
+  bool raw_seen = false;
+  bool hourly_seen = false;
+  bool daily_seen = false;
+
+  std::string::size_type start = 0;
+  while (start <= text.size())
+  {
+    auto end = text.find(',', start);
+    if (end == std::string::npos)
+    {
+      end = text.size();
+    }
+    const std::string entry = text.substr(start, end - start);
+    start = end + 1;
+
+    const auto equals = entry.find('=');
+    if (equals == std::string::npos)
+    {
+      return nonstd::make_unexpected("'" + entry + "' is not a valid retention "
+          + "entry. Entries have to look like 'raw=14d'.");
+    }
+    const std::string name = entry.substr(0, equals);
+    const auto duration = parse_duration(entry.substr(equals + 1));
+    if (!duration.has_value())
+    {
+      return nonstd::make_unexpected(duration.error());
+    }
+
+    bool* seen = nullptr;
+    std::optional<std::chrono::hours>* target = nullptr;
+    if (name == "raw")
+    {
+      seen = &raw_seen;
+      target = &policy.raw;
+    }
+    else if (name == "hourly")
+    {
+      seen = &hourly_seen;
+      target = &policy.hourly;
+    }
+    else if (name == "daily")
+    {
+      seen = &daily_seen;
+      target = &policy.daily;
+    }
+    else
+    {
+      return nonstd::make_unexpected("'" + name + "' is not a valid resolution. "
+          + "Allowed resolutions are raw, hourly and daily.");
+    }
+    if (*seen)
+    {
+      return nonstd::make_unexpected("The retention of '" + name
+          + "' is given more than once.");
+    }
+    *seen = true;
+    *target = duration.value();
+  }
+
+  return policy;
+}
+
+} // namespace
@@ -0,0 +1,67 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_STORAGE_RETENTION_HPP
+#define THERMOS_STORAGE_RETENTION_HPP
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include "../../third-party/nonstd/expected.hpp"
+
+namespace thermos::storage
+{
+
+/** \brief Determines how long the readings of each resolution are kept in a
+ *         database.
+ *
+ * An empty optional means that the readings of that resolution are kept
+ * forever. The default policy keeps everything, i. e. nothing is deleted.
+ */
+struct retention_policy
+{
+  std::optional<std::chrono::hours> raw;    /**< retention of the raw readings */
+  std::optional<std::chrono::hours> hourly; /**< retention of the hourly rollups */
+  std::optional<std::chrono::hours> daily;  /**< retention of the daily rollups */
+
+  /** \brief Checks whether the policy keeps all readings forever.
+   *
+   * \return Returns true, if no readings are ever deleted by this policy.
+   */
+  bool keeps_everything() const;
+
+  /** \brief Parses a retention policy from a string.
+   *
+   * The string is a comma-separated list of entries like "raw=14d", where the
+   * name is one of "raw", "hourly" and "daily", and the duration is either a
+   * positive number followed by one of the units "h" (hours), "d" (days) or
+   * "y" (years of 365 days), or the word "forever". Resolutions that are not
+   * mentioned are kept forever, e. g. "raw=14d,hourly=1y" keeps raw readings
+   * for 14 days, hourly rollups for a year and daily rollups forever.
+   * \param text   the string to parse
+   * \return Returns the parsed policy in case of success.
+   *         Returns an error message, if the string is not a valid policy.
+   */
+  static nonstd::expected<retention_policy, std::string> parse(const std::string& text);
+};
+
+} // namespace
+
+#endif // THERMOS_STORAGE_RETENTION_HPP
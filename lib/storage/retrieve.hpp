@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,6 +22,7 @@
 #define THERMOS_STORAGE_RETRIEVE_HPP
 
 #include <chrono>
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
@@ -32,6 +33,21 @@
 namespace thermos::storage
 {
 
+/** \brief Function that receives a device and the id that is used to refer to
+ *         the device while readings are streamed.
+ *
+ * \return Shall return true to continue streaming, or false to stop.
+ */
+using device_visitor = std::function<bool(const int64_t device_id, const thermos::device& dev)>;
+
+/** \brief Function that receives a single reading of a device while readings
+ *         are streamed.
+ *
+ * \return Shall return true to continue streaming, or false to stop.
+ */
+template<typename reading_t>
+using reading_visitor = std::function<bool(const int64_t device_id, const reading_t& reading)>;
+
 /** \brief Interface for retrieving device readings from a file or database.
  */
 class retrieve
@@ -61,6 +77,36 @@ class retrieve
     virtual std::optional<std::string> load(std::vector<thermos::load::device_reading>& data, const std::string& file_name) = 0;
 
 
+    /** \brief Streams thermal device readings from a file, one at a time.
+     *
+     * First on_device is called for every device with thermal readings. After
+     * that on_reading is called for every reading, ordered by device and time.
+     * Readings only refer to their device by its id, so memory usage does not
+     * depend on the number of readings in the file.
+     * \param file_name    the file from which the data shall be loaded
+     * \param on_device    function that receives the devices
+     * \param on_reading   function that receives the readings
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if one of the functions stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    virtual std::optional<std::string> load(const std::string& file_name, const device_visitor& on_device, const reading_visitor<thermal::reading>& on_reading) = 0;
+
+
+    /** \brief Streams CPU load readings from a file, one at a time.
+     *
+     * First on_device is called for every device with CPU load readings. After
+     * that on_reading is called for every reading, ordered by device and time.
+     * \param file_name    the file from which the data shall be loaded
+     * \param on_device    function that receives the devices
+     * \param on_reading   function that receives the readings
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if one of the functions stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    virtual std::optional<std::string> load(const std::string& file_name, const device_visitor& on_device, const reading_visitor<load::reading>& on_reading) = 0;
+
+
     /** \brief Loads all available devices (NOT their readings) from a file.
      *
      * \param data        the vector where the devices shall be stored
@@ -85,6 +131,22 @@ class retrieve
      */
     virtual std::optional<std::string> get_device_readings(const thermos::device& dev, std::vector<load::reading>& data, const std::string& file_name, const std::chrono::hours time_span) = 0;
     virtual std::optional<std::string> get_device_readings(const thermos::device& dev, std::vector<thermal::reading>& data, const std::string& file_name, const std::chrono::hours time_span) = 0;
+
+
+    /** \brief Streams readings of a device from a file, one at a time.
+     *
+     * \param dev          the device for which the readings shall be retrieved
+     * \param file_name    the file from which the data shall be loaded
+     * \param time_span    the time span from which the data shall be included;
+     *                     Settings this to e. g. two hours will retrieve the
+     *                     data from the latest time up to two hours back.
+     * \param on_reading   function that receives the readings, ordered by time
+     * \return Returns an empty optional, if the data was read successfully or
+     *         if on_reading stopped the streaming.
+     *         Returns an error message otherwise.
+     */
+    virtual std::optional<std::string> get_device_readings(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const reading_visitor<load::reading>& on_reading) = 0;
+    virtual std::optional<std::string> get_device_readings(const thermos::device& dev, const std::string& file_name, const std::chrono::hours time_span, const reading_visitor<thermal::reading>& on_reading) = 0;
 };
 
 } // namespace
@@ -0,0 +1,322 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "schema.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+#include "../sqlite/transaction.hpp"
+
+namespace thermos::storage
+{
+
+namespace
+{
+
+/** \brief Creates the tables of schema version zero.
+ *
+ * New databases use incremental auto vacuum, so that the space of deleted
+ * readings can be given back in small steps, see compaction::vacuum().
+ * \param db   the database connection
+ * \return Returns an empty optional, if the tables were created successfully.
+ *         Returns an error message otherwise.
+ */
+std::optional<std::string> create_tables(sqlite::database& db)
+{
+  const std::string statement = R"SQL(
+      PRAGMA auto_vacuum = INCREMENTAL;
+      CREATE TABLE device (
+        deviceId INTEGER PRIMARY KEY NOT NULL,
+        name TEXT NOT NULL,
+        origin TEXT NOT NULL
+      );
+      CREATE TABLE reading (
+        readingId INTEGER PRIMARY KEY NOT NULL,
+        deviceId INTEGER NOT NULL,
+        type TEXT,
+        date TEXT,
+        value INTEGER
+      );
+      )SQL";
+  if (!db.exec(statement))
+    return "Failed to create tables.";
+
+  return std::nullopt;
+}
+
+/** \brief Migrates the schema from version zero to version one.
+ *
+ * Version one adds a unique index on the devices, so that the lookup of a
+ * device is an index probe, and indexes on the readings that cover the
+ * queries for the latest readings of a device and for the devices with
+ * readings of a certain type.
+ * \param db   the database connection
+ * \return Returns an empty optional, if the migration was successful.
+ *         Returns an error message otherwise.
+ */
+std::optional<std::string> migrate_to_v1(sqlite::database& db)
+{
+  // Older versions did not prevent duplicate devices, so those have to be
+  // merged before the unique index can be created. Readings of duplicates
+  // are assigned to the device with the lowest id.
+  const std::string statement = R"SQL(
+      UPDATE reading SET deviceId = (
+          SELECT MIN(d2.deviceId) FROM device AS d1
+            JOIN device AS d2 ON d1.origin = d2.origin AND d1.name = d2.name
+          WHERE d1.deviceId = reading.deviceId)
+        WHERE deviceId IN (SELECT d1.deviceId FROM device AS d1
+            JOIN device AS d2 ON d1.origin = d2.origin AND d1.name = d2.name
+            AND d2.deviceId < d1.deviceId);
+      DELETE FROM device WHERE EXISTS (SELECT 1 FROM device AS d2
+          WHERE d2.origin = device.origin AND d2.name = device.name
+          AND d2.deviceId < device.deviceId);
+      CREATE UNIQUE INDEX IF NOT EXISTS device_origin_name ON device (origin, name);
+      CREATE INDEX IF NOT EXISTS reading_device_type_date ON reading (deviceId, type, date, value);
+      CREATE INDEX IF NOT EXISTS reading_type_device ON reading (type, deviceId);
+      )SQL";
+  if (!db.exec(statement))
+    return "Failed to migrate database schema to version 1.";
+
+  return std::nullopt;
+}
+
+/** \brief Migrates the schema from version one to version two.
+ *
+ * Version two stores the date of a reading as seconds since the Unix epoch
+ * (UTC) in an INTEGER column instead of a TEXT column containing the local
+ * time as 'YYYY-MM-DD hh:mm:ss'. Since SQLite cannot change the type of a
+ * column, the reading table is rebuilt.
+ * \param db   the database connection
+ * \return Returns an empty optional, if the migration was successful.
+ *         Returns an error message otherwise.
+ */
+std::optional<std::string> migrate_to_v2(sqlite::database& db)
+{
+  // The 'utc' modifier treats the stored date as local time, which is how
+  // older versions of thermos wrote it.
+  const std::string statement = R"SQL(
+      CREATE TABLE reading_v2 (
+        readingId INTEGER PRIMARY KEY NOT NULL,
+        deviceId INTEGER NOT NULL,
+        type TEXT,
+        date INTEGER,
+        value INTEGER
+      );
+      INSERT INTO reading_v2 (readingId, deviceId, type, date, value)
+        SELECT readingId, deviceId, type, CAST(strftime('%s', date, 'utc') AS INTEGER), value
+        FROM reading;
+      DROP TABLE reading;
+      ALTER TABLE reading_v2 RENAME TO reading;
+      CREATE INDEX reading_device_type_date ON reading (deviceId, type, date, value);
+      CREATE INDEX reading_type_device ON reading (type, deviceId);
+      )SQL";
+  if (!db.exec(statement))
+    return "Failed to migrate database schema to version 2.";
+
+  return std::nullopt;
+}
+
+/** \brief Migrates the schema from version two to version three.
+ *
+ * Version three adds the rollup tables rollup_hour and rollup_day, which
+ * contain minimum, maximum, sum and number of the readings per device, type
+ * and hour or day (UTC), respectively. A trigger updates them whenever a
+ * reading is inserted, and existing readings are aggregated during the
+ * migration. Deleting readings does not change the rollups, so aggregates of
+ * old readings stay available. An index on the date of the readings allows
+ * to find expired readings without scanning the whole table.
+ * \param db   the database connection
+ * \return Returns an empty optional, if the migration was successful.
+ *         Returns an error message otherwise.
+ */
+std::optional<std::string> migrate_to_v3(sqlite::database& db)
+{
+  // Readings with NULL values cannot be aggregated. Older versions of
+  // thermos never wrote those, but the columns allow them.
+  const std::string statement = R"SQL(
+      CREATE TABLE rollup_hour (
+        deviceId INTEGER NOT NULL,
+        type TEXT NOT NULL,
+        bucket INTEGER NOT NULL,
+        min_value INTEGER NOT NULL,
+        max_value INTEGER NOT NULL,
+        value_sum INTEGER NOT NULL,
+        value_count INTEGER NOT NULL,
+        PRIMARY KEY (deviceId, type, bucket)
+      ) WITHOUT ROWID;
+      CREATE TABLE rollup_day (
+        deviceId INTEGER NOT NULL,
+        type TEXT NOT NULL,
+        bucket INTEGER NOT NULL,
+        min_value INTEGER NOT NULL,
+        max_value INTEGER NOT NULL,
+        value_sum INTEGER NOT NULL,
+        value_count INTEGER NOT NULL,
+        PRIMARY KEY (deviceId, type, bucket)
+      ) WITHOUT ROWID;
+      INSERT INTO rollup_hour (deviceId, type, bucket, min_value, max_value, value_sum, value_count)
+        SELECT deviceId, type, date - date % 3600, MIN(value), MAX(value), SUM(value), COUNT(*)
+        FROM reading
+        WHERE type IS NOT NULL AND date IS NOT NULL AND value IS NOT NULL
+        GROUP BY deviceId, type, date - date % 3600;
+      INSERT INTO rollup_day (deviceId, type, bucket, min_value, max_value, value_sum, value_count)
+        SELECT deviceId, type, bucket - bucket % 86400, MIN(min_value), MAX(max_value), SUM(value_sum), SUM(value_count)
+        FROM rollup_hour
+        GROUP BY deviceId, type, bucket - bucket % 86400;
+      CREATE INDEX reading_date ON reading (date);
+      CREATE TRIGGER reading_rollup AFTER INSERT ON reading
+        WHEN NEW.type IS NOT NULL AND NEW.date IS NOT NULL AND NEW.value IS NOT NULL
+      BEGIN
+        INSERT INTO rollup_hour (deviceId, type, bucket, min_value, max_value, value_sum, value_count)
+          VALUES (NEW.deviceId, NEW.type, NEW.date - NEW.date % 3600, NEW.value, NEW.value, NEW.value, 1)
+          ON CONFLICT (deviceId, type, bucket) DO UPDATE SET
+            min_value = MIN(min_value, excluded.min_value),
+            max_value = MAX(max_value, excluded.max_value),
+            value_sum = value_sum + excluded.value_sum,
+            value_count = value_count + 1;
+        INSERT INTO rollup_day (deviceId, type, bucket, min_value, max_value, value_sum, value_count)
+          VALUES (NEW.deviceId, NEW.type, NEW.date - NEW.date % 86400, NEW.value, NEW.value, NEW.value, 1)
+          ON CONFLICT (deviceId, type, bucket) DO UPDATE SET
+            min_value = MIN(min_value, excluded.min_value),
+            max_value = MAX(max_value, excluded.max_value),
+            value_sum = value_sum + excluded.value_sum,
+            value_count = value_count + 1;
+      END;
+      )SQL";
+  if (!db.exec(statement))
+    return "Failed to migrate database schema to version 3.";
+
+  return std::nullopt;
+}
+
+/** \brief Gets the error message for a database with a newer schema version.
+ *
+ * \param version   the schema version of the database
+ * \return Returns the error message.
+ */
+std::string newer_version_error(const int64_t version)
+{
+  return "The database has schema version " + std::to_string(version)
+      + ", but this program only supports versions up to "
+      + std::to_string(schema::current_version) + ". Please use a newer version of"
+      + " thermos to access this database.";
+}
+
+} // anonymous namespace
+
+std::optional<std::string> schema::ensure_current(sqlite::database& db)
+{
+  auto maybe_version = db.user_version();
+  if (!maybe_version.has_value())
+  {
+    return maybe_version.error();
+  }
+  const int64_t version = maybe_version.value();
+  if (version == current_version)
+  {
+    return std::nullopt;
+  }
+  if ((version > current_version) || (version < 0))
+  {
+    return newer_version_error(version);
+  }
+
+  auto maybe_transaction = sqlite::transaction::begin(db);
+  if (!maybe_transaction.has_value())
+  {
+    return maybe_transaction.error();
+  }
+
+  if (version == 0)
+  {
+    // Version zero may also be a completely new database without any tables.
+    const auto exists = db.table_exists("device");
+    if (!exists.has_value())
+    {
+      return exists.error();
+    }
+    if (!exists.value())
+    {
+      const auto error = create_tables(db);
+      if (error.has_value())
+      {
+        return error;
+      }
+    }
+  }
+
+  if (version < 1)
+  {
+    const auto error = migrate_to_v1(db);
+    if (error.has_value())
+    {
+      return error;
+    }
+  }
+
+  if (version < 2)
+  {
+    const auto error = migrate_to_v2(db);
+    if (error.has_value())
+    {
+      return error;
+    }
+  }
+
+  if (version < 3)
+  {
+    const auto error = migrate_to_v3(db);
+    if (error.has_value())
+    {
+      return error;
+    }
+  }
+
+  if (!db.set_user_version(current_version))
+  {
+    return "Failed to set schema version of the database.";
+  }
+
+  return maybe_transaction.value().commit();
+}
+
+std::optional<std::string> schema::check_current(sqlite::database& db)
+{
+  auto maybe_version = db.user_version();
+  if (!maybe_version.has_value())
+  {
+    return maybe_version.error();
+  }
+  const int64_t version = maybe_version.value();
+  if (version == current_version)
+  {
+    return std::nullopt;
+  }
+  if ((version > current_version) || (version < 0))
+  {
+    return newer_version_error(version);
+  }
+  return "The database has schema version " + std::to_string(version)
+      + ", but this program needs version " + std::to_string(current_version)
+      + ". Run thermos-logger with this database once to upgrade it.";
+}
+
+} // namespace
+
+#endif // SQLite feature guard
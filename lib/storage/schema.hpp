@@ -0,0 +1,72 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_STORAGE_SCHEMA_HPP
+#define THERMOS_STORAGE_SCHEMA_HPP
+
+#if !defined(THERMOS_NO_SQLITE)
+#include <cstdint>
+#include <optional>
+#include <string>
+#include "../sqlite/database.hpp"
+
+namespace thermos::storage
+{
+
+/** \brief Creates and upgrades the schema of SQLite 3 databases that contain
+ *         device readings.
+ *
+ * The schema version is stored in the user_version pragma of the database.
+ * Version zero is the schema of databases created by thermos 0.6.1 and
+ * earlier, i. e. the device and reading tables without any indexes.
+ */
+struct schema
+{
+  /// current version of the database schema
+  static constexpr int64_t current_version = 3;
+
+  /** \brief Makes sure that the database contains all tables and indexes of
+   *         the current schema version, migrating older schemas if needed.
+   *
+   * \param db   the database connection
+   * \return Returns an empty optional, if the schema is up to date.
+   *         Returns an error message otherwise.
+   * \remarks All migration steps are done within a single transaction, so
+   *          either the database is fully upgraded or it is left unchanged.
+   */
+  static std::optional<std::string> ensure_current(sqlite::database& db);
+
+  /** \brief Checks that the database has the current schema version without
+   *         changing the database.
+   *
+   * \param db   the database connection
+   * \return Returns an empty optional, if the schema is up to date.
+   *         Returns an error message otherwise.
+   * \remarks This is meant for programs that only read readings, so they
+   *          never upgrade a database that another program may still use.
+   */
+  static std::optional<std::string> check_current(sqlite::database& db);
+};
+
+} // namespace
+
+#endif // SQLite feature guard
+
+#endif // THERMOS_STORAGE_SCHEMA_HPP
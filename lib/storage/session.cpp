@@ -0,0 +1,140 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#if !defined(THERMOS_NO_SQLITE)
+#include "session.hpp"
+#include "schema.hpp"
+
+namespace thermos::storage
+{
+
+nonstd::expected<session, std::string> session::open(const std::string& file_name, const sqlite::options& opts)
+{
+  // Open the database.
+  auto maybe_db = sqlite::database::open(file_name, opts);
+  if (!maybe_db.has_value())
+  {
+    return nonstd::make_unexpected(maybe_db.error());
+  }
+  auto& db_ = maybe_db.value();
+  // Make sure the schema is correct and up to date.
+  const auto error = schema::ensure_current(db_);
+  if (error.has_value())
+  {
+    return nonstd::make_unexpected(error.value());
+  }
+
+  auto maybe_stmt = db_.prepare("INSERT INTO reading (deviceId, type, date, value) VALUES (@dev, @type, @date, @value);");
+  if (!maybe_stmt.has_value())
+  {
+    return nonstd::make_unexpected(maybe_stmt.error());
+  }
+
+  return session(file_name, std::move(db_), std::move(maybe_stmt.value()));
+}
+
+session::session(const std::string& file_name, sqlite::database&& the_db, sqlite::statement&& insert)
+: file(file_name),
+  db(std::move(the_db)),
+  insert_stmt(std::move(insert)),
+  device_ids({})
+{
+}
+
+const std::string& session::file_name() const
+{
+  return file;
+}
+
+sqlite::database& session::database()
+{
+  return db;
+}
+
+nonstd::expected<int64_t, std::string> session::device_id(const device_handle handle)
+{
+  if ((handle < device_ids.size()) && (device_ids[handle] != 0))
+  {
+    return device_ids[handle];
+  }
+
+  const auto id = find_or_create_device(device_registry::get(handle));
+  if (id.has_value())
+  {
+    if (handle >= device_ids.size())
+    {
+      device_ids.resize(handle + 1, 0);
+    }
+    device_ids[handle] = id.value();
+  }
+  return id;
+}
+
+nonstd::expected<int64_t, std::string> session::find_or_create_device(const device& dev)
+{
+  {
+    auto maybe_stmt = db.prepare("SELECT deviceId FROM device WHERE origin = @ori AND name = @name LIMIT 1;");
+    if (!maybe_stmt.has_value())
+    {
+      return nonstd::make_unexpected(maybe_stmt.error());
+    }
+    auto& stmt = maybe_stmt.value();
+    if (!stmt.bind(1, dev.origin) || !stmt.bind(2, dev.name))
+    {
+      return nonstd::make_unexpected("Could not bind device data to prepared statement!");
+    }
+
+    const int rc = sqlite3_step(stmt.ptr());
+    if (rc == SQLITE_ROW)
+    {
+      return sqlite3_column_int64(stmt.ptr(), 0);
+    }
+    if (rc != SQLITE_DONE)
+    {
+      // An error occurred.
+      return nonstd::make_unexpected("Failed to retrieve data from database query.");
+    }
+    // End of statement scope ensures statement is finalized.
+  }
+
+  // SQLITE_DONE means "no more data", so the device does not exist yet.
+  auto maybe_stmt = db.prepare("INSERT INTO device (origin, name) VALUES (@ori, @name);");
+  if (!maybe_stmt.has_value())
+  {
+    return nonstd::make_unexpected(maybe_stmt.error());
+  }
+  auto& stmt = maybe_stmt.value();
+  if (!stmt.bind(1, dev.origin) || !stmt.bind(2, dev.name))
+  {
+    return nonstd::make_unexpected("Could not bind device data to prepared statement!");
+  }
+  const auto ret = sqlite3_step(stmt.ptr());
+  if ((ret != SQLITE_OK) && (ret != SQLITE_DONE))
+  {
+    std::string message{"Error: Could not insert device data for '"};
+    message.append(dev.name).append("' / '").append(dev.origin)
+           .append("' into database!");
+    return nonstd::make_unexpected(message);
+  }
+  return db.last_insert_id();
+}
+
+} // namespace
+#endif // SQLite
@@ -0,0 +1,180 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_STORAGE_SESSION_HPP
+#define THERMOS_STORAGE_SESSION_HPP
+
+#if !defined(THERMOS_NO_SQLITE)
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../third-party/nonstd/expected.hpp"
+#include "../device.hpp"
+#include "../device_reading.hpp"
+#include "../sqlite/database.hpp"
+#include "../sqlite/statement.hpp"
+#include "../sqlite/transaction.hpp"
+#include "utilities.hpp"
+
+namespace thermos::storage
+{
+
+/** \brief Long-lived connection to a SQLite 3 database used for writing
+ *         device readings.
+ *
+ * The database file is opened and its schema is checked (and upgraded, if
+ * necessary) only once, when the session is opened. The prepared INSERT
+ * statement and the ids of already known devices are kept for the whole
+ * lifetime of the session, so that saving readings only costs the actual
+ * inserts.
+ */
+class session
+{
+  public:
+    /** \brief Opens a database file for writing and makes sure that the tables
+     *         needed to save readings exist.
+     *
+     * \param file_name   the database file to open or create
+     * \param opts        options for the database connection
+     * \return Returns the session, if the database was opened successfully.
+     *         Returns an error message otherwise.
+     */
+    static nonstd::expected<session, std::string> open(const std::string& file_name, const sqlite::options& opts = sqlite::options());
+
+    /** \brief Gets the name of the database file of this session.
+     *
+     * \return Returns the file name that was used to open the session.
+     */
+    const std::string& file_name() const;
+
+    /** \brief Gets the underlying database connection.
+     *
+     * \return Returns a reference to the database connection.
+     */
+    sqlite::database& database();
+
+    /** \brief Finds a device in the database or creates it, if it is missing.
+     *
+     * \param handle  handle of the device to find or to create
+     * \return Returns the id of the device used in the database in case of
+     *         success. Returns an error message, if an error occurred.
+     * \remarks Ids are cached, so every device is only looked up once per
+     *          session.
+     */
+    nonstd::expected<int64_t, std::string> device_id(const device_handle handle);
+
+    /** \brief Inserts device readings into the database.
+     *
+     * All readings are inserted within a single transaction. If any of the
+     * inserts fails, then the transaction is rolled back, so either all of
+     * the readings are saved or none of them.
+     * \param data   the device readings to insert
+     * \return Returns an empty optional, if insertion was successful.
+     *         Returns an error message otherwise.
+     */
+    template<typename T>
+    std::optional<std::string> insert(const std::vector<device_reading<T>>& data)
+    {
+      if (data.empty())
+      {
+        return std::nullopt;
+      }
+
+      // Without an explicit transaction SQLite would commit (and sync to disk)
+      // after every single insert.
+      auto maybe_transaction = sqlite::transaction::begin(db);
+      if (!maybe_transaction.has_value())
+      {
+        return maybe_transaction.error();
+      }
+
+      auto error = insert_readings(data);
+      if (!error.has_value())
+      {
+        error = maybe_transaction.value().commit();
+      }
+      if (error.has_value())
+      {
+        // The transaction will be rolled back, so ids of devices that were
+        // created during the transaction are not valid anymore.
+        device_ids.clear();
+      }
+      return error;
+    }
+  private:
+    session(const std::string& file_name, sqlite::database&& the_db, sqlite::statement&& insert);
+
+    /** \brief Inserts device readings into the database, without starting a
+     *         transaction.
+     *
+     * \param data   the device readings to insert, must not be empty
+     * \return Returns an empty optional, if insertion was successful.
+     *         Returns an error message otherwise.
+     */
+    template<typename T>
+    std::optional<std::string> insert_readings(const std::vector<device_reading<T>>& data)
+    {
+      const std::string type_name = to_string(T::type());
+      for(const auto& reading: data)
+      {
+        const auto dev_id = device_id(reading.dev);
+        if (!dev_id.has_value())
+        {
+          return dev_id.error();
+        }
+        if (!insert_stmt.bind(1, dev_id.value()) || !insert_stmt.bind(2, type_name)
+            || !insert_stmt.bind(3, time_to_epoch(reading.reading.time))
+            || !insert_stmt.bind(4, reading.reading.value))
+        {
+          insert_stmt.reset();
+          return "Could not bind reading data to prepared statement!";
+        }
+        const int rc = sqlite3_step(insert_stmt.ptr());
+        insert_stmt.reset();
+        if (rc != SQLITE_DONE)
+        {
+          return "Could not insert new device reading into database!";
+        }
+      }
+
+      return std::nullopt;
+    }
+
+    /** \brief Finds a device in the database or creates it, if it is missing.
+     *
+     * \param dev  the device to find or to create
+     * \return Returns the id of the device used in the database in case of
+     *         success. Returns an error message, if an error occurred.
+     */
+    nonstd::expected<int64_t, std::string> find_or_create_device(const device& dev);
+
+    std::string file; /**< name of the database file */
+    sqlite::database db; /**< the database connection */
+    // Note: Statements have to be declared after the database, because they
+    // have to be finalized before the database connection is closed.
+    sqlite::statement insert_stmt; /**< prepared statement to insert readings */
+    std::vector<int64_t> device_ids; /**< cache of known database ids, indexed by device handle; zero means not known yet */
+};
+
+} // namespace
+
+#endif // SQLite feature guard
+
+#endif // THERMOS_STORAGE_SESSION_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,55 +19,267 @@
 */
 
 #include "utilities.hpp"
+#include <algorithm>
+#include <array>
 #include <ctime>
+#include <limits>
 
 namespace thermos::storage
 {
 
-nonstd::expected<std::string, std::string> time_to_string(const thermal::reading::reading_time_t& date_time)
+namespace
+{
+
+/** \brief Parses a fixed number of decimal digits.
+ *
+ * \param value   the string containing the digits
+ * \param pos     position of the first digit
+ * \param count   number of digits to parse
+ * \param result  variable that receives the parsed number
+ * \return Returns true, if all characters were digits.
+ *         Returns false otherwise.
+ */
+bool parse_digits(const std::string_view value, const std::size_t pos, const std::size_t count, int& result)
+{
+  int number = 0;
+  for (std::size_t i = pos; i < pos + count; ++i)
+  {
+    const char c = value[i];
+    if (c < '0' || c > '9')
+    {
+      return false;
+    }
+    number = number * 10 + (c - '0');
+  }
+  result = number;
+  return true;
+}
+
+/** \brief Gets the number of days since 1970-01-01 for a date in the
+ *         proleptic Gregorian calendar.
+ *
+ * \param year   the year
+ * \param month  the month [1;12]
+ * \param day    the day of the month [1;31]
+ * \return Returns the number of days since 1970-01-01. Days after the end of
+ *         the month are counted into the next month, just like mktime() does.
+ */
+constexpr int64_t days_from_civil(int64_t year, const int month, const int day)
+{
+  // See <https://howardhinnant.github.io/date_algorithms.html>.
+  year -= month <= 2;
+  const int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const int64_t year_of_era = year - era * 400;
+  const int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + day_of_era - 719468;
+}
+
+/** \brief Converts a time_t value to local time.
+ *
+ * \param tt   the time_t value
+ * \param tm   structure that receives the local time
+ * \return Returns an empty optional in case of success.
+ *         Returns an error message otherwise.
+ */
+std::optional<std::string> to_local_time(const std::time_t tt, struct tm& tm)
 {
-  const std::time_t tt = std::chrono::system_clock::to_time_t(date_time);
-  struct tm tm;
   #if !defined(_MSC_VER) && !defined(__MINGW32__) && !defined(__MINGW64__)
   // Note: localtime() is NOT thread-safe. Therefore we use localtime_r(), which
   // is thread-safe but may not be available on all platforms or compilers.
   struct tm* ptr = localtime_r(&tt, &tm);
   if (ptr == nullptr)
   {
-    return nonstd::make_unexpected("Date conversion with localtime_r() failed!");
+    return "Date conversion with localtime_r() failed!";
   }
   #else
   // MSVC does not have localtime_r, so we use localtime_s instead.
   const errno_t error = localtime_s(&tm, &tt);
   if (error != 0)
   {
-    return nonstd::make_unexpected("Date conversion with localtime_s() failed!");
+    return "Date conversion with localtime_s() failed!";
   }
   #endif
-  const int realYear = tm.tm_year + 1900;
-  const int realMonth = tm.tm_mon + 1;
-  return // zero-padding for year
-         std::string((realYear < 1000) + (realYear < 100) + (realYear < 10), '0')
-         // year itself
-         .append(std::to_string(realYear))
-         .append("-")
-         // month + padding
-         .append(realMonth < 10, '0').append(std::to_string(realMonth))
-         .append("-")
-         // day + padding
-         .append(tm.tm_mday < 10, '0').append(std::to_string(tm.tm_mday))
-         .append(" ")
-         // hour + padding
-         .append(tm.tm_hour < 10, '0').append(std::to_string(tm.tm_hour))
-         .append(":")
-         // minute + padding
-         .append(tm.tm_min < 10, '0').append(std::to_string(tm.tm_min))
-         .append(":")
-         // second
-         .append(tm.tm_sec < 10, '0').append(std::to_string(tm.tm_sec));
+  return std::nullopt;
+}
+
+/** \brief Gets the offset of local time to UTC at a given point in time.
+ *
+ * \param epoch  seconds since the Unix epoch
+ * \return Returns the offset in seconds, if it could be determined.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<int64_t> utc_offset(const int64_t epoch)
+{
+  struct tm tm;
+  if (to_local_time(static_cast<std::time_t>(epoch), tm).has_value())
+  {
+    return std::nullopt;
+  }
+  const int64_t local = days_from_civil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400
+                      + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+  return local - epoch;
+}
+
+/// Writes a zero-padded two digit number.
+void write_two_digits(char* dest, const int value)
+{
+  dest[0] = static_cast<char>('0' + value / 10);
+  dest[1] = static_cast<char>('0' + value % 10);
+}
+
+/** \brief Writes the date part "YYYY-MM-DD " of a formatted time point.
+ *
+ * \param dest   buffer of at least eleven characters
+ * \param tm     the local time
+ */
+void write_date(char* dest, const struct tm& tm)
+{
+  const int year = tm.tm_year + 1900;
+  write_two_digits(dest, year / 100);
+  write_two_digits(dest + 2, year % 100);
+  dest[4] = '-';
+  write_two_digits(dest + 5, tm.tm_mon + 1);
+  dest[7] = '-';
+  write_two_digits(dest + 8, tm.tm_mday);
+  dest[10] = ' ';
+}
+
+/** \brief Writes the time part "hh:mm:ss" of a formatted time point.
+ *
+ * \param dest             buffer of at least eight characters
+ * \param seconds_of_day   seconds since the start of the day
+ */
+void write_time(char* dest, const int seconds_of_day)
+{
+  write_two_digits(dest, seconds_of_day / 3600);
+  dest[2] = ':';
+  write_two_digits(dest + 3, (seconds_of_day / 60) % 60);
+  dest[5] = ':';
+  write_two_digits(dest + 6, seconds_of_day % 60);
+}
+
+/** \brief Converts local time to time_t via mktime().
+ *
+ * \return Returns the time_t value, or -1 if the conversion failed.
+ */
+std::time_t local_to_time_t(const int year, const int month, const int day, const int hour, const int minute, const int second)
+{
+  struct tm tm;
+  tm.tm_sec = second;
+  tm.tm_min = minute;
+  tm.tm_hour = hour;
+  tm.tm_mday = day;
+  tm.tm_mon = month - 1;
+  tm.tm_year = year - 1900;
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+/// Cached offset between local time and UTC for one local day.
+struct day_offset
+{
+  int64_t day = std::numeric_limits<int64_t>::min(); /**< days since 1970-01-01 */
+  bool constant = false; /**< whether the offset is the same for the whole day */
+  int64_t offset = 0; /**< offset of local time to UTC in seconds */
+};
+
+/** \brief Gets the offset between local time and UTC for a local day.
+ *
+ * mktime() has to determine the time zone rules and takes a global lock on
+ * many platforms, so the offset is only calculated once per day. Offsets of
+ * recently used days are kept in a small per-thread table.
+ * \remarks Changes to the time zone of the process while it is running are
+ *          not reflected by the cached values.
+ */
+const day_offset& offset_of_day(const int64_t day, const int year, const int month, const int dom)
+{
+  constexpr std::size_t table_size = 64;
+  thread_local std::array<day_offset, table_size> table;
+
+  auto& entry = table[static_cast<std::size_t>(day) % table_size];
+  if (entry.day == day)
+  {
+    return entry;
+  }
+
+  entry.day = day;
+  const std::time_t start = local_to_time_t(year, month, dom, 0, 0, 0);
+  const std::time_t end = local_to_time_t(year, month, dom + 1, 0, 0, 0);
+  // If the day does not have 24 hours, then a DST transition happens during
+  // that day and the offset depends on the time of the day.
+  entry.constant = (start != static_cast<std::time_t>(-1))
+      && (end != static_cast<std::time_t>(-1))
+      && (end - start == 86400);
+  entry.offset = day * 86400 - static_cast<int64_t>(start);
+  return entry;
+}
+
+} // anonymous namespace
+
+time_formatter::time_formatter()
+: valid_from(0),
+  valid_until(0),
+  date({})
+{
 }
 
-nonstd::expected<thermal::reading::reading_time_t, std::string> string_to_time(const std::string& value)
+std::optional<std::string> time_formatter::format(const thermal::reading::reading_time_t& date_time, buffer_t& buffer)
+{
+  const int64_t seconds = time_to_epoch(date_time);
+  if ((seconds >= valid_from) && (seconds < valid_until))
+  {
+    std::copy(date.begin(), date.end(), buffer.begin());
+    write_time(buffer.data() + date.size(), static_cast<int>(seconds - valid_from));
+    return std::nullopt;
+  }
+
+  struct tm tm;
+  const auto error = to_local_time(static_cast<std::time_t>(seconds), tm);
+  if (error.has_value())
+  {
+    return error;
+  }
+  if ((tm.tm_year + 1900 < 0) || (tm.tm_year + 1900 > 9999))
+  {
+    return "Year " + std::to_string(tm.tm_year + 1900) + " is out of the supported range.";
+  }
+  const int seconds_of_day = tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec;
+  write_date(date.data(), tm);
+  std::copy(date.begin(), date.end(), buffer.begin());
+  write_time(buffer.data() + date.size(), seconds_of_day);
+
+  // The day can only be cached, if the offset to UTC is the same for the
+  // whole day, i. e. there is no DST transition during that day.
+  const int64_t day_start = seconds - seconds_of_day;
+  const int64_t offset = days_from_civil(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday) * 86400
+                       + seconds_of_day - seconds;
+  if ((utc_offset(day_start) == offset) && (utc_offset(day_start + 86399) == offset))
+  {
+    valid_from = day_start;
+    valid_until = day_start + 86400;
+  }
+  else
+  {
+    valid_from = 0;
+    valid_until = 0;
+  }
+  return std::nullopt;
+}
+
+nonstd::expected<std::string, std::string> time_to_string(const thermal::reading::reading_time_t& date_time)
+{
+  thread_local time_formatter formatter;
+  time_formatter::buffer_t buffer;
+  const auto error = formatter.format(date_time, buffer);
+  if (error.has_value())
+  {
+    return nonstd::make_unexpected(error.value());
+  }
+  return std::string(buffer.data(), buffer.size());
+}
+
+nonstd::expected<thermal::reading::reading_time_t, std::string> string_to_time(const std::string_view value)
 {
   // Value is something like '2020-04-04 12:34:56', so length is 19 chars.
   if (value.size() != 19 || value[4] != '-' || value[7] != '-' || value[13] != ':' || value[16] != ':')
@@ -75,53 +287,63 @@ nonstd::expected<thermal::reading::reading_time_t, std::string> string_to_time(c
     return nonstd::make_unexpected("The given string is not a valid date/time, it must follow the pattern 'YYYY-MM-DD hh:mm:ss'.");
   }
 
-  std::size_t pos;
-  const int year = std::stoi(value, &pos);
-  if (pos != 4 || year < 0)
+  int year = 0;
+  if (!parse_digits(value, 0, 4, year))
   {
-    return nonstd::make_unexpected(value + " is not a valid date/time. Maybe '" + value.substr(0, pos) + "' is not a valid year.");
+    return nonstd::make_unexpected(std::string(value) + " is not a valid date/time. Maybe '" + std::string(value.substr(0, 4)) + "' is not a valid year.");
   }
-  const int month = std::stoi(value.substr(5, 2), &pos);
-  if (pos != 2 || month > 12 || month < 1)
+  int month = 0;
+  if (!parse_digits(value, 5, 2, month) || month > 12 || month < 1)
   {
-    return nonstd::make_unexpected(value + " is not a valid date/time. Maybe '" + value.substr(5, 2) + "' is not a valid month.");
+    return nonstd::make_unexpected(std::string(value) + " is not a valid date/time. Maybe '" + std::string(value.substr(5, 2)) + "' is not a valid month.");
   }
-  const int day = std::stoi(value.substr(8, 2), &pos);
-  if (pos != 2 || day < 1 || day > 31)
+  int day = 0;
+  if (!parse_digits(value, 8, 2, day) || day < 1 || day > 31)
   {
-    return nonstd::make_unexpected(value + " is not a valid date/time. Maybe '" + value.substr(8, 2) + "' is not a valid day.");
+    return nonstd::make_unexpected(std::string(value) + " is not a valid date/time. Maybe '" + std::string(value.substr(8, 2)) + "' is not a valid day.");
   }
 
-  const int hour = std::stoi(value.substr(11, 2), &pos);
-  if (pos != 2 || hour < 0 || hour > 23)
+  int hour = 0;
+  if (!parse_digits(value, 11, 2, hour) || hour > 23)
   {
-    return nonstd::make_unexpected(value + " is not a valid date/time. Maybe '" + value.substr(11, 2) + "' is not a valid hour.");
+    return nonstd::make_unexpected(std::string(value) + " is not a valid date/time. Maybe '" + std::string(value.substr(11, 2)) + "' is not a valid hour.");
   }
-  const int minute = std::stoi(value.substr(14, 2), &pos);
-  if (pos != 2 || minute < 0 || minute > 59)
+  int minute = 0;
+  if (!parse_digits(value, 14, 2, minute) || minute > 59)
   {
-    return nonstd::make_unexpected(value + " is not a valid date/time. Maybe '" + value.substr(14, 2) + "' is not a valid minute.");
+    return nonstd::make_unexpected(std::string(value) + " is not a valid date/time. Maybe '" + std::string(value.substr(14, 2)) + "' is not a valid minute.");
   }
-  const int second = std::stoi(value.substr(17, 2), &pos);
-  if (pos != 2 || second < 0 || second > 59)
+  int second = 0;
+  if (!parse_digits(value, 17, 2, second) || second > 59)
   {
-    return nonstd::make_unexpected(value + " is not a valid date/time. Maybe '" + value.substr(17, 2) + "' is not a valid second.");
+    return nonstd::make_unexpected(std::string(value) + " is not a valid date/time. Maybe '" + std::string(value.substr(17, 2)) + "' is not a valid second.");
   }
 
-  struct tm tm;
-  tm.tm_sec = second;
-  tm.tm_min = minute;
-  tm.tm_hour = hour;
-  tm.tm_mday = day;
-  tm.tm_mon = month - 1;
-  tm.tm_year = year - 1900;
-  tm.tm_isdst = -1;
-  const time_t tt = mktime(&tm);
-  if (tt == static_cast<time_t>(-1))
+  const int64_t days = days_from_civil(year, month, day);
+  const auto& offset = offset_of_day(days, year, month, day);
+  if (offset.constant)
+  {
+    const int64_t local_seconds = days * 86400 + hour * 3600 + minute * 60 + second;
+    return epoch_to_time(local_seconds - offset.offset);
+  }
+
+  // Let mktime() handle days with DST transitions.
+  const std::time_t tt = local_to_time_t(year, month, day, hour, minute, second);
+  if (tt == static_cast<std::time_t>(-1))
   {
-    return nonstd::make_unexpected("mktime() failed when converting " + value + " to time_t.");
+    return nonstd::make_unexpected("mktime() failed when converting " + std::string(value) + " to time_t.");
   }
   return std::chrono::system_clock::from_time_t(tt);
 }
 
+int64_t time_to_epoch(const thermal::reading::reading_time_t& date_time)
+{
+  return std::chrono::floor<std::chrono::seconds>(date_time.time_since_epoch()).count();
+}
+
+thermal::reading::reading_time_t epoch_to_time(const int64_t epoch)
+{
+  return thermal::reading::reading_time_t(std::chrono::seconds(epoch));
+}
+
 } // namespace
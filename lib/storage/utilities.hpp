@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the weather information collector.
-    Copyright (C) 2020, 2021  Dirk Stolle
+    Copyright (C) 2020, 2021, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,6 +21,10 @@
 #ifndef THERMOS_STORAGE_UTILITIES_HPP
 #define THERMOS_STORAGE_UTILITIES_HPP
 
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
 #include "../../third-party/nonstd/expected.hpp"
 #include "../thermal/reading.hpp"
 
@@ -37,13 +41,70 @@ namespace thermos::storage
 nonstd::expected<std::string, std::string> time_to_string(const thermal::reading::reading_time_t& date_time);
 
 
+/** \brief Formats time points as 'YYYY-MM-DD hh:mm:ss' in local time.
+ *
+ * The formatter remembers the local day of the last converted time point and
+ * the offset between local time and UTC on that day. Time points within the
+ * same day are formatted without calling localtime_r() or localtime_s(),
+ * which makes formatting many time points of a series of readings fast.
+ * Days with a DST transition are not cached, so the result is always the same
+ * as the result of time_to_string().
+ * \remarks Changes to the time zone of the process while the formatter is in
+ *          use are not reflected by the cached values.
+ */
+class time_formatter
+{
+  public:
+    /// length of a formatted time point
+    static constexpr std::size_t length = 19;
+
+    /// type of the buffer that receives the formatted time point
+    using buffer_t = std::array<char, length>;
+
+    time_formatter();
+
+    /** \brief Formats a time point.
+     *
+     * \param date_time  the time point to format
+     * \param buffer     buffer that receives the formatted time, e. g.
+     *                   "2020-05-25 13:37:00"; it is not NUL-terminated
+     * \return Returns an empty optional, if the time point was formatted.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> format(const thermal::reading::reading_time_t& date_time, buffer_t& buffer);
+  private:
+    int64_t valid_from; /**< first epoch second of the cached day */
+    int64_t valid_until; /**< first epoch second after the cached day */
+    std::array<char, 11> date; /**< formatted date of the cached day, e. g. "2020-05-25 " */
+};
+
+
 /** \brief Translates a date in the format 'YYYY-MM-DD HH:ii:ss' to a time point.
  *
- * \param sv  the string containing the date
+ * \param value  the string containing the date, interpreted as local time
  * \return Returns a time point equivalent to the date in the string.
  *         If transformation fails, then an error message is returned.
+ * \remarks The offset between local time and UTC is determined only once per
+ *          day and cached, so that most calls do not need mktime().
+ */
+nonstd::expected<thermal::reading::reading_time_t, std::string> string_to_time(const std::string_view value);
+
+
+/** \brief Translates a time point to seconds since the Unix epoch (UTC).
+ *
+ * \param date_time  the time point to transform
+ * \return Returns the number of seconds since 1970-01-01 00:00:00 UTC.
+ *         Fractions of a second are discarded.
+ */
+int64_t time_to_epoch(const thermal::reading::reading_time_t& date_time);
+
+
+/** \brief Translates seconds since the Unix epoch (UTC) to a time point.
+ *
+ * \param epoch  number of seconds since 1970-01-01 00:00:00 UTC
+ * \return Returns the equivalent time point.
  */
-nonstd::expected<thermal::reading::reading_time_t, std::string> string_to_time(const std::string& value);
+thermal::reading::reading_time_t epoch_to_time(const int64_t epoch);
 
 } // namespace
 
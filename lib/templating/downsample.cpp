@@ -0,0 +1,230 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "downsample.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace thermos
+{
+
+std::string to_string(const downsampling_method method)
+{
+  switch (method)
+  {
+    case downsampling_method::none:
+         return "none";
+    case downsampling_method::lttb:
+         return "lttb";
+    case downsampling_method::min_max:
+         return "minmax";
+    case downsampling_method::average:
+         return "average";
+    default:
+         throw std::invalid_argument("Invalid downsampling_method value in to_string!");
+  }
+}
+
+std::optional<downsampling_method> parse_downsampling_method(const std::string& name)
+{
+  for (const auto method: { downsampling_method::none, downsampling_method::lttb,
+                            downsampling_method::min_max, downsampling_method::average })
+  {
+    if (name == to_string(method))
+    {
+      return method;
+    }
+  }
+  return std::nullopt;
+}
+
+namespace
+{
+
+/** \brief Gets the start index of a bucket.
+ *
+ * \param offset    index of the first element that is split into buckets
+ * \param count     number of elements that are split into buckets
+ * \param buckets   total number of buckets
+ * \param bucket    zero-based index of the bucket
+ * \return Returns the index of the first element of the bucket. For
+ *         bucket == buckets, it returns the index after the last element.
+ */
+std::size_t bucket_start(const std::size_t offset, const std::size_t count,
+                         const std::size_t buckets, const std::size_t bucket)
+{
+  // Integer arithmetic keeps the last bound exact.
+  return offset + (bucket * count) / buckets;
+}
+
+/** \brief Implements Largest-Triangle-Three-Buckets (Sveinn Steinarsson, 2013).
+ *
+ * The first and the last reading are always kept. The readings in between are
+ * split into buckets, and from each bucket the reading is selected that forms
+ * the largest triangle with the reading selected from the previous bucket and
+ * the average of the next bucket.
+ */
+void lttb(const std::vector<int64_t>& times, const std::vector<int64_t>& values,
+          const std::size_t first, const std::size_t last, const std::size_t points,
+          std::vector<int64_t>& out_times, std::vector<int64_t>& out_values)
+{
+  const std::size_t buckets = points - 2;
+  const std::size_t inner = last - first - 2;
+  // Times are relative to the first reading, so that the areas do not lose
+  // precision due to the large absolute values.
+  const int64_t origin = times[first];
+  const auto x = [&times, origin](const std::size_t i) { return static_cast<double>(times[i] - origin); };
+  const auto y = [&values](const std::size_t i) { return static_cast<double>(values[i]); };
+
+  std::size_t selected = first;
+  out_times.push_back(times[selected]);
+  out_values.push_back(values[selected]);
+  for (std::size_t bucket = 0; bucket < buckets; ++bucket)
+  {
+    const std::size_t start = bucket_start(first + 1, inner, buckets, bucket);
+    const std::size_t end = bucket_start(first + 1, inner, buckets, bucket + 1);
+    // The next bucket of the last bucket is the last reading.
+    const std::size_t next_start = (bucket + 1 < buckets) ? end : last - 1;
+    const std::size_t next_end = (bucket + 1 < buckets) ? bucket_start(first + 1, inner, buckets, bucket + 2) : last;
+    double avg_x = 0.0;
+    double avg_y = 0.0;
+    for (std::size_t i = next_start; i < next_end; ++i)
+    {
+      avg_x += x(i);
+      avg_y += y(i);
+    }
+    avg_x /= static_cast<double>(next_end - next_start);
+    avg_y /= static_cast<double>(next_end - next_start);
+
+    const double sel_x = x(selected);
+    const double sel_y = y(selected);
+    double max_area = -1.0;
+    std::size_t candidate = start;
+    for (std::size_t i = start; i < end; ++i)
+    {
+      // twice the area of the triangle, which is enough for comparison
+      const double area = std::fabs((sel_x - avg_x) * (y(i) - sel_y) - (sel_x - x(i)) * (avg_y - sel_y));
+      if (area > max_area)
+      {
+        max_area = area;
+        candidate = i;
+      }
+    }
+    selected = candidate;
+    out_times.push_back(times[selected]);
+    out_values.push_back(values[selected]);
+  }
+  out_times.push_back(times[last - 1]);
+  out_values.push_back(values[last - 1]);
+}
+
+/** \brief Keeps the minimum and the maximum reading of each bucket, in the
+ * order in which they appear.
+ */
+void min_max(const std::vector<int64_t>& times, const std::vector<int64_t>& values,
+             const std::size_t first, const std::size_t last, const std::size_t points,
+             std::vector<int64_t>& out_times, std::vector<int64_t>& out_values)
+{
+  const std::size_t buckets = std::max<std::size_t>(points / 2, 1);
+  const std::size_t count = last - first;
+  for (std::size_t bucket = 0; bucket < buckets; ++bucket)
+  {
+    const auto begin = values.begin() + bucket_start(first, count, buckets, bucket);
+    const auto end = values.begin() + bucket_start(first, count, buckets, bucket + 1);
+    const auto [min, max] = std::minmax_element(begin, end);
+    const std::size_t lower = std::min(min, max) - values.begin();
+    const std::size_t upper = std::max(min, max) - values.begin();
+    out_times.push_back(times[lower]);
+    out_values.push_back(values[lower]);
+    if (upper != lower)
+    {
+      out_times.push_back(times[upper]);
+      out_values.push_back(values[upper]);
+    }
+  }
+}
+
+/** \brief Replaces each bucket by the average time and value of its readings.
+ */
+void average(const std::vector<int64_t>& times, const std::vector<int64_t>& values,
+             const std::size_t first, const std::size_t last, const std::size_t points,
+             std::vector<int64_t>& out_times, std::vector<int64_t>& out_values)
+{
+  const std::size_t buckets = std::max<std::size_t>(points, 1);
+  const std::size_t count = last - first;
+  for (std::size_t bucket = 0; bucket < buckets; ++bucket)
+  {
+    const std::size_t start = bucket_start(first, count, buckets, bucket);
+    const std::size_t end = bucket_start(first, count, buckets, bucket + 1);
+    // Times are summed up relative to the start of the bucket to avoid
+    // overflows for large buckets.
+    int64_t time_sum = 0;
+    int64_t value_sum = 0;
+    for (std::size_t i = start; i < end; ++i)
+    {
+      time_sum += times[i] - times[start];
+      value_sum += values[i];
+    }
+    const auto n = static_cast<int64_t>(end - start);
+    out_times.push_back(times[start] + time_sum / n);
+    out_values.push_back(std::llround(static_cast<double>(value_sum) / static_cast<double>(n)));
+  }
+}
+
+} // anonymous namespace
+
+void downsample(const std::vector<int64_t>& times, const std::vector<int64_t>& values,
+                const std::size_t first, const std::size_t last,
+                const downsampling& options,
+                std::vector<int64_t>& out_times, std::vector<int64_t>& out_values)
+{
+  out_times.clear();
+  out_values.clear();
+  // LTTB needs at least three points: first, last and one in between.
+  const std::size_t points = (options.method == downsampling_method::lttb)
+      ? std::max<std::size_t>(options.points, 3) : options.points;
+  if ((options.method == downsampling_method::none) || (last - first <= points))
+  {
+    out_times.assign(times.begin() + first, times.begin() + last);
+    out_values.assign(values.begin() + first, values.begin() + last);
+    return;
+  }
+
+  out_times.reserve(points);
+  out_values.reserve(points);
+  switch (options.method)
+  {
+    case downsampling_method::lttb:
+         lttb(times, values, first, last, points, out_times, out_values);
+         break;
+    case downsampling_method::min_max:
+         min_max(times, values, first, last, points, out_times, out_values);
+         break;
+    case downsampling_method::average:
+         average(times, values, first, last, points, out_times, out_values);
+         break;
+    case downsampling_method::none:
+         // already handled above
+         break;
+  }
+}
+
+} // namespace
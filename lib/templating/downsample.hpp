@@ -0,0 +1,106 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_TEMPLATING_DOWNSAMPLE_HPP
+#define THERMOS_TEMPLATING_DOWNSAMPLE_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../reading_batch.hpp"
+
+namespace thermos
+{
+
+enum class downsampling_method
+{
+  /// keep all readings
+  none,
+
+  /// Largest-Triangle-Three-Buckets, keeps the visual shape of the data
+  lttb,
+
+  /// minimum and maximum of each bucket, keeps all spikes
+  min_max,
+
+  /// average of each bucket, smooths the data
+  average
+};
+
+/** \brief Converts a downsampling_method to a string.
+ *
+ * \param method   the downsampling method
+ * \return Returns a string that identifies the method.
+ */
+std::string to_string(const downsampling_method method);
+
+/** \brief Parses a downsampling method from its name.
+ *
+ * \param name   name of the method, e.g. "lttb"
+ * \return Returns the method, if the name is known.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<downsampling_method> parse_downsampling_method(const std::string& name);
+
+/// settings for the reduction of the number of plotted readings
+struct downsampling
+{
+  downsampling_method method = downsampling_method::none; /**< method to use */
+  std::size_t points = 2000; /**< maximum number of points per trace */
+};
+
+/** \brief Reduces the number of readings in a range of columns.
+ *
+ * \param times       times of the readings, ordered ascending
+ * \param values      values of the readings
+ * \param first       index of the first reading of the range
+ * \param last        index after the last reading of the range
+ * \param options     method and maximum number of resulting points
+ * \param out_times   vector that receives the times of the result
+ * \param out_values  vector that receives the values of the result
+ * \remarks If the range does not contain more readings than the requested
+ *          number of points, all readings of the range are copied.
+ */
+void downsample(const std::vector<int64_t>& times, const std::vector<int64_t>& values,
+                const std::size_t first, const std::size_t last,
+                const downsampling& options,
+                std::vector<int64_t>& out_times, std::vector<int64_t>& out_values);
+
+/** \brief Reduces the number of readings of a single device in a batch.
+ *
+ * \param data      the batch containing the readings
+ * \param first     index of the first reading of the device
+ * \param last      index after the last reading of the device
+ * \param options   method and maximum number of resulting points
+ * \param result    batch that receives the result, previous content is replaced
+ */
+template<typename read_t>
+void downsample(const reading_batch<read_t>& data, const std::size_t first, const std::size_t last,
+                const downsampling& options, reading_batch<read_t>& result)
+{
+  result.clear();
+  downsample(data.times, data.values, first, last, options, result.times, result.values);
+  result.devices.assign(result.times.size(), (first < last) ? data.devices[first] : device_registry::no_device);
+}
+
+} // namespace
+
+#endif // THERMOS_TEMPLATING_DOWNSAMPLE_HPP
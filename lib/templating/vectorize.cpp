@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022, 2023  Dirk Stolle
+    Copyright (C) 2022, 2023, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,7 @@
 */
 
 #include "vectorize.hpp"
+#include <algorithm>
 #include <sstream>
 #include "../storage/utilities.hpp"
 
@@ -31,72 +32,112 @@ vectorized_data::vectorized_data()
 {
 }
 
-nonstd::expected<vectorized_data, std::string> vectorize(const std::vector<load::reading>& data)
+namespace
+{
+
+/** \brief Converts times and values to JSON arrays.
+ *
+ * \param count      number of elements
+ * \param time_at    function that returns the time of the element at an index
+ * \param value_at   function that returns the value of the element at an index
+ * \return Returns a structure containing JSON-ified data in case of success.
+ *         Returns an error message otherwise.
+ */
+template<typename time_fn, typename value_fn>
+nonstd::expected<vectorized_data, std::string> vectorize_impl(const std::size_t count, const time_fn& time_at, const value_fn& value_at)
 {
   vectorized_data result;
+  if (count == 0)
+  {
+    result.dates = result.values = "[]";
+    return result;
+  }
+
   std::ostringstream dates;
   dates << "[\"";
   std::ostringstream values;
   values << "[";
-  for (const load::reading& elem: data)
+  storage::time_formatter formatter;
+  storage::time_formatter::buffer_t time_buffer;
+  for (std::size_t i = 0; i < count; ++i)
   {
-    const auto maybe_string = storage::time_to_string(elem.time);
-    if (!maybe_string.has_value())
+    const auto error = formatter.format(time_at(i), time_buffer);
+    if (error.has_value())
     {
-      return nonstd::make_unexpected(maybe_string.error());
+      return nonstd::make_unexpected(error.value());
     }
-    dates << maybe_string.value() << "\",\"";
-    values << elem.percent() << ',';
-  }
-  if (!data.empty())
-  {
-    result.dates = dates.str();
-    const auto d_len = result.dates.length();
-    result.dates[d_len - 2] = ']';
-    result.dates.erase(d_len - 1, 1);
-    result.values = values.str();
-    result.values[result.values.length() - 1] = ']';
-  }
-  else
-  {
-    result.dates = result.values = "[]";
+    dates.write(time_buffer.data(), time_buffer.size());
+    dates << "\",\"";
+    values << value_at(i) << ',';
   }
+  result.dates = dates.str();
+  const auto d_len = result.dates.length();
+  result.dates[d_len - 2] = ']';
+  result.dates.erase(d_len - 1, 1);
+  result.values = values.str();
+  result.values[result.values.length() - 1] = ']';
 
   return result;
 }
 
-nonstd::expected<vectorized_data, std::string> vectorize(const std::vector<thermal::reading>& data)
+/** \brief Converts a range of the columns of a reading batch to JSON arrays.
+ *
+ * \param data      the batch
+ * \param first     index of the first reading in the range
+ * \param last      index after the last reading in the range
+ * \param convert   function that converts a raw value to the displayed value
+ * \return Returns a structure containing JSON-ified data in case of success.
+ *         Returns an error message otherwise.
+ */
+template<typename read_t, typename convert_fn>
+nonstd::expected<vectorized_data, std::string> vectorize_columns(const reading_batch<read_t>& data, const std::size_t first, const std::size_t last, const convert_fn& convert)
 {
-  vectorized_data result;
-  std::ostringstream dates;
-  dates << "[\"";
-  std::ostringstream values;
-  values << "[";
-  for (const thermal::reading& elem: data)
-  {
-    const auto maybe_string = storage::time_to_string(elem.time);
-    if (!maybe_string.has_value())
-    {
-      return nonstd::make_unexpected(maybe_string.error());
-    }
-    dates << maybe_string.value() << "\",\"";
-    values << elem.celsius() << ',';
-  }
-  if (!data.empty())
-  {
-    result.dates = dates.str();
-    const auto d_len = result.dates.length();
-    result.dates[d_len - 2] = ']';
-    result.dates.erase(d_len - 1, 1);
-    result.values = values.str();
-    result.values[result.values.length() - 1] = ']';
-  }
-  else
+  if ((first > last) || (last > data.size()))
   {
-    result.dates = result.values = "[]";
+    return nonstd::make_unexpected("Invalid range of readings.");
   }
+  // Values are converted in a separate pass over the contiguous value column.
+  std::vector<double> values(last - first);
+  std::transform(data.values.begin() + first, data.values.begin() + last, values.begin(), convert);
+  return vectorize_impl(values.size(),
+      [&data, first](const std::size_t i) { return storage::epoch_to_time(data.times[first + i]); },
+      [&values](const std::size_t i) { return values[i]; });
+}
 
-  return result;
+} // anonymous namespace
+
+nonstd::expected<vectorized_data, std::string> vectorize(const std::vector<load::reading>& data)
+{
+  return vectorize_impl(data.size(),
+      [&data](const std::size_t i) { return data[i].time; },
+      [&data](const std::size_t i) { return data[i].percent(); });
+}
+
+nonstd::expected<vectorized_data, std::string> vectorize(const std::vector<thermal::reading>& data)
+{
+  return vectorize_impl(data.size(),
+      [&data](const std::size_t i) { return data[i].time; },
+      [&data](const std::size_t i) { return data[i].celsius(); });
+}
+
+nonstd::expected<vectorized_data, std::string> vectorize(const load::reading_batch& data)
+{
+  return vectorize(data, 0, data.size());
+}
+
+nonstd::expected<vectorized_data, std::string> vectorize(const thermal::reading_batch& data)
+{
+  return vectorize(data, 0, data.size());
+}
+
+nonstd::expected<vectorized_data, std::string> vectorize(const load::reading_batch& data, const std::size_t first, const std::size_t last)
+{
+  return vectorize_columns(data, first, last, load::reading::to_percent);
+}
+
+nonstd::expected<vectorized_data, std::string> vectorize(const thermal::reading_batch& data, const std::size_t first, const std::size_t last)
+{
+  return vectorize_columns(data, first, last, thermal::reading::to_celsius);
 }
 
 } // namespace
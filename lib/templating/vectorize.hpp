@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -47,6 +47,26 @@ struct vectorized_data
 nonstd::expected<vectorized_data, std::string> vectorize(const std::vector<load::reading>& data);
 nonstd::expected<vectorized_data, std::string> vectorize(const std::vector<thermal::reading>& data);
 
+/** \brief Converts the readings of a batch to JSON arrays.
+ *
+ * \param data   the batch of readings to transform to JSON
+ * \return Returns a structure containing JSON-ified data in case of success.
+ *         Returns an error message otherwise.
+ */
+nonstd::expected<vectorized_data, std::string> vectorize(const load::reading_batch& data);
+nonstd::expected<vectorized_data, std::string> vectorize(const thermal::reading_batch& data);
+
+/** \brief Converts a range of the readings of a batch to JSON arrays.
+ *
+ * \param data    the batch of readings
+ * \param first   index of the first reading to transform
+ * \param last    index after the last reading to transform
+ * \return Returns a structure containing JSON-ified data in case of success.
+ *         Returns an error message otherwise.
+ */
+nonstd::expected<vectorized_data, std::string> vectorize(const load::reading_batch& data, const std::size_t first, const std::size_t last);
+nonstd::expected<vectorized_data, std::string> vectorize(const thermal::reading_batch& data, const std::size_t first, const std::size_t last);
+
 } // namespace
 
 #endif // THERMOS_TEMPLATING_VECTORIZE_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,6 +21,7 @@
 #ifndef THERMOS_READ_THERMAL_LINUX_HPP
 #define THERMOS_READ_THERMAL_LINUX_HPP
 
+#include <filesystem>
 #include <string>
 #include <vector>
 #include "../../third-party/nonstd/expected.hpp"
@@ -32,24 +33,33 @@ namespace thermos::linux_like::thermal
 
 /** \brief Reads all thermal devices.
  *
+ * \param root   the directory that contains the sys directory, usually "/";
+ *               other values are mostly useful for tests
  * \return Returns a vector containing the device readings, if successful.
  *         Returns an error message, if no readings were available.
+ * \remarks The devices are discovered on the first call only, and their files
+ *          are kept open for later calls. They are discovered again when one
+ *          of them cannot be read anymore, e. g. after a driver was unloaded.
  */
-nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> read_all();
+nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> read_all(const std::filesystem::path& root = "/");
 
 /** \brief Reads thermal devices from /sys/devices/virtual/thermal/.
  *
+ * \param root   the directory that contains the sys directory, usually "/"
  * \return Returns a vector containing the device readings.
  *         Returns an error message, if no readings were available.
+ * \remarks Unlike read_all(), this discovers the devices anew on every call.
  */
-nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> read_thermal();
+nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> read_thermal(const std::filesystem::path& root = "/");
 
 /** \brief Reads thermal devices from /sys/class/hwmon/.
  *
+ * \param root   the directory that contains the sys directory, usually "/"
  * \return Returns a vector containing the device readings.
  *         Returns an error message, if no readings were available.
+ * \remarks Unlike read_all(), this discovers the devices anew on every call.
  */
-nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> read_hwmon();
+nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> read_hwmon(const std::filesystem::path& root = "/");
 
 } // namespace
 #endif // Linux
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -214,7 +214,7 @@ nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> rea
     }
 
     thermos::thermal::device_reading d_reading;
-    d_reading.dev.name = better_narrowing(property.bstrVal);
+    const std::string name = better_narrowing(property.bstrVal);
     VariantClear(&property);
 
     hr = pObject->Get(
@@ -239,7 +239,7 @@ nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> rea
     d_reading.reading.value = static_cast<int64_t>(property.lVal) * 100 - 273200;
     VariantClear(&property);
     pObject->Release();
-    d_reading.dev.origin = std::string("ROOT\\WMI:MSAcpi_ThermalZoneTemperature:").append(d_reading.dev.name);
+    d_reading.dev = device_registry::intern(device(name, std::string("ROOT\\WMI:MSAcpi_ThermalZoneTemperature:").append(name)));
     d_reading.reading.time = std::chrono::system_clock::now();
     result.emplace_back(d_reading);
   }
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -31,8 +31,7 @@ reading::reading()
 
 double reading::celsius() const
 {
-  // Rounded to 1/100th degree Celsius.
-  return std::round(static_cast<double>(value) / 10.0) / 100.0;
+  return to_celsius(value);
 }
 
 double reading::fahrenheit() const
@@ -43,9 +42,4 @@ double reading::fahrenheit() const
   return std::round(f * 100.0) / 100.0;
 }
 
-reading_type reading::type() const
-{
-  return reading_type::temperature;
-}
-
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,8 +21,11 @@
 #ifndef THERMOS_THERMAL_READING_HPP
 #define THERMOS_THERMAL_READING_HPP
 
+#include <cmath>
+#include <type_traits>
 #include "../device_reading.hpp"
 #include "../reading_base.hpp"
+#include "../reading_batch.hpp"
 
 namespace thermos::thermal
 {
@@ -37,6 +40,18 @@ struct reading: public thermos::reading_base
    */
   double celsius() const;
 
+  /** \brief Converts a temperature value to degrees Celsius, possibly rounded.
+   *
+   * \param millicelsius   temperature in thousandths of a degree Celsius, as
+   *                       stored in value
+   * \return Returns the temperature in ° C.
+   */
+  static double to_celsius(const int64_t millicelsius)
+  {
+    // Rounded to 1/100th degree Celsius.
+    return std::round(static_cast<double>(millicelsius) / 10.0) / 100.0;
+  }
+
   /** \brief Gets the temperature in degrees Fahrenheit, possibly rounded.
    *
    * \return Returns the temperature in ° F.
@@ -47,10 +62,19 @@ struct reading: public thermos::reading_base
    *
    * \return Returns the type of the reading.
    */
-  virtual reading_type type() const;
+  static constexpr reading_type type()
+  {
+    return reading_type::temperature;
+  }
 };
 
+static_assert(std::is_trivially_copyable<reading>::value,
+              "Readings must be trivially copyable.");
+static_assert(sizeof(reading) == sizeof(int64_t) + sizeof(reading::reading_time_t),
+              "Readings must not contain anything but value and time.");
+
 using device_reading = thermos::device_reading<reading>;
+using reading_batch = thermos::reading_batch<reading>;
 
 } // namespace
 
@@ -0,0 +1,323 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "sensors_linux.hpp"
+#if defined(__linux__) || defined(linux)
+#include <algorithm>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace thermos::linux_like::thermal
+{
+
+namespace
+{
+
+nonstd::expected<std::string, std::string> first_line(const std::filesystem::path& path)
+{
+  std::ifstream stream(path);
+  if (!stream.good())
+    return nonstd::make_unexpected("Cannot open file " + path.string() + ".");
+
+  std::string line;
+  if (!std::getline(stream, line))
+    return nonstd::make_unexpected("Cannot read from file " + path.string() + ".");
+
+  return line;
+}
+
+} // anonymous namespace
+
+std::optional<std::string_view> match_temperature_label(const std::string_view file_name)
+{
+  // Matches "temp", at least one digit and "_label", i. e. what the regular
+  // expression "temp([0-9]+)_label" matches, but without any allocation.
+  constexpr std::string_view head = "temp";
+  constexpr std::string_view tail = "_label";
+  if ((file_name.size() <= head.size() + tail.size())
+      || (file_name.substr(0, head.size()) != head)
+      || (file_name.substr(file_name.size() - tail.size()) != tail))
+  {
+    return std::nullopt;
+  }
+  const auto prefix_length = file_name.size() - tail.size();
+  for (auto pos = head.size(); pos < prefix_length; ++pos)
+  {
+    if ((file_name[pos] < '0') || (file_name[pos] > '9'))
+    {
+      return std::nullopt;
+    }
+  }
+  return file_name.substr(0, prefix_length);
+}
+
+std::optional<int64_t> parse_sensor_value(const std::string_view text)
+{
+  auto end = text.size();
+  if ((end > 0) && (text[end - 1] == '\n'))
+  {
+    --end;
+  }
+  std::size_t pos = 0;
+  const bool negative = (end > 0) && (text[0] == '-');
+  if (negative)
+  {
+    ++pos;
+  }
+  // Up to 18 digits always fit into int64_t, and no sensor needs more.
+  if ((pos == end) || (end - pos > 18))
+  {
+    return std::nullopt;
+  }
+
+  int64_t value = 0;
+  for (; pos < end; ++pos)
+  {
+    const char c = text[pos];
+    if ((c < '0') || (c > '9'))
+    {
+      return std::nullopt;
+    }
+    value = value * 10 + (c - '0');
+  }
+  return negative ? -value : value;
+}
+
+sensor::sensor(const device_handle handle, const int descriptor)
+: dev(handle),
+  fd(descriptor)
+{
+}
+
+nonstd::expected<sensor, std::string> sensor::open(const device_handle handle, const std::filesystem::path& path)
+{
+  const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (descriptor < 0)
+    return nonstd::make_unexpected("Cannot open file " + path.string() + ".");
+
+  return sensor(handle, descriptor);
+}
+
+sensor::sensor(sensor&& other) noexcept
+: dev(other.dev),
+  fd(other.fd)
+{
+  other.fd = -1;
+}
+
+sensor& sensor::operator=(sensor&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (fd >= 0)
+    {
+      close(fd);
+    }
+    dev = other.dev;
+    fd = other.fd;
+    other.fd = -1;
+  }
+  return *this;
+}
+
+sensor::~sensor()
+{
+  if (fd >= 0)
+  {
+    close(fd);
+  }
+}
+
+nonstd::expected<int64_t, std::string> sensor::read() const
+{
+  // sysfs generates the content anew when the file is read from offset zero,
+  // so there is no need to seek or to reopen the file.
+  char buffer[32];
+  const ssize_t count = pread(fd, buffer, sizeof(buffer), 0);
+  if (count < 0)
+    return nonstd::make_unexpected("Cannot read from file " + device_registry::get(dev).origin + ".");
+
+  const auto value = parse_sensor_value(std::string_view(buffer, static_cast<std::size_t>(count)));
+  if (!value.has_value())
+    return nonstd::make_unexpected("File " + device_registry::get(dev).origin + " did not contain an integer value.");
+
+  return value.value();
+}
+
+device_handle sensor::device() const
+{
+  return dev;
+}
+
+nonstd::expected<sensor_set, std::string> sensor_set::discover(const std::filesystem::path& root)
+{
+  sensor_set result;
+  auto error = result.add_thermal(root / "sys" / "devices" / "virtual" / "thermal");
+  if (error.has_value())
+    return nonstd::make_unexpected(error.value());
+  error = result.add_hwmon(root / "sys" / "class" / "hwmon");
+  if (error.has_value())
+    return nonstd::make_unexpected(error.value());
+
+  return result;
+}
+
+std::optional<std::string> sensor_set::add_thermal(const std::filesystem::path& directory)
+{
+  std::error_code error;
+  const auto iterator = std::filesystem::directory_iterator(directory, error);
+  if (error)
+    return "Cannot iterate over directory " + directory.native() + ".";
+
+  for (const auto& entry: iterator)
+  {
+    if (!entry.is_directory(error) || error)
+    {
+      continue;
+    }
+
+    // Zones without name or temperature, or with a temperature that cannot
+    // be read right now, e. g. of a switched off device, are skipped.
+    const auto maybe_name = first_line(entry.path() / "type");
+    if (!maybe_name.has_value())
+    {
+      continue;
+    }
+    const std::filesystem::path temperature (entry.path() / "temp");
+    const auto dev = device_registry::intern(device(maybe_name.value(), temperature.native()));
+    auto zone = sensor::open(dev, temperature);
+    if (!zone.has_value() || !zone.value().read().has_value())
+    {
+      continue;
+    }
+    sensors.emplace_back(std::move(zone.value()));
+  }
+
+  return std::nullopt;
+}
+
+std::optional<std::string> sensor_set::add_hwmon(const std::filesystem::path& directory)
+{
+  std::error_code error;
+  const auto iterator = std::filesystem::directory_iterator(directory, error);
+  if (error)
+    return "Cannot iterate over directory " + directory.string() + ".";
+
+  for (const auto& entry: iterator)
+  {
+    if (entry.is_directory(error) && !error)
+    {
+      auto failure = add_hwmon_device(entry.path() / "device");
+      if (failure.has_value())
+        return failure;
+      // Some kernel versions have the tempN_label and tempN_input files
+      // directly in /sys/class/hwmon/hwmonN instead of the sub directory
+      // /sys/class/hwmon/hwmonN/device.
+      failure = add_hwmon_device(entry.path());
+      if (failure.has_value())
+        return failure;
+    }
+  }
+
+  return std::nullopt;
+}
+
+std::optional<std::string> sensor_set::add_hwmon_device(const std::filesystem::path& directory)
+{
+  std::error_code error;
+  const auto iterator = std::filesystem::directory_iterator(directory, error);
+  if (error)
+    return "Cannot iterate over directory " + directory.native() + ".";
+
+  // Hardware monitors have dozens of files, e. g. fanN_input or inN_min.
+  // Collecting the names once allows to check for the input files without
+  // asking the file system for each of them.
+  std::vector<std::string> names;
+  for (const auto& entry: iterator)
+  {
+    if (entry.is_regular_file(error) && !error)
+    {
+      names.emplace_back(entry.path().filename().native());
+    }
+  }
+  std::sort(names.begin(), names.end());
+
+  std::string input_name;
+  for (const auto& fn: names)
+  {
+    // Only matching names are allowed, e. g. "temp0_label".
+    const auto prefix = match_temperature_label(fn);
+    if (!prefix.has_value())
+    {
+      continue;
+    }
+    // Check whether related input file exists, e. g. "temp0_input".
+    input_name.assign(prefix.value()).append("_input");
+    if (!std::binary_search(names.begin(), names.end(), input_name))
+    {
+      continue;
+    }
+
+    const auto maybe_name = first_line(directory / fn);
+    if (!maybe_name.has_value())
+      return maybe_name.error();
+    const auto path_input = directory / input_name;
+    const auto dev = device_registry::intern(device(maybe_name.value(), path_input.native()));
+    auto input = sensor::open(dev, path_input);
+    if (!input.has_value())
+      return input.error();
+    sensors.emplace_back(std::move(input.value()));
+  }
+
+  return std::nullopt;
+}
+
+nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> sensor_set::read() const
+{
+  // All sensors are read at virtually the same time, so one time stamp is
+  // enough for all of them.
+  const auto now = std::chrono::system_clock::now();
+  std::vector<thermos::thermal::device_reading> readings;
+  readings.reserve(sensors.size());
+  for (const auto& item: sensors)
+  {
+    const auto value = item.read();
+    if (!value.has_value())
+      return nonstd::make_unexpected(value.error());
+
+    thermos::thermal::device_reading reading;
+    reading.dev = item.device();
+    reading.reading.value = value.value();
+    reading.reading.time = now;
+    readings.emplace_back(reading);
+  }
+
+  return readings;
+}
+
+std::size_t sensor_set::size() const
+{
+  return sensors.size();
+}
+
+} // namespace
+
+#endif // Linux
@@ -0,0 +1,158 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_THERMAL_SENSORS_LINUX_HPP
+#define THERMOS_THERMAL_SENSORS_LINUX_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../third-party/nonstd/expected.hpp"
+#include "reading.hpp"
+
+#if defined(__linux__) || defined(linux)
+namespace thermos::linux_like::thermal
+{
+
+/** \brief Temperature sensor whose input file is kept open between readings.
+ *
+ * Every reading re-reads the file from the start via pread(), so taking a
+ * reading costs a single system call.
+ */
+class sensor
+{
+  public:
+    /** \brief Opens the input file of a sensor.
+     *
+     * \param handle   handle of the device the sensor belongs to
+     * \param path     path of the file that contains the temperature
+     * \return Returns the sensor in case of success.
+     *         Returns an error message, if the file could not be opened.
+     */
+    static nonstd::expected<sensor, std::string> open(const device_handle handle, const std::filesystem::path& path);
+
+    sensor(const sensor& other) = delete;
+    sensor& operator=(const sensor& other) = delete;
+    sensor(sensor&& other) noexcept;
+    sensor& operator=(sensor&& other) noexcept;
+    ~sensor();
+
+    /** \brief Reads the current temperature.
+     *
+     * \return Returns the temperature in millidegrees Celsius.
+     *         Returns an error message, if the file could not be read.
+     */
+    nonstd::expected<int64_t, std::string> read() const;
+
+    /** \brief Gets the device the sensor belongs to.
+     *
+     * \return Returns the handle of the device.
+     */
+    device_handle device() const;
+  private:
+    sensor(const device_handle handle, const int descriptor);
+
+    device_handle dev; /**< device of the sensor */
+    int fd; /**< file descriptor of the input file, or -1 */
+}; // class
+
+/** \brief Set of sensors that have been discovered once and are read
+ *         repeatedly without looking at the directory structure again.
+ */
+class sensor_set
+{
+  public:
+    /** \brief Discovers all sensors in the usual locations, i. e. thermal
+     *         zones in /sys/devices/virtual/thermal and hardware monitors in
+     *         /sys/class/hwmon.
+     *
+     * \param root   the directory that contains the sys directory, usually "/"
+     * \return Returns the sensors in case of success.
+     *         Returns an error message, if a directory could not be read.
+     */
+    static nonstd::expected<sensor_set, std::string> discover(const std::filesystem::path& root = "/");
+
+    /** \brief Adds all thermal zones of a directory, e. g.
+     *         /sys/devices/virtual/thermal. Zones that cannot be read are
+     *         skipped.
+     *
+     * \param directory   the directory that contains the thermal zones
+     * \return Returns an empty optional in case of success.
+     *         Returns an error message, if the directory could not be read.
+     */
+    std::optional<std::string> add_thermal(const std::filesystem::path& directory);
+
+    /** \brief Adds all temperature sensors of the hardware monitors in a
+     *         directory, e. g. /sys/class/hwmon.
+     *
+     * \param directory   the directory that contains the hardware monitors
+     * \return Returns an empty optional in case of success.
+     *         Returns an error message, if a directory or file could not be read.
+     */
+    std::optional<std::string> add_hwmon(const std::filesystem::path& directory);
+
+    /** \brief Reads all sensors of the set.
+     *
+     * \return Returns a vector containing the device readings, if successful.
+     *         Returns an error message, if one of the sensors could not be read.
+     */
+    nonstd::expected<std::vector<thermos::thermal::device_reading>, std::string> read() const;
+
+    /** \brief Gets the number of sensors in the set.
+     *
+     * \return Returns the number of sensors.
+     */
+    std::size_t size() const;
+  private:
+    /** \brief Adds the sensors of a single hardware monitor directory.
+     *
+     * \param directory   the directory with tempN_label and tempN_input files
+     * \return Returns an empty optional in case of success.
+     *         Returns an error message, if a directory or file could not be read.
+     */
+    std::optional<std::string> add_hwmon_device(const std::filesystem::path& directory);
+
+    std::vector<sensor> sensors; /**< the sensors */
+}; // class
+
+/** \brief Checks whether a file name is the name of a temperature label
+ *         of a hardware monitor, e. g. "temp1_label".
+ *
+ * \param file_name   the file name without directory
+ * \return Returns the part before "_label", e. g. "temp1", if the name matches.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<std::string_view> match_temperature_label(const std::string_view file_name);
+
+/** \brief Parses the content of a sysfs temperature file.
+ *
+ * \param text   the content, an integer that may be followed by a line break
+ * \return Returns the value, if the text is a valid integer.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<int64_t> parse_sensor_value(const std::string_view text);
+
+} // namespace
+#endif // Linux
+
+#endif // THERMOS_THERMAL_SENSORS_LINUX_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022, 2025  Dirk Stolle
+    Copyright (C) 2022, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,71 +21,199 @@
 #include "db2csv.hpp"
 #include <filesystem>
 #include <iostream>
+#include <optional>
+#include <unordered_map>
 #include "../ReturnCodes.hpp"
 #include "../../lib/load/reading.hpp"
 #include "../../lib/thermal/reading.hpp"
-#include "../../lib/storage/csv.hpp"
+#include "../../lib/storage/buffered_writer.hpp"
 #include "../../lib/storage/db.hpp"
 
 namespace thermos
 {
 
-int db2csv(const std::string& db_path)
+namespace
 {
-  std::error_code error;
-  if (!std::filesystem::exists(db_path, error) || error)
-  {
-    std::cerr << "Error: File " << db_path << " does not exist.\n";
-    return thermos::rcInputOutputFailure;
-  }
-
-  storage::db db;
-  storage::csv csv;
 
-  std::string destination;
-
-  // thermal data
-  {
-    std::vector<thermal::device_reading> data;
-    auto opt_error = db.load(data, db_path);
-    if (opt_error.has_value())
+/** \brief Counts exported rows and invokes the progress callback from time
+ *         to time.
+ */
+class export_progress
+{
+  public:
+    /** \brief Constructor.
+     *
+     * \param callback   the callback to invoke, may be empty
+     */
+    explicit export_progress(const progress_callback& callback)
+    : rows(0),
+      report(callback),
+      start(std::chrono::steady_clock::now()),
+      next_report(start + std::chrono::seconds(1))
     {
-      std::cerr << "Could not load thermal sensor data from database "
-                << db_path << "!\nError: " << opt_error.value() << "\n";
-      return thermos::rcInputOutputFailure;
     }
 
-    destination = csv_name(db_path);
-    opt_error = csv.save(data, destination);
-    if (opt_error.has_value())
+    /** \brief Counts one exported row.
+     */
+    void count()
     {
-      std::cerr << "Could not write thermal sensor data to file "
-                << destination << "!\nError: " << opt_error.value() << "\n";
-      return thermos::rcInputOutputFailure;
+      ++rows;
+      // Checking the clock for every row would be noticeable, so it is only
+      // done every few thousand rows.
+      if ((rows % 16384) == 0 && report)
+      {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= next_report)
+        {
+          report(rows, now - start);
+          next_report = now + std::chrono::seconds(1);
+        }
+      }
     }
-  }
 
-  // CPU load data
+    uint64_t rows; /**< number of rows exported so far */
+  private:
+    const progress_callback& report; /**< callback for progress reports */
+    std::chrono::steady_clock::time_point start; /**< start of the export */
+    std::chrono::steady_clock::time_point next_report; /**< time of next report */
+};
+
+/** \brief Streams all readings of one type from the database to the writer.
+ *
+ * \param db          the database storage
+ * \param db_path     path to the database file
+ * \param writer      the writer for the CSV file
+ * \param progress    progress counter
+ * \return Returns an empty optional, if the readings were exported.
+ *         Returns an error message otherwise.
+ */
+template<typename read_t>
+std::optional<std::string> export_readings(storage::db& db, const std::string& db_path, storage::buffered_writer& writer, export_progress& progress)
+{
+  const char separator = ';';
+  const std::string type = to_string(read_t::type());
+
+  // The first part of each line only depends on the device, so it is put
+  // together once per device instead of once per row.
+  std::unordered_map<int64_t, std::string> prefixes;
+  const auto on_device = [&](const int64_t device_id, const device& dev)
   {
-    std::vector<load::device_reading> data;
-    auto opt_error = db.load(data, db_path);
-    if (opt_error.has_value())
+    prefixes[device_id] = dev.name + separator + dev.origin + separator + type + separator;
+    return true;
+  };
+
+  storage::time_formatter formatter;
+  storage::time_formatter::buffer_t time_buffer;
+  std::optional<std::string> error;
+  int64_t last_device_id = -1;
+  std::string_view prefix;
+  const auto on_reading = [&](const int64_t device_id, const read_t& reading)
+  {
+    if (device_id != last_device_id)
     {
-      std::cerr << "Could not load CPU load data from database "
-                << db_path << "!\nError: " << opt_error.value() << "\n";
-      return thermos::rcInputOutputFailure;
+      prefix = prefixes[device_id];
+      last_device_id = device_id;
     }
-
-    opt_error = csv.save(data, destination);
-    if (opt_error.has_value())
+    error = formatter.format(reading.time, time_buffer);
+    if (error.has_value())
     {
-      std::cerr << "Could not write CPU load data to file "
-                << destination << "!\nError: " << opt_error.value() << "\n";
-      return thermos::rcInputOutputFailure;
+      return false;
     }
+    writer.write(prefix);
+    writer.write(reading.value);
+    writer.write(separator);
+    writer.write(std::string_view(time_buffer.data(), time_buffer.size()));
+    writer.write('\n');
+    progress.count();
+    return true;
+  };
+
+  const auto db_error = db.load(db_path, on_device, storage::reading_visitor<read_t>(on_reading));
+  if (db_error.has_value())
+  {
+    return db_error;
+  }
+  return error;
+}
+
+} // anonymous namespace
+
+nonstd::expected<uint64_t, std::string> export_csv(const std::string& db_path, const std::string& csv_path, const progress_callback& progress, const sqlite::options& connection)
+{
+  auto maybe_writer = storage::buffered_writer::open(csv_path);
+  if (!maybe_writer.has_value())
+  {
+    return nonstd::make_unexpected(maybe_writer.error());
+  }
+  auto& writer = maybe_writer.value();
+
+  storage::db db(connection);
+  export_progress counter(progress);
+
+  auto opt_error = export_readings<thermal::reading>(db, db_path, writer, counter);
+  if (opt_error.has_value())
+  {
+    return nonstd::make_unexpected("Could not export thermal sensor data. " + opt_error.value());
+  }
+
+  opt_error = export_readings<load::reading>(db, db_path, writer, counter);
+  if (opt_error.has_value())
+  {
+    return nonstd::make_unexpected("Could not export CPU load data. " + opt_error.value());
+  }
+
+  opt_error = writer.flush();
+  if (opt_error.has_value())
+  {
+    return nonstd::make_unexpected(opt_error.value());
+  }
+
+  return counter.rows;
+}
+
+int db2csv(const std::string& db_path, const sqlite::options& connection)
+{
+  std::error_code error;
+  if (!std::filesystem::exists(db_path, error) || error)
+  {
+    std::cerr << "Error: File " << db_path << " does not exist.\n";
+    return thermos::rcInputOutputFailure;
+  }
+
+  const auto rows_per_second = [](const uint64_t rows, const std::chrono::steady_clock::duration elapsed)
+  {
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    return seconds > 0.0 ? static_cast<uint64_t>(static_cast<double>(rows) / seconds) : rows;
+  };
+
+  bool progress_shown = false;
+  const progress_callback show_progress = [&](const uint64_t rows, const std::chrono::steady_clock::duration elapsed)
+  {
+    std::cout << "\r" << rows << " rows written (" << rows_per_second(rows, elapsed)
+              << " rows/s)" << std::flush;
+    progress_shown = true;
+  };
+
+  const std::string destination = csv_name(db_path);
+  const auto start = std::chrono::steady_clock::now();
+  const auto rows = export_csv(db_path, destination, show_progress, connection);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  if (progress_shown)
+  {
+    std::cout << "\n";
+  }
+  if (!rows.has_value())
+  {
+    std::cerr << "Could not write data from database " << db_path
+              << " to file " << destination << "!\nError: " << rows.error()
+              << "\n";
+    return thermos::rcInputOutputFailure;
   }
 
-  std::cout << "Data from " << db_path << " was written to " << destination
+  std::cout << rows.value() << " rows written in "
+            << std::chrono::duration<double>(elapsed).count() << " seconds ("
+            << rows_per_second(rows.value(), elapsed) << " rows/s).\n"
+            << "Data from " << db_path << " was written to " << destination
             << ".\n";
   return 0;
 }
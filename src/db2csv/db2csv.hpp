@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,18 +21,44 @@
 #ifndef THERMOS_DB2CSV_HPP
 #define THERMOS_DB2CSV_HPP
 
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include "../../third-party/nonstd/expected.hpp"
+#include "../../lib/sqlite/options.hpp"
 
 namespace thermos
 {
 
 /** \brief Writes data from an SQLite 3 file to a CSV file.
  *
- * \param db_path   path to the database file
+ * \param db_path      path to the database file
+ * \param connection   options for the database connection
  * \return Returns zero, if operation was successful.
  *         Returns non-zero exit code, if an error occurred.
  */
-int db2csv(const std::string& db_path);
+int db2csv(const std::string& db_path, const sqlite::options& connection = sqlite::options());
+
+/** \brief Callback that gets the number of rows exported so far and the
+ *         time that has passed since the export started.
+ */
+using progress_callback = std::function<void(const uint64_t rows, const std::chrono::steady_clock::duration elapsed)>;
+
+/** \brief Streams all readings from an SQLite 3 file to a CSV file.
+ *
+ * Rows are written as they come from the database, so memory usage does not
+ * grow with the size of the database.
+ *
+ * \param db_path    path to the database file
+ * \param csv_path   path of the CSV file, data is appended to existing files
+ * \param progress   callback that is invoked about once per second during the
+ *                   export, may be empty
+ * \param connection options for the database connection
+ * \return Returns the number of exported rows, if the export was successful.
+ *         Returns an error message otherwise.
+ */
+nonstd::expected<uint64_t, std::string> export_csv(const std::string& db_path, const std::string& csv_path, const progress_callback& progress, const sqlite::options& connection = sqlite::options());
 
 /** \brief Generates a file name for the CSV file.
  *
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022, 2024, 2025  Dirk Stolle
+    Copyright (C) 2022, 2024, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,7 @@
 */
 
 #include <iostream>
+#include <optional>
 #include <sqlite3.h>
 #include "../util/GitInfos.hpp"
 #include "../ReturnCodes.hpp"
@@ -47,12 +48,32 @@ void showHelp()
             << "options:\n"
             << "  -? | --help            - Shows this help message.\n"
             << "  -v | --version         - Shows version information.\n"
-            << "  -f FILE | --file FILE  - Sets the file name of the SQLite 3 database to read.\n";
+            << "  -f FILE | --file FILE  - Sets the file name of the SQLite 3 database to read.\n"
+            << "  -s SPEC | --sqlite SPEC\n"
+            << "                         - Sets options of the SQLite 3 database connection.\n"
+            << "                           SPEC is a comma-separated list of entries like\n"
+            << "                           'journal_mode=wal'. Allowed entries are:\n"
+            << "                             journal_mode=delete|truncate|persist|wal\n"
+            << "                             synchronous=off|normal|full|extra\n"
+            << "                             mmap_size=BYTES\n"
+            << "                             cache_size=KIB\n"
+            << "                             busy_timeout=MILLISECONDS\n"
+            << "                             read_only=true|false\n"
+            << "                             immutable=true|false\n"
+            << "                           Entries that are not given use the defaults\n"
+            << "                           mmap_size=268435456, busy_timeout=5000 and\n"
+            << "                           read_only=true. The database is never changed, so it\n"
+            << "                           has to be upgraded to the current schema by\n"
+            << "                           thermos-logger first. immutable=true opens the\n"
+            << "                           database read-only without\n"
+            << "                           any locking. Only use it when no other program\n"
+            << "                           writes to the database at the same time.\n";
 }
 
 int main(int argc, char** argv)
 {
   std::string dbFile;
+  std::optional<thermos::sqlite::options> connection;
 
   if ((argc > 1) && (argv != nullptr))
   {
@@ -96,6 +117,33 @@ int main(int argc, char** argv)
           return thermos::rcInvalidParameter;
         }
       } // if database file
+      else if ((param == "--sqlite") || (param == "-s"))
+      {
+        if (connection.has_value())
+        {
+          std::cerr << "Error: SQLite options were already set!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const auto opts = thermos::sqlite::options::parse(std::string(argv[i+1]), thermos::sqlite::options::for_reading());
+          if (!opts.has_value())
+          {
+            std::cerr << "Error: " << opts.error() << '\n';
+            return thermos::rcInvalidParameter;
+          }
+          connection = opts.value();
+          // Skip next parameter, because it's already used as options.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter SQLite options after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if SQLite options
       else
       {
         std::cerr << "Error: Unknown parameter " << param << "!\n"
@@ -115,5 +163,5 @@ int main(int argc, char** argv)
     return thermos::rcInvalidParameter;
   }
 
-  return thermos::db2csv(dbFile);
+  return thermos::db2csv(dbFile, connection.value_or(thermos::sqlite::options::for_reading()));
 }
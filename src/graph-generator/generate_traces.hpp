@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -21,72 +21,102 @@
 #ifndef THERMOS_GENERATE_TRACES_HPP
 #define THERMOS_GENERATE_TRACES_HPP
 
+#include <algorithm>
 #include <chrono>
 #include <string>
-#include <type_traits>
+#include <utility>
+#include <vector>
 #include "../../third-party/nonstd/expected.hpp"
-#include "../../lib/storage/db.hpp"
+#include "../../lib/device_registry.hpp"
+#include "../../lib/reading_batch.hpp"
+#include "../../lib/templating/downsample.hpp"
 #include "../../lib/templating/template.hpp"
 #include "../../lib/templating/vectorize.hpp"
 
 namespace thermos
 {
 
-/** \brief Generates HTML code containing trace data for the plot.
+/// range of indices [first;last) of readings within a reading batch
+using reading_range = std::pair<std::size_t, std::size_t>;
+
+/** \brief Gets the ranges of the readings of each device within a time span.
  *
- * \param read_t        reading type, e.g. thermal::reading or load::reading
- * \param db_file_name  path to the SQLite database file
- *                      (Note: This file should have been created with the
-                         thermos-logger program.)
- * \param tpl           a loaded template for graph generation
- * \param time_span     amount of time to cover in the generated graph
- * \param y_axis        y-axis configuration for the traces for use by plotly,
- *                      e. g. "yaxis: 'y2'," when mapping to the second y-axis
- * \return Returns an empty optional, if graph generation was successful.
- *         Returns an optional containing an error message otherwise.
+ * \param read_t      reading type, e.g. thermal::reading or load::reading
+ * \param readings    readings grouped by device and ordered by time, e.g. as
+ *                    retrieved by db::get_latest_readings() - may cover a
+ *                    longer time span than the requested one
+ * \param time_span   amount of time to cover, counted back from the latest
+ *                    reading of each device
+ * \return Returns one range per device, in the order of the batch.
  */
 template<typename read_t>
-nonstd::expected<std::string, std::string> generate_traces(const std::string& db_file_name, Template& tpl,
-                                                           const std::chrono::hours time_span, const std::string& y_axis)
+std::vector<reading_range> device_ranges(const reading_batch<read_t>& readings, const std::chrono::hours time_span)
 {
-  static_assert(std::is_base_of<thermos::reading_base, read_t>::value,
-                "read_t must be a reading type based on thermos::reading_base.");
+  const int64_t span = std::chrono::duration_cast<std::chrono::seconds>(time_span).count();
+  std::vector<reading_range> ranges;
+  // Readings are grouped by device, so every run of equal device handles is
+  // one device.
+  std::size_t first = 0;
+  while (first < readings.size())
+  {
+    std::size_t last = first + 1;
+    while ((last < readings.size()) && (readings.devices[last] == readings.devices[first]))
+    {
+      ++last;
+    }
+    // Times within a run are sorted, so the start of the requested time span
+    // can be found by binary search.
+    const auto run_begin = readings.times.begin() + first;
+    const auto run_end = readings.times.begin() + last;
+    const auto start = std::lower_bound(run_begin, run_end, readings.times[last - 1] - span);
+    ranges.emplace_back(start - readings.times.begin(), last);
+    first = last;
+  }
+  return ranges;
+}
 
+/** \brief Generates HTML code containing the trace of a single device.
+ *
+ * \param read_t      reading type, e.g. thermal::reading or load::reading
+ * \param readings    batch containing the readings
+ * \param range       range of the readings of the device within the batch,
+ *                    must not be empty
+ * \param tpl         a loaded template for graph generation
+ * \param y_axis      y-axis configuration for the trace for use by plotly,
+ *                    e. g. "yaxis: 'y2'," when mapping to the second y-axis
+ * \param reduction   settings for the reduction of the number of points
+ * \return Returns a string containing the trace, if generation was
+ *         successful. Returns an error message otherwise.
+ */
+template<typename read_t>
+nonstd::expected<std::string, std::string> generate_trace(const reading_batch<read_t>& readings, const reading_range& range,
+                                                          Template& tpl, const std::string& y_axis,
+                                                          const downsampling& reduction = downsampling())
+{
   if (!tpl.load_section("trace"))
   {
     return nonstd::make_unexpected("Failed to load section 'trace' from template.");
   }
-
-  std::string traces;
-  storage::db the_db;
-  std::vector<device> devs;
-  auto opt = the_db.get_devices(devs, read_t().type(), db_file_name);
-  if (opt.has_value())
+  nonstd::expected<vectorized_data, std::string> vec_data;
+  if (reduction.method == downsampling_method::none)
   {
-    return nonstd::make_unexpected(opt.value());
+    vec_data = vectorize(readings, range.first, range.second);
   }
-  for (const auto& dev: devs)
+  else
   {
-    std::vector<read_t> readings;
-    opt = the_db.get_device_readings(dev, readings, db_file_name, time_span);
-    if (opt.has_value())
-    {
-      return nonstd::make_unexpected(opt.value());
-    }
-    const auto vec_data = vectorize(readings);
-    if (!vec_data.has_value())
-    {
-      return nonstd::make_unexpected(vec_data.error());
-    }
-    tpl.integrate("dates", vec_data.value().dates);
-    tpl.integrate("values", vec_data.value().values);
-    tpl.integrate("yaxis", y_axis);
-    tpl.tag("name", dev.name);
-
-    traces += tpl.generate().value();
+    reading_batch<read_t> reduced;
+    downsample(readings, range.first, range.second, reduction, reduced);
+    vec_data = vectorize(reduced);
   }
-
-  return traces;
+  if (!vec_data.has_value())
+  {
+    return nonstd::make_unexpected(vec_data.error());
+  }
+  tpl.integrate("dates", vec_data.value().dates);
+  tpl.integrate("values", vec_data.value().values);
+  tpl.integrate("yaxis", y_axis);
+  tpl.tag("name", device_registry::get(readings.devices[range.first]).name);
+  return tpl.generate().value();
 }
 
 } // namespace
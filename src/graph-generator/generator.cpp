@@ -19,15 +19,100 @@
 */
 
 #include "generator.hpp"
+#include <algorithm>
 #include <fstream>
+#include "../../lib/load/reading.hpp"
+#include "../../lib/storage/db.hpp"
 #include "../../lib/templating/template.hpp"
+#include "../../lib/thermal/reading.hpp"
 #include "generate_traces.hpp"
+#include "run_parallel.hpp"
 
 namespace thermos
 {
 
+namespace
+{
+
+/** \brief Writes a single HTML file containing the plot.
+ *
+ * \param traces        HTML code of the traces of the plot
+ * \param header        HTML code of the page header
+ * \param tpl           a loaded template for graph generation
+ * \param time_span     amount of time covered by the graph
+ * \param all_time_spans container with all time spans in the navigation
+ * \param output        path where to save the generated file
+ * \return Returns an empty optional, if the file was written successfully.
+ *         Returns an optional containing an error message otherwise.
+ */
+std::optional<std::string> write_page(const std::string& traces, const std::string& header,
+                                      Template& tpl, const std::chrono::hours time_span,
+                                      const std::vector<std::chrono::hours>& all_time_spans,
+                                      const std::filesystem::path& output)
+{
+  if (!tpl.load_section("graph"))
+  {
+    return "Failed to load section 'graph' from template.";
+  }
+  tpl.tag("plotId", "id_1");
+  tpl.tag("title", "Data of the last " + get_human_readable_span(time_span));
+  tpl.integrate("traces", traces);
+  const std::string graph = tpl.generate().value();
+
+  const auto nav = generate_navigation(tpl, time_span, all_time_spans);
+  if (!nav.has_value())
+  {
+    return nav.error();
+  }
+
+  if (!tpl.load_section("full"))
+  {
+    return "Failed to load section 'full' from template.";
+  }
+  tpl.integrate("header", header);
+  tpl.integrate("content", nav.value() + graph);
+  const std::string full = tpl.generate().value();
+
+  std::ofstream stream(output, std::ios::out | std::ios::binary | std::ios::trunc);
+  stream.write(full.c_str(), full.length());
+  if (!stream.good())
+  {
+    return "Failed to write generated template to file!";
+  }
+  stream.close();
+
+  return std::nullopt;
+}
+
+/// readings of all reading types that are shown in a plot
+struct plot_data
+{
+  thermal::reading_batch thermal; /**< temperature readings */
+  load::reading_batch load;       /**< CPU load readings */
+};
+
+/// a trace of a single device in one of the generated pages
+struct trace_task
+{
+  std::size_t page;     /**< index of the page */
+  bool thermal;         /**< whether the trace shows temperature readings */
+  reading_range range;  /**< range of the readings within the batch */
+};
+
+/// readings of one resolution, loaded for the longest time span that uses it
+struct dataset
+{
+  storage::resolution resolution;     /**< resolution of the readings */
+  std::chrono::hours time_span;       /**< longest time span that uses the data */
+  plot_data data;                     /**< the readings */
+};
+
+} // anonymous namespace
+
 std::optional<std::string> generate(const std::string& db_file_name, Template& tpl,
-                                    const std::filesystem::path& output_directory)
+                                    const std::filesystem::path& output_directory,
+                                    const unsigned int jobs, const downsampling& reduction,
+                                    const sqlite::options& connection)
 {
   const std::vector<std::chrono::hours> intervals = {
     std::chrono::hours(48),       // two days
@@ -35,14 +120,134 @@ std::optional<std::string> generate(const std::string& db_file_name, Template& t
     std::chrono::hours(30 * 24),  // 30 days / one month
     std::chrono::hours(365 * 24)  // one year
   };
-  for (const auto& time_span: intervals)
+  // Templates keep the loaded section and its replacements, so every worker
+  // needs its own copy.
+  std::vector<Template> templates(std::max(jobs, 1u), tpl);
+
+  // When the traces get downsampled anyway, long time spans can use hourly
+  // or daily rollups instead of the raw readings, as long as that still
+  // leaves enough readings for the requested number of points. Minimum and
+  // maximum per bucket need the extremes of the rollups, because averages
+  // would flatten any spikes.
+  const auto rollup = (reduction.method == downsampling_method::min_max)
+      ? storage::rollup_value::extremes : storage::rollup_value::average;
+  std::vector<dataset> datasets;
+  std::vector<std::size_t> page_dataset(intervals.size());
+  storage::db coverage(connection);
+  for (std::size_t page = 0; page < intervals.size(); ++page)
+  {
+    std::chrono::seconds max_interval(0);
+    if ((reduction.method != downsampling_method::none) && (reduction.points > 0))
+    {
+      max_interval = std::chrono::duration_cast<std::chrono::seconds>(intervals[page]) / reduction.points;
+    }
+    // The retention policy of the logger may have deleted raw readings or
+    // hourly rollups of longer time spans, so those have to use the coarser
+    // rollups that are still there. Resolutions are declared from fine to
+    // coarse, so the larger one is the coarser one.
+    auto res = storage::db::coarsest_resolution(max_interval);
+    for (const auto type: { reading_type::temperature, reading_type::load })
+    {
+      const auto covering = coverage.covering_resolution(type, db_file_name, intervals[page], res);
+      if (!covering.has_value())
+      {
+        return covering.error();
+      }
+      res = std::max(res, covering.value());
+    }
+    const auto found = std::find_if(datasets.begin(), datasets.end(),
+        [res](const dataset& d) { return d.resolution == res; });
+    if (found == datasets.end())
+    {
+      page_dataset[page] = datasets.size();
+      datasets.push_back({ res, intervals[page], plot_data() });
+    }
+    else
+    {
+      page_dataset[page] = found - datasets.begin();
+      found->time_span = std::max(found->time_span, intervals[page]);
+    }
+  }
+
+  // Readings of each resolution are loaded only once for the longest time
+  // span. The shorter time spans are just the newer parts of that data. All
+  // reading types and resolutions are loaded at the same time. Every worker
+  // has its own database connection, which is reused for all of its tasks.
+  std::vector<storage::db> readers;
+  readers.reserve(templates.size());
+  for (std::size_t i = 0; i < templates.size(); ++i)
+  {
+    readers.emplace_back(connection);
+  }
+  std::vector<std::optional<std::string>> load_errors(2 * datasets.size());
+  run_parallel(load_errors.size(), jobs, [&](const std::size_t task, const unsigned int worker)
+  {
+    auto& the_db = readers[worker];
+    auto& set = datasets[task / 2];
+    load_errors[task] = (task % 2 == 0)
+        ? the_db.get_latest_readings(set.data.thermal, db_file_name, set.time_span, set.resolution, rollup)
+        : the_db.get_latest_readings(set.data.load, db_file_name, set.time_span, set.resolution, rollup);
+  });
+  readers.clear();
+  for (const auto& error: load_errors)
+  {
+    if (error.has_value())
+    {
+      return error;
+    }
+  }
+  const auto header = generate_header(tpl);
+  if (!header.has_value())
+  {
+    return header.error();
+  }
+
+  // Traces of all devices in all pages are independent of each other.
+  std::vector<trace_task> tasks;
+  for (std::size_t page = 0; page < intervals.size(); ++page)
+  {
+    const auto& data = datasets[page_dataset[page]].data;
+    for (const auto& range: device_ranges(data.thermal, intervals[page]))
+    {
+      tasks.push_back({ page, true, range });
+    }
+    for (const auto& range: device_ranges(data.load, intervals[page]))
+    {
+      tasks.push_back({ page, false, range });
+    }
+  }
+  std::vector<nonstd::expected<std::string, std::string>> traces(tasks.size());
+  run_parallel(tasks.size(), jobs, [&](const std::size_t index, const unsigned int worker)
+  {
+    const auto& task = tasks[index];
+    const auto& data = datasets[page_dataset[task.page]].data;
+    traces[index] = task.thermal
+        ? generate_trace(data.thermal, task.range, templates[worker], "yaxis: 'y2',", reduction)
+        : generate_trace(data.load, task.range, templates[worker], "", reduction);
+  });
+  std::vector<std::string> page_traces(intervals.size());
+  for (std::size_t index = 0; index < tasks.size(); ++index)
+  {
+    if (!traces[index].has_value())
+    {
+      return traces[index].error();
+    }
+    page_traces[tasks[index].page] += traces[index].value();
+  }
+  traces.clear();
+
+  std::vector<std::optional<std::string>> page_errors(intervals.size());
+  run_parallel(intervals.size(), jobs, [&](const std::size_t page, const unsigned int worker)
+  {
+    const std::string base_name = "graph_" + get_short_name(intervals[page]) + ".html";
+    page_errors[page] = write_page(page_traces[page], header.value(), templates[worker],
+                                   intervals[page], intervals, output_directory / base_name);
+  });
+  for (const auto& error: page_errors)
   {
-    const std::string base_name = "graph_" + get_short_name(time_span) + ".html";
-    const auto opt = generate_plot(db_file_name, tpl, time_span, intervals,
-                                   output_directory / base_name);
-    if (opt.has_value())
+    if (error.has_value())
     {
-      return opt;
+      return error;
     }
   }
 
@@ -83,64 +288,6 @@ nonstd::expected<std::string, std::string> generate_header(Template& tpl)
   return tpl.generate().value();
 }
 
-std::optional<std::string> generate_plot(const std::string& db_file_name, Template& tpl,
-                                         const std::chrono::hours time_span,
-                                         const std::vector<std::chrono::hours>& all_time_spans,
-                                         const std::filesystem::path& output)
-{
-  const auto header = generate_header(tpl);
-  if (!header.has_value())
-  {
-    return header.error();
-  }
-
-  auto maybe_traces = generate_traces<thermal::reading>(db_file_name, tpl, time_span, "yaxis: 'y2',");
-  if (!maybe_traces)
-  {
-    return maybe_traces.error();
-  }
-  std::string traces {std::move(maybe_traces.value())};
-  maybe_traces = generate_traces<load::reading>(db_file_name, tpl, time_span, "");
-  if (!maybe_traces)
-  {
-    return maybe_traces.error();
-  }
-  traces += maybe_traces.value();
-
-  if (!tpl.load_section("graph"))
-  {
-    return "Failed to load section 'graph' from template.";
-  }
-  tpl.tag("plotId", "id_1");
-  tpl.tag("title", "Data of the last " + get_human_readable_span(time_span));
-  tpl.integrate("traces", traces);
-  const std::string graph = tpl.generate().value();
-
-  const auto nav = generate_navigation(tpl, time_span, all_time_spans);
-  if (!nav.has_value())
-  {
-    return nav.error();
-  }
-
-  if (!tpl.load_section("full"))
-  {
-    return "Failed to load section 'full' from template.";
-  }
-  tpl.integrate("header", header.value());
-  tpl.integrate("content", nav.value() + graph);
-  const std::string full = tpl.generate().value();
-
-  std::ofstream stream(output, std::ios::out | std::ios::binary | std::ios::trunc);
-  stream.write(full.c_str(), full.length());
-  if (!stream.good())
-  {
-    return "Failed to write generated template to file!";
-  }
-  stream.close();
-
-  return std::nullopt;
-}
-
 nonstd::expected<std::string, std::string>
 generate_navigation(Template& tpl, const std::chrono::hours current_time_span,
                     const std::vector<std::chrono::hours>& all_time_spans)
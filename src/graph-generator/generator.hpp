@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -27,6 +27,8 @@
 #include <string>
 #include <vector>
 #include "../../third-party/nonstd/expected.hpp"
+#include "../../lib/sqlite/options.hpp"
+#include "../../lib/templating/downsample.hpp"
 #include "../../lib/templating/template.hpp"
 
 namespace thermos
@@ -39,29 +41,26 @@ namespace thermos
                          thermos-logger program.)
  * \param tpl                 a loaded template for graph generation
  * \param output_directory    path of directory where to save the generated files
+ * \param jobs                maximum number of threads to use for generation
+ * \param reduction           settings for the reduction of the number of
+ *                            points per trace
+ * \param connection          options for the database connections
  * \return Returns an empty optional, if graph generation was successful.
  *         Returns an optional containing an error message otherwise.
  */
 std::optional<std::string> generate(const std::string& db_file_name, Template& tpl,
-                                    const std::filesystem::path& output_directory);
+                                    const std::filesystem::path& output_directory,
+                                    const unsigned int jobs = 1,
+                                    const downsampling& reduction = downsampling(),
+                                    const sqlite::options& connection = sqlite::options());
 
-
-/** \brief Generates a single HTML file containing the plot.
+/** \brief Generates the header of the HTML files, including the scripts.
  *
- * \param db_file_name  path to the SQLite database file
- *                      (Note: This file should have been created with the
-                         thermos-logger program.)
- * \param tpl           a loaded template for graph generation
- * \param time_span     amount of time to cover in the generated graph
- * \param all_time_spans container with all time spans in the navigation
- * \param output        path where to save the generated file
- * \return Returns an empty optional, if graph generation was successful.
- *         Returns an optional containing an error message otherwise.
+ * \param tpl   a loaded template for graph generation
+ * \return Returns the HTML code, if header generation was successful.
+ *         Returns an error message otherwise.
  */
-std::optional<std::string> generate_plot(const std::string& db_file_name, Template& tpl,
-                                         const std::chrono::hours time_span,
-                                         const std::vector<std::chrono::hours>& all_time_spans,
-                                         const std::filesystem::path& output);
+nonstd::expected<std::string, std::string> generate_header(Template& tpl);
 
 /** \brief Generates the navigation for a single HTML file.
  *
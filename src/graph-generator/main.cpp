@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022, 2024, 2025  Dirk Stolle
+    Copyright (C) 2022, 2024, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -18,8 +18,13 @@
  -------------------------------------------------------------------------------
 */
 
+#include <algorithm>
+#include <charconv>
 #include <filesystem>
 #include <iostream>
+#include <optional>
+#include <string_view>
+#include <thread>
 #if !defined(THERMOS_NO_SQLITE)
 #include <sqlite3.h>
 #endif
@@ -61,7 +66,44 @@ void showHelp()
             << "  -t FILE | --template FILE - Sets the file name of the template file to use\n"
             << "                              to generate the graphs.\n"
             << "  -o DIR | --output DIR     - Sets the destination of the generated files to\n"
-            << "                              the directory DIR.\n";
+            << "                              the directory DIR.\n"
+            << "  -j N | --jobs N           - Sets the maximum number of threads that are used\n"
+            << "                              to generate the graphs to N. Use zero to let the\n"
+            << "                              program choose the number of threads based on\n"
+            << "                              the number of processor cores. Default: 1\n"
+            << "  -d METHOD | --downsample METHOD\n"
+            << "                            - Sets the method that is used to reduce the\n"
+            << "                              number of plotted points per device. Valid\n"
+            << "                              methods are:\n"
+            << "                                none    - plot all readings (default)\n"
+            << "                                lttb    - Largest-Triangle-Three-Buckets, keeps\n"
+            << "                                          the shape of the graph\n"
+            << "                                minmax  - minimum and maximum per bucket,\n"
+            << "                                          keeps all spikes\n"
+            << "                                average - average per bucket\n"
+            << "  -p N | --points N         - Sets the maximum number of plotted points per\n"
+            << "                              device when downsampling is used to N. Must be\n"
+            << "                              at least 3. Default: 2000\n"
+            << "  -s SPEC | --sqlite SPEC\n"
+            << "                            - Sets options of the SQLite 3 database connection.\n"
+            << "                              SPEC is a comma-separated list of entries like\n"
+            << "                              'journal_mode=wal'. Allowed entries are:\n"
+            << "                                journal_mode=delete|truncate|persist|wal\n"
+            << "                                synchronous=off|normal|full|extra\n"
+            << "                                mmap_size=BYTES\n"
+            << "                                cache_size=KIB\n"
+            << "                                busy_timeout=MILLISECONDS\n"
+            << "                                read_only=true|false\n"
+            << "                                immutable=true|false\n"
+            << "                              Entries that are not given use the defaults\n"
+            << "                              mmap_size=268435456, busy_timeout=5000 and\n"
+            << "                              read_only=true. The database is never changed,\n"
+            << "                              so it has to be upgraded to the current schema\n"
+            << "                              by thermos-logger first.\n"
+            << "                              immutable=true opens the database read-only\n"
+            << "                              without any locking. Only use it when no\n"
+            << "                              other program writes to the database at the\n"
+            << "                              same time.\n";
 }
 
 int check_directory(const std::filesystem::path& destination)
@@ -99,6 +141,10 @@ int main(int argc, char** argv)
   std::string logFile;
   std::string templateFile;
   std::filesystem::path destination;
+  std::optional<unsigned int> jobs;
+  std::optional<thermos::downsampling_method> method;
+  std::optional<std::size_t> points;
+  std::optional<thermos::sqlite::options> connection;
 
   if ((argc > 1) && (argv != nullptr))
   {
@@ -186,6 +232,124 @@ int main(int argc, char** argv)
           return thermos::rcInvalidParameter;
         }
       } // if output file
+      else if ((param == "--jobs") || (param == "-j"))
+      {
+        if (jobs.has_value())
+        {
+          std::cerr << "Error: Number of jobs was already set to "
+                    << jobs.value() << "!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const std::string_view value(argv[i+1]);
+          unsigned int number = 0;
+          const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+          if ((ec != std::errc()) || (ptr != value.data() + value.size()) || (number > 1024))
+          {
+            std::cerr << "Error: \"" << value << "\" is not a valid number of jobs."
+                      << " It has to be an integer between 0 and 1024.\n";
+            return thermos::rcInvalidParameter;
+          }
+          jobs = number;
+          // Skip next parameter, because it's already used as number.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter a number after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if jobs
+      else if ((param == "--downsample") || (param == "-d"))
+      {
+        if (method.has_value())
+        {
+          std::cerr << "Error: Downsampling method was already set to "
+                    << thermos::to_string(method.value()) << "!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const std::string name(argv[i+1]);
+          method = thermos::parse_downsampling_method(name);
+          if (!method.has_value())
+          {
+            std::cerr << "Error: \"" << name << "\" is not a valid downsampling method."
+                      << " Valid methods are none, lttb, minmax and average.\n";
+            return thermos::rcInvalidParameter;
+          }
+          // Skip next parameter, because it's already used as method.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter a method after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if downsampling method
+      else if ((param == "--points") || (param == "-p"))
+      {
+        if (points.has_value())
+        {
+          std::cerr << "Error: Number of points was already set to "
+                    << points.value() << "!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const std::string_view value(argv[i+1]);
+          std::size_t number = 0;
+          const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+          if ((ec != std::errc()) || (ptr != value.data() + value.size()) || (number < 3))
+          {
+            std::cerr << "Error: \"" << value << "\" is not a valid number of points."
+                      << " It has to be an integer of at least 3.\n";
+            return thermos::rcInvalidParameter;
+          }
+          points = number;
+          // Skip next parameter, because it's already used as number.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter a number after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if points
+      else if ((param == "--sqlite") || (param == "-s"))
+      {
+        if (connection.has_value())
+        {
+          std::cerr << "Error: SQLite options were already set!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const auto opts = thermos::sqlite::options::parse(std::string(argv[i+1]), thermos::sqlite::options::for_reading());
+          if (!opts.has_value())
+          {
+            std::cerr << "Error: " << opts.error() << '\n';
+            return thermos::rcInvalidParameter;
+          }
+          connection = opts.value();
+          // Skip next parameter, because it's already used as options.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter SQLite options after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if SQLite options
       else
       {
         std::cerr << "Error: Unknown parameter " << param << "!\n"
@@ -231,7 +395,21 @@ int main(int argc, char** argv)
     return code;
   }
 
-  const auto opt = thermos::generate(logFile, tpl, destination);
+  if (!jobs.has_value())
+  {
+    jobs = 1;
+  }
+  else if (jobs.value() == 0)
+  {
+    jobs = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  thermos::downsampling reduction;
+  reduction.method = method.value_or(thermos::downsampling_method::none);
+  reduction.points = points.value_or(reduction.points);
+
+  const auto opt = thermos::generate(logFile, tpl, destination, jobs.value(), reduction,
+                                     connection.value_or(thermos::sqlite::options::for_reading()));
   if (opt.has_value())
   {
     std::cerr << "Error: Template generation failed!\n" << opt.value() << "\n";
@@ -0,0 +1,81 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_RUN_PARALLEL_HPP
+#define THERMOS_RUN_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace thermos
+{
+
+/** \brief Runs a number of independent tasks on a pool of threads.
+ *
+ * \param task_count  number of tasks
+ * \param jobs        maximum number of threads to use - if this is one or
+ *                    zero, all tasks run on the calling thread
+ * \param task        function that runs a single task, it gets the index of
+ *                    the task and the index of the worker that runs it, where
+ *                    the worker index is always less than jobs - the function
+ *                    must not throw
+ * \remarks Workers take the next task as soon as they are done with the
+ *          previous one, so tasks of different duration are balanced. Since
+ *          every worker runs only one task at a time, per-worker state like a
+ *          Template can be indexed by the worker index without locking.
+ */
+template<typename task_fn>
+void run_parallel(const std::size_t task_count, const unsigned int jobs, const task_fn& task)
+{
+  const unsigned int workers = static_cast<unsigned int>(std::min<std::size_t>(jobs, task_count));
+  if (workers <= 1)
+  {
+    for (std::size_t i = 0; i < task_count; ++i)
+    {
+      task(i, 0);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_task(0);
+  std::vector<std::thread> threads;
+  threads.reserve(workers);
+  for (unsigned int worker = 0; worker < workers; ++worker)
+  {
+    threads.emplace_back([&next_task, &task, task_count, worker]()
+    {
+      for (std::size_t i = next_task++; i < task_count; i = next_task++)
+      {
+        task(i, worker);
+      }
+    });
+  }
+  for (auto& thread: threads)
+  {
+    thread.join();
+  }
+}
+
+} // namespace
+
+#endif // THERMOS_RUN_PARALLEL_HPP
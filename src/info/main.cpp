@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022, 2024, 2025  Dirk Stolle
+    Copyright (C) 2022, 2024, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -89,8 +89,9 @@ int main(int argc, char** argv)
     std::cout << "Temperature data:\n";
     for (const auto& reading: thermal_readings.value())
     {
-      std::cout << "Device '" << reading.dev.name << "': " << reading.reading.celsius() << " °C\n"
-                << "  (from " << reading.dev.origin << ")\n";
+      const auto& dev = thermos::device_registry::get(reading.dev);
+      std::cout << "Device '" << dev.name << "': " << reading.reading.celsius() << " °C\n"
+                << "  (from " << dev.origin << ")\n";
     }
   }
 
@@ -106,8 +107,9 @@ int main(int argc, char** argv)
     std::cout << "\nCPU load:\n";
     for (const auto& reading: load_readings.value())
     {
-      std::cout << "Device '" << reading.dev.name << "': " << reading.reading.percent() << " %\n"
-                << "  (from " << reading.dev.origin << ")\n";
+      const auto& dev = thermos::device_registry::get(reading.dev);
+      std::cout << "Device '" << dev.name << "': " << reading.reading.percent() << " %\n"
+                << "  (from " << dev.origin << ")\n";
     }
   }
 
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,17 +19,35 @@
 */
 
 #include "Logger.hpp"
+#include <algorithm>
+#include <iostream>
 #include <thread>
 #include "../../lib/load/read.hpp"
 #include "../../lib/thermal/read.hpp"
 #include "../../lib/storage/factory.hpp"
+#if !defined(THERMOS_NO_SQLITE)
+#include "../../lib/storage/db.hpp"
+#endif
 
 namespace thermos
 {
 
-Logger::Logger(const std::string& fileName, const storage::type fileType)
+Logger::Logger(const std::string& fileName, const storage::type fileType,
+               const storage::retention_policy& retention,
+               const sqlite::options& connection,
+               const write_queue_settings& queue,
+               const schedule_settings& schedule)
 : file_name(fileName),
-  file_type(fileType)
+  file_type(fileType),
+  retention_policy(retention),
+  connection_options(connection),
+  queue_settings(queue),
+  sampling(schedule),
+  spill_mutex(),
+  spill(fileName + ".spill"),
+  spilled(0),
+  error_mutex(),
+  writer_error(std::nullopt)
 {
 }
 
@@ -43,52 +61,281 @@ std::optional<std::string> Logger::log()
   }
   #endif
 
-  auto next = std::chrono::steady_clock::now();
+  // The storage instance is created only once and kept for all iterations,
+  // so that e. g. the database connection can stay open between them.
+  auto data_store = storage::factory::create(file_type, connection_options);
+  if (data_store == nullptr)
+  {
+    return "Could not create storage for the given file type.";
+  }
+
+  bounded_queue<sample> queue(queue_settings.capacity);
+  std::thread writer([this, &queue, &data_store]()
+  {
+    auto error = write_loop(queue, *data_store);
+    if (error.has_value())
+    {
+      std::lock_guard lock(error_mutex);
+      writer_error = std::move(error);
+    }
+    // Closing the queue wakes up a sampler that waits for free space.
+    queue.close();
+  });
+
+  const auto error = sample_loop(queue);
+  // Samples that are still queued are written before the writer stops.
+  queue.close();
+  writer.join();
+  if (error.has_value())
+  {
+    return error;
+  }
+  return writer_failure();
+}
+
+std::optional<std::string> Logger::sample_loop(bounded_queue<sample>& queue)
+{
+  scheduler timer(sampling.interval, sampling.catch_up);
+  load::reader load_reader;
 
   while (true)
   {
+    auto failure = writer_failure();
+    if (failure.has_value())
+    {
+      return failure;
+    }
+
     // Retrieve thermal sensor data.
-    const auto thermal_readings = thermal::read_all();
+    auto thermal_readings = thermal::read_all();
     if (!thermal_readings.has_value())
     {
       return thermal_readings.error();
     }
-    const auto& thermal_readings_v = thermal_readings.value();
-    if (thermal_readings_v.empty())
+    if (thermal_readings.value().empty())
     {
       return "No temperature readings are available.";
     }
 
     // Retrieve CPU load data.
-    const auto load_readings = load::read_all();
+    auto load_readings = load_reader.read();
     if (!load_readings.has_value())
     {
       return load_readings.error();
     }
-    const auto& load_readings_v = load_readings.value();
-    if (load_readings_v.empty())
+    if (load_readings.value().empty())
     {
       return "No CPU load data is available.";
     }
 
-    // Store retrieved data.
-    auto storage = storage::factory::create(file_type);
-    auto opt = storage->save(thermal_readings_v, file_name);
+    // Hand retrieved data over to the writer thread.
+    sample data{ std::move(thermal_readings.value()), std::move(load_readings.value()) };
+    failure = enqueue(queue, std::move(data));
+    if (failure.has_value())
+    {
+      return failure;
+    }
+
+    // Wait before making the next iteration.
+    const auto missed = timer.wait();
+    report(timer, missed);
+  }
+}
+
+void Logger::report(const scheduler& timer, const uint64_t missed) const
+{
+  using namespace std::chrono;
+  const auto& stats = timer.statistics();
+  const auto as_ms = [](const nanoseconds ns) { return duration<double, std::milli>(ns).count(); };
+
+  if (missed > 0)
+  {
+    std::cerr << "Warning: Taking the readings took longer than the interval of "
+              << duration_cast<milliseconds>(timer.interval()).count() << " ms, "
+              << missed << " deadline(s) have passed in the meantime and "
+              << (sampling.catch_up == catch_up_policy::skip ? "have been skipped" : "are taken now")
+              << ". " << stats.missed << " deadlines have been missed so far.\n";
+  }
+
+  // Report the jitter about once per hour.
+  const uint64_t cycles_per_report = std::max<uint64_t>(1, hours(1) / timer.interval());
+  if (stats.cycles % cycles_per_report == 0)
+  {
+    std::cout << "Scheduling: " << stats.cycles << " cycles, " << stats.missed
+              << " missed deadlines, jitter mean " << as_ms(stats.mean_jitter())
+              << " ms, max " << as_ms(stats.max_jitter) << " ms\n";
+  }
+}
+
+std::optional<std::string> Logger::enqueue(bounded_queue<sample>& queue, sample&& data)
+{
+  switch (queue_settings.overflow)
+  {
+    case overflow_policy::block:
+         if (!queue.push(std::move(data)))
+         {
+           return writer_failure().value_or("The write queue was closed.");
+         }
+         return std::nullopt;
+    case overflow_policy::drop_oldest:
+         {
+           const auto dropped = queue.statistics().dropped;
+           if (!queue.push_overwrite(std::move(data)))
+           {
+             return writer_failure().value_or("The write queue was closed.");
+           }
+           const auto stats = queue.statistics();
+           if (stats.dropped > dropped)
+           {
+             std::cerr << "Warning: The write queue is full (" << stats.depth
+                       << " samples), so the oldest sample has been dropped. "
+                       << stats.dropped << " samples have been dropped so far.\n";
+           }
+         }
+         return std::nullopt;
+    case overflow_policy::spill:
+         {
+           // Once a sample is in the spill file, all newer samples have to
+           // follow it there until the writer thread has read the file back.
+           // Otherwise they would be written before the older samples.
+           std::lock_guard lock(spill_mutex);
+           if (!spill.pending() && queue.try_push(data))
+           {
+             return std::nullopt;
+           }
+           // The writer thread closes the queue when it fails.
+           const auto failure = writer_failure();
+           if (failure.has_value())
+           {
+             return failure;
+           }
+           const auto error = spill.append(data.thermal, data.load);
+           if (error.has_value())
+           {
+             return error;
+           }
+           ++spilled;
+           std::cerr << "Warning: The write queue is full ("
+                     << queue.statistics().depth << " samples), so the "
+                     << "readings have been written to " << spill.name()
+                     << ". " << spilled << " samples have been written there so far.\n";
+         }
+         return std::nullopt;
+    default:
+         return "Unknown overflow policy.";
+  }
+}
+
+std::optional<std::string> Logger::replay_spill(const bounded_queue<sample>& queue, storage::store& store)
+{
+  // Samples are read back in small portions, so the spill file never has to
+  // be held in memory all at once.
+  constexpr std::size_t max_batch = 16;
+  std::vector<thermal::device_reading> thermal_readings;
+  std::vector<load::device_reading> load_readings;
+  while (true)
+  {
+    thermal_readings.clear();
+    load_readings.clear();
+    {
+      std::lock_guard lock(spill_mutex);
+      if (!spill.pending() || (queue.statistics().depth > 0))
+      {
+        return std::nullopt;
+      }
+      const auto taken = spill.take(max_batch, thermal_readings, load_readings);
+      if (!taken.has_value())
+      {
+        return taken.error();
+      }
+    }
+
+    auto opt = store.save(thermal_readings, file_name);
     if (opt.has_value())
     {
       return opt;
     }
-    opt = storage->save(load_readings_v, file_name);
+    opt = store.save(load_readings, file_name);
     if (opt.has_value())
     {
       return opt;
     }
+  }
+}
 
-    // Wait before making the next iteration.
-    constexpr auto interval = std::chrono::seconds(300);
-    next += interval;
-    std::this_thread::sleep_until(next);
+std::optional<std::string> Logger::write_loop(bounded_queue<sample>& queue, storage::store& store)
+{
+  // Several samples may have piled up while the previous write was slow.
+  // They are written together, i. e. with one transaction per reading type.
+  constexpr std::size_t max_batch = 16;
+  std::vector<sample> batch;
+  std::vector<thermal::device_reading> thermal_readings;
+  std::vector<load::device_reading> load_readings;
+  // Expired readings are removed right after the first write and then once
+  // per hour, because a retention is given in hours or days anyway.
+  constexpr auto compaction_period = std::chrono::hours(1);
+  auto next_compaction = std::chrono::steady_clock::now();
+
+  while (true)
+  {
+    // The spill file may also contain samples of a previous run.
+    auto opt = replay_spill(queue, store);
+    if (opt.has_value())
+    {
+      return opt;
+    }
+    if (!queue.pop_batch(batch, max_batch))
+    {
+      break;
+    }
+
+    thermal_readings.clear();
+    load_readings.clear();
+    for (const auto& data: batch)
+    {
+      thermal_readings.insert(thermal_readings.end(), data.thermal.begin(), data.thermal.end());
+      load_readings.insert(load_readings.end(), data.load.begin(), data.load.end());
+    }
+    batch.clear();
+
+    opt = store.save(thermal_readings, file_name);
+    if (opt.has_value())
+    {
+      return opt;
+    }
+    opt = store.save(load_readings, file_name);
+    if (opt.has_value())
+    {
+      return opt;
+    }
+
+    #if !defined(THERMOS_NO_SQLITE)
+    // Remove expired readings. The time per run is limited, so that a large
+    // backlog of old readings is removed over several runs instead of
+    // delaying the next readings.
+    auto* database = dynamic_cast<storage::db*>(&store);
+    const auto now = std::chrono::steady_clock::now();
+    if ((database != nullptr) && !retention_policy.keeps_everything() && (now >= next_compaction))
+    {
+      constexpr auto compaction_budget = std::chrono::seconds(10);
+      const auto deleted = database->compact(file_name, retention_policy, compaction_budget);
+      if (!deleted.has_value())
+      {
+        return deleted.error();
+      }
+      next_compaction = now + compaction_period;
+    }
+    #endif
   }
+
+  // Samples that were spilled after the last queued ones are written, too.
+  return replay_spill(queue, store);
+}
+
+std::optional<std::string> Logger::writer_failure()
+{
+  std::lock_guard lock(error_mutex);
+  return writer_error;
 }
 
 } // namespace
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -18,14 +18,47 @@
  -------------------------------------------------------------------------------
 */
 
+#include <chrono>
+#include <cstddef>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <vector>
+#include "../../lib/load/reading.hpp"
+#include "../../lib/sqlite/options.hpp"
+#include "../../lib/storage/retention.hpp"
+#include "../../lib/storage/store.hpp"
 #include "../../lib/storage/type.hpp"
+#include "../../lib/thermal/reading.hpp"
+#include "bounded_queue.hpp"
+#include "catch_up_policy.hpp"
+#include "overflow_policy.hpp"
+#include "scheduler.hpp"
+#include "spill_file.hpp"
 
 namespace thermos
 {
 
+/// settings of the queue between the sampling and the writing of readings
+struct write_queue_settings
+{
+  std::size_t capacity = 64; /**< maximum number of queued samples */
+  overflow_policy overflow = overflow_policy::block; /**< what happens when the queue is full */
+};
+
+/// settings of the times when readings are taken
+struct schedule_settings
+{
+  std::chrono::milliseconds interval = std::chrono::minutes(5); /**< time between two readings */
+  catch_up_policy catch_up = catch_up_policy::skip; /**< what happens when taking readings took longer than the interval */
+};
+
 /** \brief Handles the thermal data logging process.
+ *
+ * Sensors are read on the calling thread, while the readings are written to
+ * the file by a separate writer thread, so that a slow disk or a locked
+ * database does not delay the next readings. Both threads are connected by a
+ * bounded queue.
  */
 class Logger
 {
@@ -34,8 +67,18 @@ class Logger
      *
      * \param fileName   path of the file where the data shall be logged
      * \param fileType   the file type to use (CSV or SQLite 3 database)
+     * \param retention  how long readings are kept in a database; the default
+     *                   keeps them forever
+     * \param connection options for the database connection
+     * \param queue      size of the write queue and what happens when it is full
+     * \param schedule   interval between readings and what happens when
+     *                   taking readings took longer than that
      */
-    Logger(const std::string& fileName, const storage::type fileType);
+    Logger(const std::string& fileName, const storage::type fileType,
+           const storage::retention_policy& retention = storage::retention_policy(),
+           const sqlite::options& connection = sqlite::options::for_writing(),
+           const write_queue_settings& queue = write_queue_settings(),
+           const schedule_settings& schedule = schedule_settings());
 
     /** \brief Starts data logging.
      *
@@ -46,8 +89,77 @@ class Logger
      */
     std::optional<std::string> log();
   private:
+    /// readings of all sensors taken at the same time
+    struct sample
+    {
+      std::vector<thermal::device_reading> thermal; /**< temperature readings */
+      std::vector<load::device_reading> load;       /**< CPU load readings */
+    };
+
+    /** \brief Reads the sensors periodically and hands the readings over to
+     *         the writer thread.
+     *
+     * \param queue   the queue to the writer thread
+     * \return Returns an error message, if an error occurred or the writer
+     *         thread stopped.
+     */
+    std::optional<std::string> sample_loop(bounded_queue<sample>& queue);
+
+    /** \brief Reports missed deadlines and the jitter of the scheduler.
+     *
+     * \param timer    the scheduler of the sampling loop
+     * \param missed   number of deadlines missed in the current cycle
+     */
+    void report(const scheduler& timer, const uint64_t missed) const;
+
+    /** \brief Adds a sample to the write queue, handling a full queue
+     *         according to the overflow policy.
+     *
+     * \param queue   the queue to the writer thread
+     * \param data    the sample to add
+     * \return Returns an empty optional in case of success.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> enqueue(bounded_queue<sample>& queue, sample&& data);
+
+    /** \brief Writes samples from the spill file to the file, as long as the
+     *         write queue is empty.
+     *
+     * \param queue   the queue from the sampling thread
+     * \param store   the storage to write to
+     * \return Returns an empty optional, if all samples were written.
+     *         Returns an error message otherwise.
+     * \remarks Samples in the queue are always older than those in the spill
+     *          file, so the spill file is only read when the queue is empty.
+     */
+    std::optional<std::string> replay_spill(const bounded_queue<sample>& queue, storage::store& store);
+
+    /** \brief Writes queued samples to the file until the queue is closed.
+     *
+     * \param queue   the queue from the sampling thread
+     * \param store   the storage to write to
+     * \return Returns an empty optional, if all samples were written.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> write_loop(bounded_queue<sample>& queue, storage::store& store);
+
+    /** \brief Gets the error of the writer thread, if any.
+     *
+     * \return Returns the error message of the writer thread, if it failed.
+     */
+    std::optional<std::string> writer_failure();
+
     std::string file_name;
     storage::type file_type;
+    storage::retention_policy retention_policy;
+    sqlite::options connection_options;
+    write_queue_settings queue_settings;
+    schedule_settings sampling;
+    std::mutex spill_mutex; /**< protects spill and the choice between queue and spill file */
+    spill_file spill; /**< samples that did not fit into the write queue */
+    uint64_t spilled; /**< number of samples written to the spill file */
+    std::mutex error_mutex; /**< protects writer_error */
+    std::optional<std::string> writer_error; /**< error of the writer thread, if any */
 }; // class
 
 } // namespace
@@ -0,0 +1,219 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_LOGGER_BOUNDED_QUEUE_HPP
+#define THERMOS_LOGGER_BOUNDED_QUEUE_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace thermos
+{
+
+/// counters of a bounded_queue
+struct queue_stats
+{
+  std::size_t depth = 0;     /**< number of elements currently in the queue */
+  std::size_t max_depth = 0; /**< highest number of elements so far */
+  uint64_t pushed = 0;       /**< number of elements that were added */
+  uint64_t dropped = 0;      /**< number of elements that were overwritten */
+};
+
+/** \brief Queue with a fixed capacity that hands elements from producer
+ *         threads to consumer threads.
+ *
+ * Elements are stored in a ring buffer that is allocated once, so pushing
+ * and popping never allocates. What happens when the queue is full is up to
+ * the producer: push() waits for free space, try_push() fails and
+ * push_overwrite() drops the oldest element.
+ */
+template<typename T>
+class bounded_queue
+{
+  public:
+    /** \brief Creates an empty queue.
+     *
+     * \param capacity   maximum number of elements, at least one
+     */
+    explicit bounded_queue(const std::size_t capacity)
+    : slots(std::max<std::size_t>(capacity, 1)),
+      head(0),
+      closed(false),
+      stats()
+    {
+    }
+
+    /** \brief Adds an element, waiting until there is free space.
+     *
+     * \param element   the element to add
+     * \return Returns true, if the element was added.
+     *         Returns false, if the queue was closed.
+     */
+    bool push(T&& element)
+    {
+      std::unique_lock lock(mutex);
+      not_full.wait(lock, [this]() { return closed || (stats.depth < slots.size()); });
+      if (closed)
+      {
+        return false;
+      }
+      add(std::move(element));
+      lock.unlock();
+      not_empty.notify_one();
+      return true;
+    }
+
+    /** \brief Adds an element, if there is free space.
+     *
+     * \param element   the element to add, it is left untouched on failure
+     * \return Returns true, if the element was added.
+     *         Returns false, if the queue is full or closed.
+     */
+    bool try_push(T& element)
+    {
+      std::unique_lock lock(mutex);
+      if (closed || (stats.depth == slots.size()))
+      {
+        return false;
+      }
+      add(std::move(element));
+      lock.unlock();
+      not_empty.notify_one();
+      return true;
+    }
+
+    /** \brief Adds an element, dropping the oldest element if the queue is full.
+     *
+     * \param element   the element to add
+     * \return Returns true, if the element was added.
+     *         Returns false, if the queue was closed.
+     */
+    bool push_overwrite(T&& element)
+    {
+      std::unique_lock lock(mutex);
+      if (closed)
+      {
+        return false;
+      }
+      if (stats.depth == slots.size())
+      {
+        slots[head].reset();
+        head = (head + 1) % slots.size();
+        --stats.depth;
+        ++stats.dropped;
+      }
+      add(std::move(element));
+      lock.unlock();
+      not_empty.notify_one();
+      return true;
+    }
+
+    /** \brief Removes up to a given number of elements, waiting until there
+     *         is at least one element or until the queue is closed.
+     *
+     * \param out       vector to which the removed elements are appended, in
+     *                  the order in which they were added
+     * \param max_count maximum number of elements to remove
+     * \return Returns true, if elements were removed.
+     *         Returns false, if the queue is closed and empty.
+     */
+    bool pop_batch(std::vector<T>& out, const std::size_t max_count)
+    {
+      std::unique_lock lock(mutex);
+      not_empty.wait(lock, [this]() { return closed || (stats.depth > 0); });
+      if (stats.depth == 0)
+      {
+        return false;
+      }
+      const std::size_t count = std::min(stats.depth, std::max<std::size_t>(max_count, 1));
+      for (std::size_t i = 0; i < count; ++i)
+      {
+        out.push_back(std::move(slots[head].value()));
+        slots[head].reset();
+        head = (head + 1) % slots.size();
+      }
+      stats.depth -= count;
+      lock.unlock();
+      not_full.notify_all();
+      return true;
+    }
+
+    /** \brief Closes the queue.
+     *
+     * Elements cannot be added to a closed queue anymore, but elements that
+     * are already in the queue can still be removed. Waiting producers and
+     * consumers are woken up.
+     */
+    void close()
+    {
+      {
+        std::lock_guard lock(mutex);
+        closed = true;
+      }
+      not_full.notify_all();
+      not_empty.notify_all();
+    }
+
+    /** \brief Gets the counters of the queue.
+     *
+     * \return Returns a snapshot of the counters.
+     */
+    queue_stats statistics() const
+    {
+      std::lock_guard lock(mutex);
+      return stats;
+    }
+
+    /** \brief Gets the maximum number of elements in the queue.
+     *
+     * \return Returns the capacity of the queue.
+     */
+    std::size_t capacity() const
+    {
+      return slots.size();
+    }
+  private:
+    /// Adds an element to the tail. Caller has to hold the lock and make sure
+    /// that there is free space.
+    void add(T&& element)
+    {
+      slots[(head + stats.depth) % slots.size()].emplace(std::move(element));
+      ++stats.depth;
+      ++stats.pushed;
+      stats.max_depth = std::max(stats.max_depth, stats.depth);
+    }
+
+    mutable std::mutex mutex;
+    std::condition_variable not_full;  /**< signalled when elements are removed */
+    std::condition_variable not_empty; /**< signalled when elements are added */
+    std::vector<std::optional<T>> slots; /**< ring buffer of elements */
+    std::size_t head;  /**< index of the oldest element */
+    bool closed;       /**< whether the queue has been closed */
+    queue_stats stats; /**< counters, depth is the number of elements */
+};
+
+} // namespace
+
+#endif // THERMOS_LOGGER_BOUNDED_QUEUE_HPP
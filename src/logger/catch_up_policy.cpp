@@ -0,0 +1,46 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "catch_up_policy.hpp"
+#include <stdexcept>
+#include "parse_name.hpp"
+
+namespace thermos
+{
+
+std::string to_string(const catch_up_policy policy)
+{
+  switch (policy)
+  {
+    case catch_up_policy::skip:
+         return "skip";
+    case catch_up_policy::burst:
+         return "burst";
+    default:
+         throw std::invalid_argument("Invalid catch_up_policy value in to_string!");
+  }
+}
+
+std::optional<catch_up_policy> parse_catch_up_policy(const std::string& name)
+{
+  return parse_name(name, { catch_up_policy::skip, catch_up_policy::burst });
+}
+
+} // namespace
@@ -0,0 +1,63 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_LOGGER_CATCH_UP_POLICY_HPP
+#define THERMOS_LOGGER_CATCH_UP_POLICY_HPP
+
+#include <optional>
+#include <string>
+
+namespace thermos
+{
+
+/** \brief What the logger does when taking and queueing the readings took
+ * longer than the interval, so that one or more deadlines have passed.
+ *
+ * Either way, the following deadlines stay multiples of the interval after
+ * the start, see scheduler.
+ */
+enum class catch_up_policy
+{
+  /// skip the deadlines that have passed and continue at the next one
+  skip,
+
+  /// take the readings for all passed deadlines immediately, one after another
+  burst
+};
+
+/** \brief Converts a catch_up_policy to a string.
+ *
+ * \param policy   the catch-up policy
+ * \return Returns a string that identifies the policy.
+ */
+std::string to_string(const catch_up_policy policy);
+
+/** \brief Parses a catch-up policy from its name.
+ *
+ * \param name   name of the policy as used by the option --catch-up, i. e.
+ *               "skip" or "burst"
+ * \return Returns the policy, if the name is known.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<catch_up_policy> parse_catch_up_policy(const std::string& name);
+
+} // namespace
+
+#endif // THERMOS_LOGGER_CATCH_UP_POLICY_HPP
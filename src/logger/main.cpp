@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of thermos.
-    Copyright (C) 2022, 2024, 2025  Dirk Stolle
+    Copyright (C) 2022, 2024, 2025, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -18,10 +18,14 @@
  -------------------------------------------------------------------------------
 */
 
+#include <charconv>
 #include <iostream>
+#include <string_view>
 #if !defined(THERMOS_NO_SQLITE)
 #include <sqlite3.h>
 #endif
+#include "../../lib/sqlite/options.hpp"
+#include "../../lib/storage/retention.hpp"
 #include "../../lib/storage/type.hpp"
 #include "../util/GitInfos.hpp"
 #include "../ReturnCodes.hpp"
@@ -73,13 +77,71 @@ void showHelp()
             << "                           as character-separated values (CSV). If the type is\n"
             << "                           '" << type::db << "', then the readings are stored in an SQLite 3\n"
             << "                           database.\n"
-            << "                           If no type is given, then '" << defaultFileType << "' is assumed.\n";
+            << "                           If no type is given, then '" << defaultFileType << "' is assumed.\n"
+            << "  -r SPEC | --retention SPEC\n"
+            << "                         - Sets how long readings are kept in the database.\n"
+            << "                           SPEC is a comma-separated list of entries like\n"
+            << "                           'raw=14d', where the name is one of raw, hourly or\n"
+            << "                           daily and the duration is a number followed by h\n"
+            << "                           (hours), d (days) or y (years), or 'forever'.\n"
+            << "                           Readings of resolutions that are not mentioned are\n"
+            << "                           kept forever. For example, 'raw=14d,hourly=1y' keeps\n"
+            << "                           the raw readings for 14 days, the hourly averages\n"
+            << "                           for a year and the daily averages forever.\n"
+            << "                           If no retention is given, no readings are deleted.\n"
+            << "                           Only applies to the file type '" << type::db << "'.\n"
+            << "  -s SPEC | --sqlite SPEC\n"
+            << "                         - Sets options of the SQLite 3 database connection.\n"
+            << "                           SPEC is a comma-separated list of entries like\n"
+            << "                           'journal_mode=wal'. Allowed entries are:\n"
+            << "                             journal_mode=delete|truncate|persist|wal\n"
+            << "                             synchronous=off|normal|full|extra\n"
+            << "                             mmap_size=BYTES\n"
+            << "                             cache_size=KIB\n"
+            << "                             busy_timeout=MILLISECONDS\n"
+            << "                           Entries that are not given use the defaults\n"
+            << "                           journal_mode=wal, synchronous=normal and\n"
+            << "                           busy_timeout=5000, so that programs which read the\n"
+            << "                           database at the same time do not block logging.\n"
+            << "                           Only applies to the file type '" << type::db << "'.\n"
+            << "  -q N | --queue-size N  - Sets the maximum number of samples that wait to be\n"
+            << "                           written to the file to N. Must be between 1 and\n"
+            << "                           100000. Default: 64\n"
+            << "  -o POLICY | --overflow POLICY\n"
+            << "                         - Sets what happens when the queue of samples that\n"
+            << "                           wait to be written is full. Allowed policies are:\n"
+            << "                             block       - wait until there is free space,\n"
+            << "                                           this delays the next readings\n"
+            << "                             drop-oldest - drop the oldest waiting sample\n"
+            << "                             spill       - write the new sample to the file\n"
+            << "                                           FILE.spill, the samples are\n"
+            << "                                           written to FILE later\n"
+            << "                           Default: block\n"
+            << "  -i TIME | --interval TIME\n"
+            << "                         - Sets the time between two readings. TIME is a\n"
+            << "                           number followed by one of the units ms\n"
+            << "                           (milliseconds), s (seconds), m (minutes) or h\n"
+            << "                           (hours), e. g. '1s' or '100ms'. It has to be between\n"
+            << "                           10 ms and 24 h. Default: 5m\n"
+            << "  -c POLICY | --catch-up POLICY\n"
+            << "                         - Sets what happens when taking the readings took\n"
+            << "                           longer than the interval. Allowed policies are:\n"
+            << "                             skip  - skip the readings whose time has passed\n"
+            << "                             burst - take the readings whose time has passed\n"
+            << "                                     immediately, one after another\n"
+            << "                           Default: skip\n";
 }
 
 int main(int argc, char** argv)
 {
   std::string logFile;
   std::optional<thermos::storage::type> fileType = std::nullopt;
+  std::optional<thermos::storage::retention_policy> retention = std::nullopt;
+  std::optional<thermos::sqlite::options> connection = std::nullopt;
+  std::optional<std::size_t> queueSize = std::nullopt;
+  std::optional<thermos::overflow_policy> overflow = std::nullopt;
+  std::optional<std::chrono::milliseconds> interval = std::nullopt;
+  std::optional<thermos::catch_up_policy> catchUp = std::nullopt;
 
   if ((argc > 1) && (argv != nullptr))
   {
@@ -164,6 +226,189 @@ int main(int argc, char** argv)
           return thermos::rcInvalidParameter;
         }
       } // if file type
+      else if ((param == "--retention") || (param == "-r"))
+      {
+        if (retention.has_value())
+        {
+          std::cerr << "Error: Retention was already set!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const auto policy = thermos::storage::retention_policy::parse(std::string(argv[i+1]));
+          if (!policy.has_value())
+          {
+            std::cerr << "Error: " << policy.error() << '\n';
+            return thermos::rcInvalidParameter;
+          }
+          retention = policy.value();
+          // Skip next parameter, because it's already used as retention.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter a retention after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if retention
+      else if ((param == "--sqlite") || (param == "-s"))
+      {
+        if (connection.has_value())
+        {
+          std::cerr << "Error: SQLite options were already set!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const auto opts = thermos::sqlite::options::parse(std::string(argv[i+1]), thermos::sqlite::options::for_writing());
+          if (!opts.has_value())
+          {
+            std::cerr << "Error: " << opts.error() << '\n';
+            return thermos::rcInvalidParameter;
+          }
+          if (opts.value().read_only || opts.value().immutable)
+          {
+            std::cerr << "Error: The logger has to write to the database, so "
+                      << "read_only and immutable cannot be used.\n";
+            return thermos::rcInvalidParameter;
+          }
+          connection = opts.value();
+          // Skip next parameter, because it's already used as options.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter SQLite options after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if SQLite options
+      else if ((param == "--queue-size") || (param == "-q"))
+      {
+        if (queueSize.has_value())
+        {
+          std::cerr << "Error: Queue size was already set to "
+                    << queueSize.value() << "!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const std::string_view value(argv[i+1]);
+          std::size_t number = 0;
+          const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+          if ((ec != std::errc()) || (ptr != value.data() + value.size())
+              || (number < 1) || (number > 100000))
+          {
+            std::cerr << "Error: \"" << value << "\" is not a valid queue size."
+                      << " It has to be an integer between 1 and 100000.\n";
+            return thermos::rcInvalidParameter;
+          }
+          queueSize = number;
+          // Skip next parameter, because it's already used as number.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter a number after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if queue size
+      else if ((param == "--overflow") || (param == "-o"))
+      {
+        if (overflow.has_value())
+        {
+          std::cerr << "Error: Overflow policy was already set to "
+                    << thermos::to_string(overflow.value()) << "!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          overflow = thermos::parse_overflow_policy(std::string(argv[i+1]));
+          if (!overflow.has_value())
+          {
+            std::cerr << "Error: '" << std::string(argv[i+1]) << "' is not a "
+                      << "valid overflow policy.\nAllowed policies are:\n"
+                      << "\t" << thermos::to_string(thermos::overflow_policy::block)
+                      << "\n\t" << thermos::to_string(thermos::overflow_policy::drop_oldest)
+                      << "\n\t" << thermos::to_string(thermos::overflow_policy::spill)
+                      << "\nPlease use one of them.\n";
+            return thermos::rcInvalidParameter;
+          }
+          // Skip next parameter, because it's already used as policy.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter an overflow policy after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if overflow policy
+      else if ((param == "--interval") || (param == "-i"))
+      {
+        if (interval.has_value())
+        {
+          std::cerr << "Error: Interval was already set to "
+                    << interval.value().count() << " ms!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          const auto parsed = thermos::parse_interval(std::string(argv[i+1]));
+          if (!parsed.has_value())
+          {
+            std::cerr << "Error: " << parsed.error() << '\n';
+            return thermos::rcInvalidParameter;
+          }
+          interval = parsed.value();
+          // Skip next parameter, because it's already used as interval.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter an interval after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if interval
+      else if ((param == "--catch-up") || (param == "-c"))
+      {
+        if (catchUp.has_value())
+        {
+          std::cerr << "Error: Catch-up policy was already set to "
+                    << thermos::to_string(catchUp.value()) << "!\n";
+          return thermos::rcInvalidParameter;
+        }
+        // enough parameters?
+        if ((i+1 < argc) && (argv[i+1] != nullptr))
+        {
+          catchUp = thermos::parse_catch_up_policy(std::string(argv[i+1]));
+          if (!catchUp.has_value())
+          {
+            std::cerr << "Error: '" << std::string(argv[i+1]) << "' is not a "
+                      << "valid catch-up policy.\nAllowed policies are:\n"
+                      << "\t" << thermos::to_string(thermos::catch_up_policy::skip)
+                      << "\n\t" << thermos::to_string(thermos::catch_up_policy::burst)
+                      << "\nPlease use one of them.\n";
+            return thermos::rcInvalidParameter;
+          }
+          // Skip next parameter, because it's already used as policy.
+          ++i;
+        }
+        else
+        {
+          std::cerr << "Error: You have to enter a catch-up policy after \""
+                    << param << "\".\n";
+          return thermos::rcInvalidParameter;
+        }
+      } // if catch-up policy
       else
       {
         std::cerr << "Error: Unknown parameter " << param << "!\n"
@@ -194,7 +439,32 @@ int main(int argc, char** argv)
     fileType = defaultFileType;
   }
 
-  thermos::Logger logger(logFile, fileType.value());
+  if (retention.has_value() && (fileType.value() != thermos::storage::type::db))
+  {
+    std::cerr << "Error: A retention can only be used with the file type "
+              << thermos::storage::type::db << ".\n";
+    return thermos::rcInvalidParameter;
+  }
+
+  if (connection.has_value() && (fileType.value() != thermos::storage::type::db))
+  {
+    std::cerr << "Error: SQLite options can only be used with the file type "
+              << thermos::storage::type::db << ".\n";
+    return thermos::rcInvalidParameter;
+  }
+
+  thermos::write_queue_settings queue;
+  queue.capacity = queueSize.value_or(queue.capacity);
+  queue.overflow = overflow.value_or(queue.overflow);
+
+  thermos::schedule_settings schedule;
+  schedule.interval = interval.value_or(schedule.interval);
+  schedule.catch_up = catchUp.value_or(schedule.catch_up);
+
+  thermos::Logger logger(logFile, fileType.value(),
+                         retention.value_or(thermos::storage::retention_policy()),
+                         connection.value_or(thermos::sqlite::options::for_writing()),
+                         queue, schedule);
   const auto opt = logger.log();
   if (opt.has_value())
   {
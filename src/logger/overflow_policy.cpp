@@ -0,0 +1,49 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "overflow_policy.hpp"
+#include <stdexcept>
+#include "parse_name.hpp"
+
+namespace thermos
+{
+
+std::string to_string(const overflow_policy policy)
+{
+  switch (policy)
+  {
+    case overflow_policy::block:
+         return "block";
+    case overflow_policy::drop_oldest:
+         return "drop-oldest";
+    case overflow_policy::spill:
+         return "spill";
+    default:
+         throw std::invalid_argument("Invalid overflow_policy value in to_string!");
+  }
+}
+
+std::optional<overflow_policy> parse_overflow_policy(const std::string& name)
+{
+  return parse_name(name, { overflow_policy::block, overflow_policy::drop_oldest,
+                            overflow_policy::spill });
+}
+
+} // namespace
@@ -0,0 +1,66 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_LOGGER_OVERFLOW_POLICY_HPP
+#define THERMOS_LOGGER_OVERFLOW_POLICY_HPP
+
+#include <optional>
+#include <string>
+
+namespace thermos
+{
+
+/** \brief What the logger does with a new sample when its write queue is full.
+ *
+ * The queue only fills up when writing to the file is slower than taking
+ * the readings, e. g. because of a slow disk or because another program
+ * holds a lock on the database.
+ */
+enum class overflow_policy
+{
+  /// wait until the writer has made room, delays the next readings
+  block,
+
+  /// drop the oldest readings in the queue
+  drop_oldest,
+
+  /// write new readings to a file, from which the writer reads them back later
+  spill
+};
+
+/** \brief Converts an overflow_policy to a string.
+ *
+ * \param policy   the overflow policy
+ * \return Returns a string that identifies the policy.
+ */
+std::string to_string(const overflow_policy policy);
+
+/** \brief Parses an overflow policy from its name.
+ *
+ * \param name   name of the policy as used by the option --overflow, i. e.
+ *               "block", "drop-oldest" or "spill"
+ * \return Returns the policy, if the name is known.
+ *         Returns an empty optional otherwise.
+ */
+std::optional<overflow_policy> parse_overflow_policy(const std::string& name);
+
+} // namespace
+
+#endif // THERMOS_LOGGER_OVERFLOW_POLICY_HPP
@@ -0,0 +1,54 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_LOGGER_PARSE_NAME_HPP
+#define THERMOS_LOGGER_PARSE_NAME_HPP
+
+#include <initializer_list>
+#include <optional>
+#include <string>
+
+namespace thermos
+{
+
+/** \brief Finds the enumeration value with a given name.
+ *
+ * \param name     the name to look for, it has to match exactly
+ * \param values   all values of the enumeration; to_string() has to be
+ *                 defined for them
+ * \return Returns the value whose to_string() is equal to name.
+ *         Returns an empty optional, if there is no such value.
+ */
+template<typename enum_t>
+std::optional<enum_t> parse_name(const std::string& name, const std::initializer_list<enum_t> values)
+{
+  for (const auto value: values)
+  {
+    if (name == to_string(value))
+    {
+      return value;
+    }
+  }
+  return std::nullopt;
+}
+
+} // namespace
+
+#endif // THERMOS_LOGGER_PARSE_NAME_HPP
@@ -0,0 +1,198 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "scheduler.hpp"
+#include <charconv>
+#if defined(__linux__) || defined(linux)
+#include <cerrno>
+#include <ctime>
+#else
+#include <thread>
+#endif
+
+namespace thermos
+{
+
+std::chrono::nanoseconds schedule_statistics::mean_jitter() const
+{
+  if (cycles == 0)
+  {
+    return std::chrono::nanoseconds::zero();
+  }
+  return total_jitter / cycles;
+}
+
+scheduler::scheduler(const clock::duration interval, const catch_up_policy policy,
+                     const clock::time_point start)
+: period(interval),
+  catch_up(policy),
+  next_deadline(start),
+  last_missed(start),
+  stats(schedule_statistics())
+{
+}
+
+uint64_t scheduler::wait()
+{
+  const auto missed = advance(clock::now());
+  if (next_deadline <= last_missed)
+  {
+    // Catching up with a deadline that has already passed: There is nothing
+    // to wait for and the delay has already been counted as missed deadline.
+    return missed;
+  }
+  sleep_until(next_deadline);
+
+  const auto jitter = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - next_deadline);
+  ++stats.cycles;
+  if (jitter > std::chrono::nanoseconds::zero())
+  {
+    stats.total_jitter += jitter;
+    if (jitter > stats.max_jitter)
+    {
+      stats.max_jitter = jitter;
+    }
+  }
+  return missed;
+}
+
+uint64_t scheduler::advance(const clock::time_point now)
+{
+  const auto next = next_deadline + period;
+  if (now < next)
+  {
+    next_deadline = next;
+    return 0;
+  }
+
+  // The previous cycle overran: next and possibly further deadlines passed.
+  const uint64_t passed = (now - next) / period + 1;
+  // During a burst the same deadlines pass again on each call, so only those
+  // after the latest deadline that was already counted are new.
+  const auto latest = next + static_cast<clock::duration::rep>(passed - 1) * period;
+  uint64_t newly_missed = passed;
+  if (latest <= last_missed)
+  {
+    newly_missed = 0;
+  }
+  else if (next <= last_missed)
+  {
+    newly_missed = (latest - last_missed) / period;
+  }
+  if (latest > last_missed)
+  {
+    last_missed = latest;
+  }
+  stats.missed += newly_missed;
+  switch (catch_up)
+  {
+    case catch_up_policy::burst:
+         // Deadlines are still taken one by one, but without waiting.
+         next_deadline = next;
+         break;
+    case catch_up_policy::skip:
+    default:
+         // Continue with the first deadline that lies in the future.
+         next_deadline = next + static_cast<clock::duration::rep>(passed) * period;
+         break;
+  }
+  return newly_missed;
+}
+
+scheduler::clock::time_point scheduler::deadline() const
+{
+  return next_deadline;
+}
+
+scheduler::clock::duration scheduler::interval() const
+{
+  return period;
+}
+
+const schedule_statistics& scheduler::statistics() const
+{
+  return stats;
+}
+
+void scheduler::sleep_until(const clock::time_point time_point)
+{
+  #if defined(__linux__) || defined(linux)
+  // std::chrono::steady_clock uses CLOCK_MONOTONIC on Linux, so its time
+  // points can be passed to clock_nanosleep() as they are. The absolute
+  // time avoids drift caused by the time spent between now() and the call.
+  const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch());
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(seconds.count());
+  ts.tv_nsec = static_cast<long>((since_epoch - seconds).count());
+  // Interruptions by signals just continue the wait for the same time.
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+  {
+  }
+  #else
+  std::this_thread::sleep_until(time_point);
+  #endif
+}
+
+nonstd::expected<std::chrono::milliseconds, std::string> parse_interval(const std::string& text)
+{
+  const auto digits_end = text.find_first_not_of("0123456789");
+  const std::string unit = (digits_end == std::string::npos) ? "" : text.substr(digits_end);
+
+  int64_t ms_per_unit = 0;
+  if (unit == "ms")
+  {
+    ms_per_unit = 1;
+  }
+  else if ((unit == "s") || unit.empty())
+  {
+    ms_per_unit = 1000;
+  }
+  else if (unit == "m")
+  {
+    ms_per_unit = 60 * 1000;
+  }
+  else if (unit == "h")
+  {
+    ms_per_unit = 3600 * 1000;
+  }
+  else
+  {
+    return nonstd::make_unexpected("'" + text + "' has no valid unit. "
+        + "Allowed units are ms (milliseconds), s (seconds), m (minutes) and h (hours).");
+  }
+
+  int64_t count = 0;
+  const char* first = text.data();
+  const char* last = text.data() + text.size() - unit.size();
+  const auto [ptr, ec] = std::from_chars(first, last, count);
+  constexpr int64_t min_ms = 10;
+  constexpr int64_t max_ms = 24 * 3600 * 1000;
+  if ((ec != std::errc()) || (ptr != last) || (count > max_ms / ms_per_unit)
+      || (count * ms_per_unit < min_ms))
+  {
+    return nonstd::make_unexpected("'" + text + "' is not a valid interval. "
+        + "The interval has to be between 10 ms and 24 h.");
+  }
+
+  return std::chrono::milliseconds(count * ms_per_unit);
+}
+
+} // namespace
@@ -0,0 +1,132 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_LOGGER_SCHEDULER_HPP
+#define THERMOS_LOGGER_SCHEDULER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "../../third-party/nonstd/expected.hpp"
+#include "catch_up_policy.hpp"
+
+namespace thermos
+{
+
+/// statistics about how well a scheduler met its deadlines
+struct schedule_statistics
+{
+  uint64_t cycles = 0; /**< number of deadlines that have been waited for, without catch-up cycles */
+  uint64_t missed = 0; /**< number of deadlines that had already passed when the previous cycle ended, each counted once */
+  std::chrono::nanoseconds max_jitter = std::chrono::nanoseconds::zero(); /**< largest delay between a deadline and the wake-up */
+  std::chrono::nanoseconds total_jitter = std::chrono::nanoseconds::zero(); /**< sum of all delays */
+
+  /** \brief Gets the average delay between a deadline and the wake-up.
+   *
+   * \return Returns the mean jitter, or zero if there were no cycles yet.
+   */
+  std::chrono::nanoseconds mean_jitter() const;
+};
+
+/** \brief Wakes up the calling thread in fixed intervals.
+ *
+ * The deadlines are absolute points in time that are multiples of the
+ * interval after the start, so delays of single wake-ups do not add up over
+ * time. On Linux the thread sleeps via clock_nanosleep() with an absolute
+ * time on the monotonic clock.
+ */
+class scheduler
+{
+  public:
+    typedef std::chrono::steady_clock clock;
+
+    /** \brief Creates a new scheduler.
+     *
+     * \param interval   time between two deadlines, must be positive
+     * \param policy     what happens when a cycle took longer than the interval
+     * \param start      the first deadline
+     */
+    scheduler(const clock::duration interval, const catch_up_policy policy,
+              const clock::time_point start = clock::now());
+
+    /** \brief Waits until the next deadline.
+     *
+     * \return Returns the number of deadlines that had already passed, when
+     *         this method was called, and that were not reported before.
+     *         Depending on the catch-up policy those have either been skipped
+     *         or this method returns immediately until the scheduler has
+     *         caught up again. Such catch-up cycles are not part of the
+     *         statistics about cycles and jitter.
+     */
+    uint64_t wait();
+
+    /** \brief Moves to the next deadline without waiting.
+     *
+     * \param now   the current time
+     * \return Returns the number of deadlines that had already passed at the
+     *         given time. Deadlines that were already counted by an earlier
+     *         call are not counted again.
+     */
+    uint64_t advance(const clock::time_point now);
+
+    /** \brief Gets the current deadline.
+     *
+     * \return Returns the deadline of the current cycle.
+     */
+    clock::time_point deadline() const;
+
+    /** \brief Gets the interval between two deadlines.
+     *
+     * \return Returns the interval.
+     */
+    clock::duration interval() const;
+
+    /** \brief Gets the statistics of the deadlines so far.
+     *
+     * \return Returns the statistics.
+     */
+    const schedule_statistics& statistics() const;
+  private:
+    /** \brief Blocks the calling thread until the given point in time.
+     *
+     * \param time_point   the point in time to wait for
+     */
+    static void sleep_until(const clock::time_point time_point);
+
+    clock::duration period;
+    catch_up_policy catch_up;
+    clock::time_point next_deadline;
+    clock::time_point last_missed; /**< latest deadline counted as missed */
+    schedule_statistics stats;
+}; // class
+
+/** \brief Parses a sampling interval.
+ *
+ * \param text   the interval, a number followed by one of the units ms
+ *               (milliseconds), s (seconds), m (minutes) or h (hours),
+ *               e. g. "100ms" or "5m"; a number without unit means seconds
+ * \return Returns the interval in case of success.
+ *         Returns an error message, if the text is not a valid interval.
+ */
+nonstd::expected<std::chrono::milliseconds, std::string> parse_interval(const std::string& text);
+
+} // namespace
+
+#endif // THERMOS_LOGGER_SCHEDULER_HPP
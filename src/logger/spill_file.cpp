@@ -0,0 +1,205 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "spill_file.hpp"
+#include <filesystem>
+#include <fstream>
+#include "../../lib/storage/utilities.hpp"
+
+namespace thermos
+{
+
+namespace
+{
+
+// Samples are stored as the number of temperature and of CPU load readings,
+// followed by the readings. Each reading consists of device name, device
+// origin, time in seconds since the Unix epoch and value. Strings are
+// prefixed by their length. Numbers use the native byte order, because the
+// file is only read on the same machine.
+
+void write_u32(std::ofstream& stream, const uint32_t number)
+{
+  stream.write(reinterpret_cast<const char*>(&number), sizeof(number));
+}
+
+void write_i64(std::ofstream& stream, const int64_t number)
+{
+  stream.write(reinterpret_cast<const char*>(&number), sizeof(number));
+}
+
+void write_string(std::ofstream& stream, const std::string& text)
+{
+  write_u32(stream, static_cast<uint32_t>(text.size()));
+  stream.write(text.data(), text.size());
+}
+
+template<typename read_t>
+void write_readings(std::ofstream& stream, const std::vector<device_reading<read_t>>& readings)
+{
+  for (const auto& dr: readings)
+  {
+    const auto& dev = device_registry::get(dr.dev);
+    write_string(stream, dev.name);
+    write_string(stream, dev.origin);
+    write_i64(stream, storage::time_to_epoch(dr.reading.time));
+    write_i64(stream, dr.reading.value);
+  }
+}
+
+template<typename number_t>
+bool read_number(std::ifstream& stream, number_t& number)
+{
+  return static_cast<bool>(stream.read(reinterpret_cast<char*>(&number), sizeof(number)));
+}
+
+bool read_string(std::ifstream& stream, std::string& text)
+{
+  uint32_t length = 0;
+  if (!read_number(stream, length))
+  {
+    return false;
+  }
+  text.resize(length);
+  return static_cast<bool>(stream.read(text.data(), length));
+}
+
+template<typename read_t>
+bool read_readings(std::ifstream& stream, const uint32_t count, std::vector<device_reading<read_t>>& readings)
+{
+  std::string name;
+  std::string origin;
+  int64_t epoch = 0;
+  device_reading<read_t> dr;
+  for (uint32_t i = 0; i < count; ++i)
+  {
+    if (!read_string(stream, name) || !read_string(stream, origin)
+        || !read_number(stream, epoch) || !read_number(stream, dr.reading.value))
+    {
+      return false;
+    }
+    dr.dev = device_registry::intern(device(name, origin));
+    dr.reading.time = storage::epoch_to_time(epoch);
+    readings.push_back(dr);
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+spill_file::spill_file(const std::string& file_name)
+: path(file_name),
+  written(0),
+  read_offset(0)
+{
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (!error)
+  {
+    written = size;
+  }
+}
+
+const std::string& spill_file::name() const
+{
+  return path;
+}
+
+bool spill_file::pending() const
+{
+  return read_offset < written;
+}
+
+std::optional<std::string> spill_file::append(const std::vector<thermal::device_reading>& thermal,
+                                              const std::vector<load::device_reading>& load)
+{
+  std::ofstream stream(path, std::ios_base::out | std::ios_base::binary | std::ios_base::app);
+  if (!stream.good())
+  {
+    return "Failed to create or open file " + path + ".";
+  }
+  write_u32(stream, static_cast<uint32_t>(thermal.size()));
+  write_u32(stream, static_cast<uint32_t>(load.size()));
+  write_readings(stream, thermal);
+  write_readings(stream, load);
+  stream.close();
+  std::error_code error;
+  const auto size = std::filesystem::file_size(path, error);
+  if (!stream.good() || error)
+  {
+    return "Writing to " + path + " failed.";
+  }
+  written = size;
+  return std::nullopt;
+}
+
+nonstd::expected<std::size_t, std::string> spill_file::take(const std::size_t max_samples,
+                                                            std::vector<thermal::device_reading>& thermal,
+                                                            std::vector<load::device_reading>& load)
+{
+  if (!pending())
+  {
+    return 0;
+  }
+  std::ifstream stream(path, std::ios_base::in | std::ios_base::binary);
+  if (!stream.good())
+  {
+    return nonstd::make_unexpected("Failed to open file " + path + ".");
+  }
+  stream.seekg(static_cast<std::streamoff>(read_offset));
+
+  std::size_t samples = 0;
+  bool complete = true;
+  while ((samples < max_samples) && (read_offset < written))
+  {
+    const auto thermal_size = thermal.size();
+    const auto load_size = load.size();
+    uint32_t thermal_count = 0;
+    uint32_t load_count = 0;
+    complete = read_number(stream, thermal_count) && read_number(stream, load_count)
+        && read_readings(stream, thermal_count, thermal) && read_readings(stream, load_count, load);
+    if (!complete)
+    {
+      // Drop the readings of the incomplete sample.
+      thermal.resize(thermal_size);
+      load.resize(load_size);
+      break;
+    }
+    read_offset = static_cast<uintmax_t>(stream.tellg());
+    ++samples;
+  }
+
+  if (!complete || (read_offset >= written))
+  {
+    // Everything has been read, so the file can start from scratch.
+    stream.close();
+    std::error_code error;
+    std::filesystem::remove(path, error);
+    if (error)
+    {
+      return nonstd::make_unexpected("Failed to remove file " + path + ".");
+    }
+    written = 0;
+    read_offset = 0;
+  }
+  return samples;
+}
+
+} // namespace
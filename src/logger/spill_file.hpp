@@ -0,0 +1,99 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_LOGGER_SPILL_FILE_HPP
+#define THERMOS_LOGGER_SPILL_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../lib/load/reading.hpp"
+#include "../../lib/thermal/reading.hpp"
+#include "../../third-party/nonstd/expected.hpp"
+
+namespace thermos
+{
+
+/** \brief File that holds samples of readings which did not fit into the
+ * write queue, until the writer thread reads them back.
+ *
+ * Samples are read back in the order in which they were appended. Readings
+ * are stored together with name and origin of their device, so samples that
+ * were left over by a previous run can be read back, too. The file is
+ * removed as soon as all of its samples have been read. Instances are not
+ * thread-safe.
+ */
+class spill_file
+{
+  public:
+    /** \brief Creates a new instance.
+     *
+     * \param file_name   path of the file; if it exists, its samples are
+     *                    read back before any new ones
+     */
+    explicit spill_file(const std::string& file_name);
+
+    /** \brief Gets the path of the file.
+     *
+     * \return Returns the path of the file.
+     */
+    const std::string& name() const;
+
+    /** \brief Checks whether the file contains samples that have not been
+     *         read back yet.
+     *
+     * \return Returns true, if there are samples left to read.
+     */
+    bool pending() const;
+
+    /** \brief Appends a sample to the file.
+     *
+     * \param thermal   temperature readings of the sample
+     * \param load      CPU load readings of the sample
+     * \return Returns an empty optional, if the sample was written.
+     *         Returns an error message otherwise.
+     */
+    std::optional<std::string> append(const std::vector<thermal::device_reading>& thermal,
+                                      const std::vector<load::device_reading>& load);
+
+    /** \brief Reads the oldest samples that have not been read yet.
+     *
+     * \param max_samples   maximum number of samples to read
+     * \param thermal       vector where the temperature readings are appended
+     * \param load          vector where the CPU load readings are appended
+     * \return Returns the number of samples that have been read.
+     *         Returns an error message, if the file could not be read.
+     * \remarks An incomplete sample at the end of the file, e. g. after a
+     *          crash during append(), is skipped.
+     */
+    nonstd::expected<std::size_t, std::string> take(const std::size_t max_samples,
+                                                    std::vector<thermal::device_reading>& thermal,
+                                                    std::vector<load::device_reading>& load);
+  private:
+    std::string path; /**< path of the file */
+    uintmax_t written; /**< size of the file in bytes */
+    uintmax_t read_offset; /**< position of the first sample that has not been read */
+}; // class
+
+} // namespace
+
+#endif // THERMOS_LOGGER_SPILL_FILE_HPP
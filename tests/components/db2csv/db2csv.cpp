@@ -0,0 +1,138 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include "../../../lib/storage/csv.hpp"
+#include "../../../lib/storage/db.hpp"
+#include "../../../src/db2csv/db2csv.hpp"
+#include "../storage/to_time.hpp"
+
+namespace
+{
+
+std::string read_file(const std::string& file_name)
+{
+  std::ifstream stream(file_name);
+  return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+}
+
+} // anonymous namespace
+
+TEST_CASE("db2csv: csv_name")
+{
+  using namespace thermos;
+
+  SECTION("file does not exist yet")
+  {
+    const auto name = csv_name("db2csv-name-test.db");
+    REQUIRE( std::filesystem::path(name).filename() == "db2csv-name-test.csv" );
+  }
+
+  SECTION("file exists already")
+  {
+    {
+      std::ofstream stream("db2csv-name-test-existing.csv");
+      stream << "data\n";
+    }
+    const auto name = csv_name("db2csv-name-test-existing.db");
+    REQUIRE( std::filesystem::path(name).filename() == "db2csv-name-test-existing_1.csv" );
+    REQUIRE( std::filesystem::remove("db2csv-name-test-existing.csv") );
+  }
+}
+
+TEST_CASE("db2csv: export_csv")
+{
+  using namespace thermos;
+
+  const auto db_file = "db2csv-export.db";
+  {
+    std::vector<thermal::device_reading> thermal_data;
+    thermal::device_reading reading;
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      reading.dev = device_registry::intern(device("sensor " + std::to_string(i % 2), "origin " + std::to_string(i % 2)));
+      reading.reading.value = 40000 + i;
+      reading.reading.time = to_time(2022, 4, 23, 19, i, 17);
+      thermal_data.push_back(reading);
+    }
+    std::vector<load::device_reading> load_data;
+    load::device_reading load_reading;
+    load_reading.dev = device_registry::intern(device("cpu", "/proc/stat"));
+    load_reading.reading.value = 150;
+    load_reading.reading.time = to_time(2022, 4, 23, 19, 5, 0);
+    load_data.push_back(load_reading);
+
+    storage::db store;
+    REQUIRE_FALSE( store.save(thermal_data, db_file).has_value() );
+    REQUIRE_FALSE( store.save(load_data, db_file).has_value() );
+  }
+
+  SECTION("CSV file cannot be opened / created")
+  {
+    const auto rows = export_csv(db_file, "/path/may-not/exist/for-real.csv", nullptr);
+    REQUIRE_FALSE( rows.has_value() );
+    REQUIRE( rows.error().find("Failed to create or open file") != std::string::npos );
+  }
+
+  SECTION("normal export")
+  {
+    const auto csv_file = "db2csv-export.csv";
+    const auto rows = export_csv(db_file, csv_file, nullptr);
+    REQUIRE( rows.has_value() );
+    REQUIRE( rows.value() == 7 );
+
+    const std::string expected =
+        "sensor 0;origin 0;temperature;40000;2022-04-23 19:00:17\n"
+        "sensor 0;origin 0;temperature;40002;2022-04-23 19:02:17\n"
+        "sensor 0;origin 0;temperature;40004;2022-04-23 19:04:17\n"
+        "sensor 1;origin 1;temperature;40001;2022-04-23 19:01:17\n"
+        "sensor 1;origin 1;temperature;40003;2022-04-23 19:03:17\n"
+        "sensor 1;origin 1;temperature;40005;2022-04-23 19:05:17\n"
+        "cpu;/proc/stat;load;150;2022-04-23 19:05:00\n";
+    REQUIRE( read_file(csv_file) == expected );
+
+    REQUIRE( std::filesystem::remove(csv_file) );
+  }
+
+  SECTION("export matches CSV storage")
+  {
+    const auto stream_file = "db2csv-export-stream.csv";
+    const auto store_file = "db2csv-export-store.csv";
+    REQUIRE( export_csv(db_file, stream_file, nullptr).has_value() );
+
+    storage::db dbase;
+    storage::csv csv;
+    std::vector<thermal::device_reading> thermal_data;
+    REQUIRE_FALSE( dbase.load(thermal_data, db_file).has_value() );
+    REQUIRE_FALSE( csv.save(thermal_data, store_file).has_value() );
+    std::vector<load::device_reading> load_data;
+    REQUIRE_FALSE( dbase.load(load_data, db_file).has_value() );
+    REQUIRE_FALSE( csv.save(load_data, store_file).has_value() );
+
+    REQUIRE( read_file(stream_file) == read_file(store_file) );
+
+    REQUIRE( std::filesystem::remove(stream_file) );
+    REQUIRE( std::filesystem::remove(store_file) );
+  }
+
+  REQUIRE( std::filesystem::remove(db_file) );
+}
@@ -0,0 +1,153 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+// Benchmark for the CSV export of thermos-db2csv. It is hidden from the
+// default test run, because generating the database takes a while. Run it
+// explicitly via
+//
+//     component_tests "[benchmark]"
+//
+// The number of generated readings defaults to ten million and can be changed
+// via the environment variable THERMOS_BENCHMARK_ROWS. If the environment
+// variable THERMOS_BENCHMARK_LEGACY is set, the benchmark also exports the
+// data the way db2csv did before streaming was used, i. e. by loading all
+// readings into memory first. That needs several gigabytes of memory for
+// the default number of rows.
+
+#include "../find_catch.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+#include "../../../lib/storage/csv.hpp"
+#include "../../../lib/storage/db.hpp"
+#include "../../../src/db2csv/db2csv.hpp"
+
+namespace
+{
+
+std::size_t benchmark_rows()
+{
+  const char* rows = std::getenv("THERMOS_BENCHMARK_ROWS");
+  if (rows == nullptr)
+  {
+    return 10000000;
+  }
+  return static_cast<std::size_t>(std::strtoull(rows, nullptr, 10));
+}
+
+/* Returns the peak resident set size of the process in KiB, or zero if it
+   cannot be determined on the current platform. */
+long peak_rss_kib()
+{
+#if !defined(_WIN32)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+  #if defined(__APPLE__)
+  // macOS reports bytes instead of kilobytes.
+  return usage.ru_maxrss / 1024;
+  #else
+  return usage.ru_maxrss;
+  #endif
+#else
+  return 0;
+#endif
+}
+
+double rows_per_second(const std::size_t rows, const std::chrono::steady_clock::duration elapsed)
+{
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("db2csv: benchmark export", "[.][benchmark]")
+{
+  using namespace thermos;
+
+  const std::size_t rows = benchmark_rows();
+  constexpr std::size_t devices = 25;
+  const auto db_file = "benchmark-db2csv.db";
+
+  // Generate the database within SQLite, so that the readings never have to
+  // be held in memory by the benchmark itself.
+  {
+    storage::db store;
+    // Saving an empty batch just creates the schema.
+    REQUIRE_FALSE( store.save(std::vector<thermal::device_reading>(), db_file).has_value() );
+  }
+  {
+    auto maybe_db = sqlite::database::open(db_file);
+    REQUIRE( maybe_db.has_value() );
+    auto& dbase = maybe_db.value();
+    REQUIRE( dbase.exec("INSERT INTO device (deviceId, origin, name) "
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < "
+        + std::to_string(devices) + ") "
+        "SELECT i, '/sys/class/hwmon/hwmon' || i || '/temp1_input', 'sensor ' || i FROM n;") );
+    REQUIRE( dbase.exec("INSERT INTO reading (deviceId, type, date, value) "
+        "WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i < "
+        + std::to_string(rows) + " - 1) "
+        "SELECT i % " + std::to_string(devices) + " + 1, 'temperature', "
+        "1650000000 + 60 * (i / " + std::to_string(devices) + "), 40000 + i % 1000 FROM n;") );
+  }
+  const long rss_before = peak_rss_kib();
+
+  // streaming export
+  const auto stream_file = "benchmark-db2csv-stream.csv";
+  const auto stream_start = std::chrono::steady_clock::now();
+  const auto exported = export_csv(db_file, stream_file, nullptr);
+  const auto stream_elapsed = std::chrono::steady_clock::now() - stream_start;
+  REQUIRE( exported.has_value() );
+  REQUIRE( exported.value() == rows );
+  const long rss_stream = peak_rss_kib();
+
+  std::cout << "Exporting " << rows << " readings of " << devices << " devices to CSV:\n"
+            << "  peak RSS before export: " << rss_before << " KiB\n"
+            << "  streaming export:       " << rows_per_second(rows, stream_elapsed)
+            << " rows/s, peak RSS " << rss_stream << " KiB\n";
+  REQUIRE( std::filesystem::remove(stream_file) );
+
+  if (std::getenv("THERMOS_BENCHMARK_LEGACY") != nullptr)
+  {
+    // load everything, then write it (previous implementation)
+    const auto legacy_file = "benchmark-db2csv-legacy.csv";
+    const auto legacy_start = std::chrono::steady_clock::now();
+    {
+      storage::db store;
+      storage::csv csv;
+      std::vector<thermal::device_reading> data;
+      REQUIRE_FALSE( store.load(data, db_file).has_value() );
+      REQUIRE_FALSE( csv.save(data, legacy_file).has_value() );
+    }
+    const auto legacy_elapsed = std::chrono::steady_clock::now() - legacy_start;
+    std::cout << "  load, then write:       " << rows_per_second(rows, legacy_elapsed)
+              << " rows/s, peak RSS " << peak_rss_kib() << " KiB\n";
+    REQUIRE( std::filesystem::remove(legacy_file) );
+  }
+
+  REQUIRE( std::filesystem::remove(db_file) );
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -31,6 +31,13 @@ TEST_CASE("device constructor")
     REQUIRE( dev.name.empty() );
     REQUIRE( dev.origin.empty() );
   }
+
+  SECTION("name and origin")
+  {
+    device dev("foo", "bar");
+    REQUIRE( dev.name == "foo" );
+    REQUIRE( dev.origin == "bar" );
+  }
 }
 
 TEST_CASE("device::filled()")
@@ -70,3 +77,39 @@ TEST_CASE("device::filled()")
     }
   }
 }
+
+TEST_CASE("device comparison")
+{
+  using namespace thermos;
+
+  device a;
+  a.name = "foo";
+  a.origin = "bar";
+
+  SECTION("equality")
+  {
+    device b = a;
+    REQUIRE( a == b );
+    REQUIRE_FALSE( a < b );
+    REQUIRE_FALSE( b < a );
+
+    b.name = "other";
+    REQUIRE_FALSE( a == b );
+    b = a;
+    b.origin = "other";
+    REQUIRE_FALSE( a == b );
+  }
+
+  SECTION("ordering by origin first, then by name")
+  {
+    device b;
+    b.name = "aaa";
+    b.origin = "zzz";
+    REQUIRE( a < b );
+    REQUIRE_FALSE( b < a );
+
+    b.origin = a.origin;
+    REQUIRE( b < a );
+    REQUIRE_FALSE( a < b );
+  }
+}
@@ -0,0 +1,106 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "find_catch.hpp"
+#include <thread>
+#include <vector>
+#include "../../lib/device_registry.hpp"
+
+TEST_CASE("device_registry")
+{
+  using namespace thermos;
+
+  SECTION("empty device has reserved handle")
+  {
+    REQUIRE( device_registry::intern(device()) == device_registry::no_device );
+    REQUIRE_FALSE( device_registry::get(device_registry::no_device).filled() );
+  }
+
+  SECTION("same device gets same handle")
+  {
+    const auto handle = device_registry::intern(device("registry foo", "registry bar"));
+    REQUIRE( handle != device_registry::no_device );
+    REQUIRE( device_registry::intern(device("registry foo", "registry bar")) == handle );
+
+    const auto& dev = device_registry::get(handle);
+    REQUIRE( dev.name == "registry foo" );
+    REQUIRE( dev.origin == "registry bar" );
+  }
+
+  SECTION("different devices get different handles")
+  {
+    const auto a = device_registry::intern(device("registry a", "origin"));
+    const auto b = device_registry::intern(device("registry b", "origin"));
+    const auto c = device_registry::intern(device("registry a", "other origin"));
+    REQUIRE( a != b );
+    REQUIRE( a != c );
+    REQUIRE( b != c );
+  }
+
+  SECTION("references stay valid when devices are added")
+  {
+    const auto handle = device_registry::intern(device("registry stable", "origin"));
+    const device& dev = device_registry::get(handle);
+    for (unsigned int i = 0; i < 1000; ++i)
+    {
+      device_registry::intern(device("registry growth " + std::to_string(i), "origin"));
+    }
+    REQUIRE( &dev == &device_registry::get(handle) );
+    REQUIRE( dev.name == "registry stable" );
+  }
+
+  SECTION("unknown handle yields empty device")
+  {
+    const auto unknown = static_cast<device_handle>(device_registry::size() + 100);
+    REQUIRE_FALSE( device_registry::get(unknown).filled() );
+  }
+
+  SECTION("concurrent interning")
+  {
+    constexpr unsigned int thread_count = 4;
+    constexpr unsigned int device_count = 200;
+    std::vector<std::vector<device_handle>> handles(thread_count);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < thread_count; ++t)
+    {
+      threads.emplace_back([&handles, t]()
+      {
+        for (unsigned int i = 0; i < device_count; ++i)
+        {
+          handles[t].push_back(device_registry::intern(device("registry thread " + std::to_string(i), "origin")));
+        }
+      });
+    }
+    for (auto& thread: threads)
+    {
+      thread.join();
+    }
+
+    // All threads must have got the same handle for the same device.
+    for (unsigned int t = 1; t < thread_count; ++t)
+    {
+      REQUIRE( handles[t] == handles[0] );
+    }
+    for (unsigned int i = 0; i < device_count; ++i)
+    {
+      REQUIRE( device_registry::get(handles[0][i]).name == "registry thread " + std::to_string(i) );
+    }
+  }
+}
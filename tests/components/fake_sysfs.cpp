@@ -0,0 +1,101 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "fake_sysfs.hpp"
+#include <fstream>
+#include <string>
+
+namespace
+{
+
+bool write_file(const std::filesystem::path& path, const std::string& content)
+{
+  std::ofstream stream(path, std::ios::out | std::ios::trunc);
+  stream << content << '\n';
+  stream.close();
+  return stream.good();
+}
+
+} // anonymous namespace
+
+int64_t fake_zone_temperature(const unsigned int zone)
+{
+  return 40000 + 100 * static_cast<int64_t>(zone);
+}
+
+int64_t fake_hwmon_temperature(const unsigned int chip, const unsigned int sensor)
+{
+  return 30000 + 1000 * static_cast<int64_t>(chip) + static_cast<int64_t>(sensor);
+}
+
+bool create_fake_sysfs(const std::filesystem::path& root, const unsigned int zones,
+                       const unsigned int chips, const unsigned int sensors)
+{
+  const auto thermal = root / "sys" / "devices" / "virtual" / "thermal";
+  const auto hwmon = root / "sys" / "class" / "hwmon";
+  std::error_code error;
+  std::filesystem::create_directories(thermal, error);
+  if (error)
+    return false;
+  std::filesystem::create_directories(hwmon, error);
+  if (error)
+    return false;
+  std::filesystem::create_directories(root / "proc", error);
+  if (error)
+    return false;
+  if (!write_file(root / "proc" / "loadavg", "0.25 0.50 1.75 1/467 12345"))
+    return false;
+
+  for (unsigned int z = 0; z < zones; ++z)
+  {
+    const auto zone = thermal / ("thermal_zone" + std::to_string(z));
+    if (!std::filesystem::create_directory(zone, error) || error)
+      return false;
+    if (!write_file(zone / "type", "zone " + std::to_string(z))
+        || !write_file(zone / "temp", std::to_string(fake_zone_temperature(z)))
+        || !write_file(zone / "mode", "enabled"))
+      return false;
+  }
+
+  for (unsigned int c = 0; c < chips; ++c)
+  {
+    const auto chip = hwmon / ("hwmon" + std::to_string(c));
+    const auto device = chip / "device";
+    if (!std::filesystem::create_directories(device, error) || error)
+      return false;
+    const auto sensor_directory = (c % 2 == 0) ? chip : device;
+    if (!write_file(chip / "name", "chip" + std::to_string(c))
+        || !write_file(sensor_directory / "fan1_input", "1200")
+        || !write_file(sensor_directory / "in0_input", "1050")
+        || !write_file(sensor_directory / "in0_label", "Vcore"))
+      return false;
+    for (unsigned int s = 1; s <= sensors; ++s)
+    {
+      const auto prefix = "temp" + std::to_string(s);
+      if (!write_file(sensor_directory / (prefix + "_label"), "chip " + std::to_string(c) + " sensor " + std::to_string(s))
+          || !write_file(sensor_directory / (prefix + "_input"), std::to_string(fake_hwmon_temperature(c, s)))
+          || !write_file(sensor_directory / (prefix + "_max"), "100000")
+          || !write_file(sensor_directory / (prefix + "_crit"), "110000"))
+        return false;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,64 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_TEST_FAKE_SYSFS_HPP
+#define THERMOS_TEST_FAKE_SYSFS_HPP
+
+#include <cstdint>
+#include <filesystem>
+
+/** \brief Creates a directory tree that mimics the parts of sysfs and procfs
+ *         that are read by the Linux readers, i. e.
+ *         root/sys/devices/virtual/thermal with thermal zones,
+ *         root/sys/class/hwmon with hardware monitors and root/proc/loadavg.
+ *
+ * \param root      directory in which the tree is created
+ * \param zones     number of thermal zones
+ * \param chips     number of hardware monitors
+ * \param sensors   number of temperature sensors per hardware monitor
+ * \return Returns true, if the tree was created successfully.
+ *         Returns false otherwise.
+ * \remarks Zone z is named "zone z" and has the temperature
+ *          fake_zone_temperature(z). Sensor s of chip c is named "chip c
+ *          sensor s" and has the temperature fake_hwmon_temperature(c, s).
+ *          Sensors of odd chips are placed in the sub directory "device", like
+ *          some kernel versions do. All chips also have some files that are
+ *          not temperatures. The load averages are 0.25, 0.50 and 1.75.
+ */
+bool create_fake_sysfs(const std::filesystem::path& root, const unsigned int zones,
+                       const unsigned int chips, const unsigned int sensors);
+
+/** \brief Gets the temperature of a thermal zone in the fake sysfs tree.
+ *
+ * \param zone   index of the zone
+ * \return Returns the temperature in millidegrees Celsius.
+ */
+int64_t fake_zone_temperature(const unsigned int zone);
+
+/** \brief Gets the temperature of a hardware monitor sensor in the fake
+ *         sysfs tree.
+ *
+ * \param chip     index of the hardware monitor
+ * \param sensor   index of the sensor
+ * \return Returns the temperature in millidegrees Celsius.
+ */
+int64_t fake_hwmon_temperature(const unsigned int chip, const unsigned int sensor);
+
+#endif // THERMOS_TEST_FAKE_SYSFS_HPP
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,7 +19,25 @@
 */
 
 #include "../find_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "../../../lib/sqlite/database.hpp"
 #include "../../../src/graph-generator/generator.hpp"
+#include "graph_data.hpp"
+
+namespace
+{
+
+std::string read_file(const std::filesystem::path& path)
+{
+  std::ifstream stream(path, std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << stream.rdbuf();
+  return content.str();
+}
+
+} // anonymous namespace
 
 TEST_CASE("graph-generator: get_human_readable_span")
 {
@@ -64,3 +82,151 @@ TEST_CASE("graph-generator: get_short_name")
   REQUIRE( get_short_name(std::chrono::hours(2 * 24 * 365 + 24 * 150 + 10 )) == "2y 150d 10h" );
   REQUIRE( get_short_name(std::chrono::hours(3 * 24 * 365)) == "3y" );
 }
+
+TEST_CASE("graph-generator: generate")
+{
+  using namespace thermos;
+
+  const auto db_file = "graph-generator-generate.db";
+  // hourly readings for a bit more than a year
+  REQUIRE( create_graph_database(db_file, 3, 400 * 24, 3600) );
+  const std::filesystem::path directory = "graph-generator-generate";
+  const std::filesystem::path parallel_directory = "graph-generator-generate-parallel";
+  REQUIRE( std::filesystem::create_directory(directory) );
+  REQUIRE( std::filesystem::create_directory(parallel_directory) );
+
+  Template tpl;
+  REQUIRE( tpl.load_from_str(minimal_graph_template()) );
+  REQUIRE_FALSE( generate(db_file, tpl, directory, 1).has_value() );
+  REQUIRE_FALSE( generate(db_file, tpl, parallel_directory, 4).has_value() );
+
+  // Pages have to be identical, no matter how many threads are used. Longer
+  // time spans contain more readings.
+  std::size_t previous_size = 0;
+  for (const std::string name: { "graph_2d.html", "graph_7d.html", "graph_30d.html", "graph_1y.html" })
+  {
+    const auto content = read_file(directory / name);
+    REQUIRE( content.find("name: 'sensor 3'") != std::string::npos );
+    REQUIRE( content.find("name: 'cpu'") != std::string::npos );
+    REQUIRE( content == read_file(parallel_directory / name) );
+    REQUIRE( content.size() > previous_size );
+    previous_size = content.size();
+  }
+
+  REQUIRE( std::filesystem::remove_all(directory) == 5 );
+  REQUIRE( std::filesystem::remove_all(parallel_directory) == 5 );
+  REQUIRE( std::filesystem::remove(db_file) );
+}
+
+TEST_CASE("graph-generator: generate with downsampling")
+{
+  using namespace thermos;
+
+  const auto db_file = "graph-generator-downsampling.db";
+  // hourly readings for a bit more than a year
+  REQUIRE( create_graph_database(db_file, 2, 400 * 24, 3600) );
+  const std::filesystem::path directory = "graph-generator-downsampling";
+  const std::filesystem::path full_directory = "graph-generator-downsampling-full";
+  REQUIRE( std::filesystem::create_directory(directory) );
+  REQUIRE( std::filesystem::create_directory(full_directory) );
+
+  Template tpl;
+  REQUIRE( tpl.load_from_str(minimal_graph_template()) );
+  downsampling reduction;
+  reduction.method = GENERATE(downsampling_method::lttb, downsampling_method::min_max, downsampling_method::average);
+  reduction.points = 100;
+  REQUIRE_FALSE( generate(db_file, tpl, directory, 1, reduction).has_value() );
+  REQUIRE_FALSE( generate(db_file, tpl, full_directory).has_value() );
+
+  // The two days page has less than 100 readings per device, so it is the
+  // same. Pages with more readings get smaller.
+  REQUIRE( read_file(directory / "graph_2d.html") == read_file(full_directory / "graph_2d.html") );
+  for (const std::string name: { "graph_7d.html", "graph_30d.html", "graph_1y.html" })
+  {
+    const auto reduced = read_file(directory / name);
+    REQUIRE( reduced.find("name: 'sensor 2'") != std::string::npos );
+    REQUIRE( reduced.size() < read_file(full_directory / name).size() );
+  }
+
+  REQUIRE( std::filesystem::remove_all(directory) == 5 );
+  REQUIRE( std::filesystem::remove_all(full_directory) == 5 );
+  REQUIRE( std::filesystem::remove(db_file) );
+}
+
+TEST_CASE("graph-generator: min/max downsampling keeps spikes of rollups")
+{
+  using namespace thermos;
+
+  const auto db_file = "graph-generator-spike.db";
+  // one reading every ten minutes for a bit more than a year
+  constexpr int64_t readings = 400 * 24 * 6;
+  REQUIRE( create_graph_database(db_file, 1, readings, 600) );
+  {
+    // A single spike ten days before the end is part of one hourly and one
+    // daily rollup, which otherwise only contain values below 41 °C.
+    auto maybe_db = sqlite::database::open(db_file);
+    REQUIRE( maybe_db.has_value() );
+    REQUIRE( maybe_db.value().exec("INSERT INTO reading (deviceId, type, date, value) VALUES (1, 'temperature', "
+                                   + std::to_string(1650000000 + 600 * (readings - 10 * 144) + 300) + ", 87654);") );
+  }
+  const std::filesystem::path directory = "graph-generator-spike";
+  REQUIRE( std::filesystem::create_directory(directory) );
+
+  Template tpl;
+  REQUIRE( tpl.load_from_str(minimal_graph_template()) );
+  downsampling reduction;
+  reduction.points = 100;
+
+  // The 30 days page uses hourly rollups, the one year page uses daily ones.
+  reduction.method = downsampling_method::min_max;
+  REQUIRE_FALSE( generate(db_file, tpl, directory, 1, reduction).has_value() );
+  REQUIRE( read_file(directory / "graph_30d.html").find("87.65") != std::string::npos );
+  REQUIRE( read_file(directory / "graph_1y.html").find("87.65") != std::string::npos );
+
+  // Averages smooth the spike away.
+  reduction.method = downsampling_method::average;
+  REQUIRE_FALSE( generate(db_file, tpl, directory, 1, reduction).has_value() );
+  REQUIRE( read_file(directory / "graph_30d.html").find("87.65") == std::string::npos );
+  REQUIRE( read_file(directory / "graph_1y.html").find("87.65") == std::string::npos );
+
+  REQUIRE( std::filesystem::remove_all(directory) == 5 );
+  REQUIRE( std::filesystem::remove(db_file) );
+}
+
+TEST_CASE("graph-generator: rollups cover readings deleted by the retention policy")
+{
+  using namespace thermos;
+
+  const auto db_file = "graph-generator-retention.db";
+  // hourly readings for a bit more than a year
+  constexpr int64_t readings = 400 * 24;
+  REQUIRE( create_graph_database(db_file, 1, readings, 3600) );
+  {
+    // The logger keeps raw readings for 14 days, like with --retention raw=14d.
+    // The rollups still contain all readings.
+    auto maybe_db = sqlite::database::open(db_file);
+    REQUIRE( maybe_db.has_value() );
+    REQUIRE( maybe_db.value().exec("DELETE FROM reading WHERE date < "
+                                   + std::to_string(1650000000 + 3600 * (readings - 1 - 14 * 24)) + ";") );
+  }
+  const std::filesystem::path directory = "graph-generator-retention";
+  REQUIRE( std::filesystem::create_directory(directory) );
+
+  Template tpl;
+  REQUIRE( tpl.load_from_str(minimal_graph_template()) );
+  // Without downsampling the pages would use raw readings only.
+  REQUIRE_FALSE( generate(db_file, tpl, directory, 1).has_value() );
+
+  // The two days and seven days pages still use the raw readings. The
+  // longer pages use hourly rollups to cover their whole time span instead
+  // of the 14 days of raw readings, so they have about 30 / 7 and 365 / 30
+  // times as many readings as the next shorter page.
+  const auto week = read_file(directory / "graph_7d.html").size();
+  const auto month = read_file(directory / "graph_30d.html").size();
+  const auto year = read_file(directory / "graph_1y.html").size();
+  REQUIRE( month > 3 * week );
+  REQUIRE( year > 10 * month );
+
+  REQUIRE( std::filesystem::remove_all(directory) == 5 );
+  REQUIRE( std::filesystem::remove(db_file) );
+}
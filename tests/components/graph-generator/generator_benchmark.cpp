@@ -0,0 +1,131 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+// Benchmark for the generation of all graph pages from a database covering a
+// whole year. It is hidden from the default test run, because generating the
+// database takes a while. Run it explicitly via
+//
+//     component_tests "[benchmark]"
+
+#include "../find_catch.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include "../../../lib/storage/db.hpp"
+#include "../../../src/graph-generator/generate_traces.hpp"
+#include "../../../src/graph-generator/generator.hpp"
+#include "graph_data.hpp"
+
+namespace
+{
+
+/** \brief Generates the traces of all devices for each time span with one
+ *         query per time span and reading type, like the generator did before
+ *         it loaded the readings only once for all time spans.
+ *
+ * \param db_file     the database file
+ * \param tpl         a loaded template for graph generation
+ * \param intervals   the time spans
+ * \return Returns the total length of the generated traces.
+ */
+std::size_t generate_per_span(const std::string& db_file, thermos::Template& tpl,
+                              const std::vector<std::chrono::hours>& intervals)
+{
+  using namespace thermos;
+
+  std::size_t length = 0;
+  for (const auto& time_span: intervals)
+  {
+    storage::db the_db;
+    thermal::reading_batch thermal_data;
+    load::reading_batch load_data;
+    REQUIRE_FALSE( the_db.get_latest_readings(thermal_data, db_file, time_span).has_value() );
+    REQUIRE_FALSE( the_db.get_latest_readings(load_data, db_file, time_span).has_value() );
+    for (const auto& range: device_ranges(thermal_data, time_span))
+    {
+      const auto trace = generate_trace(thermal_data, range, tpl, "yaxis: 'y2',");
+      REQUIRE( trace.has_value() );
+      length += trace.value().size();
+    }
+    for (const auto& range: device_ranges(load_data, time_span))
+    {
+      const auto trace = generate_trace(load_data, range, tpl, "");
+      REQUIRE( trace.has_value() );
+      length += trace.value().size();
+    }
+  }
+  return length;
+}
+
+} // anonymous namespace
+
+TEST_CASE("graph-generator: benchmark generate", "[.][benchmark]")
+{
+  using namespace thermos;
+
+  // one reading per minute of eight sensors plus CPU load for one year
+  constexpr unsigned int devices = 8;
+  constexpr int64_t readings = 365 * 24 * 60;
+  const auto db_file = "benchmark-graph-generator.db";
+  REQUIRE( create_graph_database(db_file, devices, readings, 60) );
+  const std::filesystem::path directory = "benchmark-graph-generator";
+  REQUIRE( std::filesystem::create_directory(directory) );
+
+  Template tpl;
+  REQUIRE( tpl.load_from_str(minimal_graph_template()) );
+
+  // one query per time span, traces only (previous implementation)
+  const std::vector<std::chrono::hours> intervals = {
+    std::chrono::hours(48),
+    std::chrono::hours(7 * 24),
+    std::chrono::hours(30 * 24),
+    std::chrono::hours(365 * 24)
+  };
+  const auto single_start = std::chrono::steady_clock::now();
+  REQUIRE( generate_per_span(db_file, tpl, intervals) > 0 );
+  const auto single_elapsed = std::chrono::steady_clock::now() - single_start;
+
+  // one query for all time spans, single thread, including the pages
+  const auto pass_start = std::chrono::steady_clock::now();
+  REQUIRE_FALSE( generate(db_file, tpl, directory).has_value() );
+  const auto pass_elapsed = std::chrono::steady_clock::now() - pass_start;
+
+  // one query for all time spans, one thread per core
+  const unsigned int jobs = std::max(std::thread::hardware_concurrency(), 1u);
+  const auto parallel_start = std::chrono::steady_clock::now();
+  REQUIRE_FALSE( generate(db_file, tpl, directory, jobs).has_value() );
+  const auto parallel_elapsed = std::chrono::steady_clock::now() - parallel_start;
+
+  const double single_ms = std::chrono::duration<double, std::milli>(single_elapsed).count();
+  const double pass_ms = std::chrono::duration<double, std::milli>(pass_elapsed).count();
+  const double parallel_ms = std::chrono::duration<double, std::milli>(parallel_elapsed).count();
+  std::cout << "Generating graphs from " << (devices + 1) * readings << " readings of "
+            << devices + 1 << " devices:\n"
+            << "  one query per time span: " << single_ms << " ms\n"
+            << "  one query for all spans: " << pass_ms << " ms\n"
+            << "  speedup: " << (pass_ms > 0.0 ? single_ms / pass_ms : 0.0) << "\n"
+            << "  " << jobs << " jobs: " << parallel_ms << " ms\n"
+            << "  speedup over one job: " << (parallel_ms > 0.0 ? pass_ms / parallel_ms : 0.0) << "\n";
+
+  REQUIRE( std::filesystem::remove_all(directory) == 5 );
+  REQUIRE( std::filesystem::remove(db_file) );
+}
@@ -0,0 +1,72 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "graph_data.hpp"
+#include <vector>
+#include "../../../lib/sqlite/database.hpp"
+#include "../../../lib/storage/db.hpp"
+
+std::string minimal_graph_template()
+{
+  return "<!--section-start::full-->{{>header}}\n{{>content}}<!--section-end::full-->"
+         "<!--section-start::header--><title>{{title}}</title>{{>scripts}}<!--section-end::header-->"
+         "<!--section-start::link_with_integrity--><link href=\"{{url}}\" integrity=\"{{hash}}\"><!--section-end::link_with_integrity-->"
+         "<!--section-start::script_with_integrity--><script src=\"{{url}}\" integrity=\"{{hash}}\"></script><!--section-end::script_with_integrity-->"
+         "<!--section-start::script--><script src=\"{{url}}\"></script><!--section-end::script-->"
+         "<!--section-start::graph--><div id=\"{{plotId}}\">{{title}}</div>\n{{>traces}}<!--section-end::graph-->"
+         "<!--section-start::trace-->{ x: {{>dates}}, y: {{>values}}, {{>yaxis}} name: '{{name}}' }\n<!--section-end::trace-->"
+         "<!--section-start::navigation--><nav>{{>items}}</nav>\n<!--section-end::navigation-->"
+         "<!--section-start::nav_item--><a class=\"{{active}}\" href=\"{{url}}\">{{name}}</a><!--section-end::nav_item-->";
+}
+
+bool create_graph_database(const std::string& file_name, const unsigned int devices,
+                           const int64_t readings, const int64_t interval)
+{
+  {
+    thermos::storage::db store;
+    // Saving an empty batch just creates the schema.
+    if (store.save(std::vector<thermos::thermal::device_reading>(), file_name).has_value())
+    {
+      return false;
+    }
+  }
+
+  auto maybe_db = thermos::sqlite::database::open(file_name);
+  if (!maybe_db.has_value())
+  {
+    return false;
+  }
+  auto& dbase = maybe_db.value();
+  const std::string count = std::to_string(devices);
+  const std::string total = std::to_string(devices * readings);
+  return dbase.exec("INSERT INTO device (deviceId, origin, name) "
+          "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < " + count + ") "
+          "SELECT i, '/sys/class/hwmon/hwmon' || i || '/temp1_input', 'sensor ' || i FROM n "
+          "UNION ALL SELECT " + count + " + 1, '/proc/stat', 'cpu';")
+      // Each sensor ends an hour before the previous one.
+      && dbase.exec("INSERT INTO reading (deviceId, type, date, value) "
+          "WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i < " + total + " - 1) "
+          "SELECT i % " + count + " + 1, 'temperature', "
+          "1650000000 + " + std::to_string(interval) + " * (i / " + count + ") - 3600 * (i % " + count + "), "
+          "40000 + i % 1000 FROM n;")
+      && dbase.exec("INSERT INTO reading (deviceId, type, date, value) "
+          "WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i < " + std::to_string(readings) + " - 1) "
+          "SELECT " + count + " + 1, 'load', 1650000000 + " + std::to_string(interval) + " * i, i % 1000 FROM n;");
+}
@@ -0,0 +1,47 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#ifndef THERMOS_TEST_GRAPH_DATA_HPP
+#define THERMOS_TEST_GRAPH_DATA_HPP
+
+#include <cstdint>
+#include <string>
+
+/** \brief Gets a minimal template for graph generation that contains all
+ * sections that are required by the generator functions.
+ */
+std::string minimal_graph_template();
+
+/** \brief Creates a database with readings of several devices.
+ *
+ * \param file_name   path of the database file to create
+ * \param devices     number of temperature sensors
+ * \param readings    number of readings per device
+ * \param interval    time between two readings of a device, in seconds
+ * \return Returns true, if the database was created successfully.
+ *         Returns false otherwise.
+ * \remarks Besides the temperature sensors, the database contains a CPU load
+ *          device with the same number of readings. The readings of each
+ *          sensor end at a different time.
+ */
+bool create_graph_database(const std::string& file_name, const unsigned int devices,
+                           const int64_t readings, const int64_t interval);
+
+#endif // THERMOS_TEST_GRAPH_DATA_HPP
@@ -0,0 +1,63 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <atomic>
+#include <vector>
+#include "../../../src/graph-generator/run_parallel.hpp"
+
+TEST_CASE("graph-generator: run_parallel")
+{
+  using namespace thermos;
+
+  SECTION("no tasks")
+  {
+    bool called = false;
+    run_parallel(0, 4, [&called](const std::size_t, const unsigned int) { called = true; });
+    REQUIRE_FALSE( called );
+  }
+
+  SECTION("every task runs exactly once")
+  {
+    const unsigned int jobs = GENERATE(0u, 1u, 3u, 8u);
+    std::vector<std::atomic<int>> runs(100);
+    std::atomic<bool> worker_in_range(true);
+    run_parallel(runs.size(), jobs, [&](const std::size_t task, const unsigned int worker)
+    {
+      ++runs[task];
+      if (worker >= std::max(jobs, 1u))
+      {
+        worker_in_range = false;
+      }
+    });
+    for (const auto& count: runs)
+    {
+      REQUIRE( count == 1 );
+    }
+    REQUIRE( worker_in_range );
+  }
+
+  SECTION("single job runs tasks in order")
+  {
+    std::vector<std::size_t> order;
+    run_parallel(5, 1, [&order](const std::size_t task, const unsigned int) { order.push_back(task); });
+    REQUIRE( order == std::vector<std::size_t>({ 0, 1, 2, 3, 4 }) );
+  }
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -28,7 +28,8 @@ TEST_CASE("load::device_reading constructor")
   SECTION("initial values must be set")
   {
     load::device_reading dev_reading;
-    REQUIRE_FALSE( dev_reading.dev.filled() );
+    REQUIRE( dev_reading.dev == device_registry::no_device );
+    REQUIRE_FALSE( device_registry::get(dev_reading.dev).filled() );
     REQUIRE( dev_reading.reading.value == std::numeric_limits<int64_t>::min() );
     REQUIRE( dev_reading.reading.time == load::reading::reading_time_t() );
   }
@@ -53,7 +54,7 @@ TEST_CASE("load::device_reading::filled()")
     REQUIRE( dev.filled() );
 
     load::device_reading dev_reading;
-    dev_reading.dev = dev;
+    dev_reading.dev = device_registry::intern(dev);
     dev_reading.reading.value = 800;
     dev_reading.reading.time = std::chrono::system_clock::now();
     REQUIRE( dev_reading.filled() );
@@ -69,7 +70,7 @@ TEST_CASE("load::device_reading::filled()")
       dev.name = "foo";
       dev.origin = "bar";
 
-      dev_reading.dev = dev;
+      dev_reading.dev = device_registry::intern(dev);
       REQUIRE_FALSE( dev_reading.filled() );
     }
 
@@ -91,7 +92,7 @@ TEST_CASE("load::device_reading::filled()")
       dev.name = "foo";
       dev.origin = "bar";
 
-      dev_reading.dev = dev;
+      dev_reading.dev = device_registry::intern(dev);
       dev_reading.reading.value = 800;
       REQUIRE_FALSE( dev_reading.filled() );
     }
@@ -102,7 +103,7 @@ TEST_CASE("load::device_reading::filled()")
       dev.name = "foo";
       dev.origin = "bar";
 
-      dev_reading.dev = dev;
+      dev_reading.dev = device_registry::intern(dev);
       dev_reading.reading.time = std::chrono::system_clock::now();
       REQUIRE_FALSE( dev_reading.filled() );
     }
@@ -0,0 +1,107 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/load/read_linux.hpp"
+#if defined(__linux__) || defined(linux)
+#include <fstream>
+#include "../fake_sysfs.hpp"
+
+TEST_CASE("load: read_all on Linux")
+{
+  using namespace thermos;
+  using namespace thermos::linux_like::load;
+
+  SECTION("load averages are read from the root directory")
+  {
+    const std::filesystem::path root = "load-read-linux";
+    REQUIRE( create_fake_sysfs(root, 0, 0, 0) );
+    const auto readings = read_all(root);
+    REQUIRE( readings.has_value() );
+    REQUIRE( readings.value().size() == 3 );
+    REQUIRE( device_registry::get(readings.value()[0].dev).name == "loadavg1" );
+    REQUIRE( readings.value()[0].reading.value == 25 );
+    REQUIRE( device_registry::get(readings.value()[1].dev).name == "loadavg5" );
+    REQUIRE( readings.value()[1].reading.value == 50 );
+    REQUIRE( device_registry::get(readings.value()[2].dev).name == "loadavg15" );
+    REQUIRE( readings.value()[2].reading.value == 175 );
+    REQUIRE( std::filesystem::remove_all(root) > 0 );
+  }
+
+  SECTION("changed content is read by the next call")
+  {
+    const std::filesystem::path root = "load-read-linux-changed";
+    REQUIRE( create_fake_sysfs(root, 0, 0, 0) );
+    REQUIRE( read_proc_loadavg(root).has_value() );
+    {
+      std::ofstream stream(root / "proc" / "loadavg", std::ios::out | std::ios::trunc);
+      stream << "2.00 1.25 0.50 2/470 12400\n";
+    }
+    const auto readings = read_proc_loadavg(root);
+    REQUIRE( readings.has_value() );
+    REQUIRE( readings.value().size() == 3 );
+    REQUIRE( readings.value()[0].reading.value == 200 );
+    REQUIRE( readings.value()[1].reading.value == 125 );
+    REQUIRE( readings.value()[2].reading.value == 50 );
+    REQUIRE( std::filesystem::remove_all(root) > 0 );
+  }
+
+  SECTION("reader keeps the file open and reads changed content")
+  {
+    const std::filesystem::path root = "load-read-linux-reader";
+    REQUIRE( create_fake_sysfs(root, 0, 0, 0) );
+    const auto reader = loadavg_reader::open(root);
+    REQUIRE( reader.has_value() );
+    REQUIRE( reader.value().read().value()[2].reading.value == 175 );
+    {
+      std::ofstream stream(root / "proc" / "loadavg", std::ios::out | std::ios::trunc);
+      stream << "2.00 1.25 0.50 2/470 12400\n";
+    }
+    const auto readings = reader.value().read();
+    REQUIRE( readings.has_value() );
+    REQUIRE( readings.value().size() == 3 );
+    REQUIRE( readings.value()[0].reading.value == 200 );
+    REQUIRE( readings.value()[1].reading.value == 125 );
+    REQUIRE( readings.value()[2].reading.value == 50 );
+    REQUIRE( std::filesystem::remove_all(root) > 0 );
+  }
+
+  SECTION("missing file")
+  {
+    const auto readings = read_proc_loadavg("load-read-linux-does-not-exist");
+    REQUIRE_FALSE( readings.has_value() );
+    REQUIRE( readings.error().find("loadavg") != std::string::npos );
+    REQUIRE_FALSE( loadavg_reader::open("load-read-linux-does-not-exist").has_value() );
+  }
+
+  SECTION("incomplete file")
+  {
+    const std::filesystem::path root = "load-read-linux-incomplete";
+    REQUIRE( create_fake_sysfs(root, 0, 0, 0) );
+    {
+      std::ofstream stream(root / "proc" / "loadavg", std::ios::out | std::ios::trunc);
+      stream << "0.52 0.58\n";
+    }
+    REQUIRE_FALSE( read_proc_loadavg(root).has_value() );
+    REQUIRE( std::filesystem::remove_all(root) > 0 );
+  }
+}
+
+#endif // Linux
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,7 @@
 */
 
 #include "../find_catch.hpp"
+#include <cstring>
 #include "../../../lib/load/reading.hpp"
 
 TEST_CASE("load::reading constructor")
@@ -42,6 +43,29 @@ TEST_CASE("load::reading::type()")
     load::reading reading;
     REQUIRE( reading.type() == reading_type::load );
   }
+
+  SECTION("type is known at compile time")
+  {
+    constexpr reading_type type = load::reading::type();
+    REQUIRE( type == reading_type::load );
+  }
+}
+
+TEST_CASE("load::reading is a plain value")
+{
+  using namespace thermos;
+
+  REQUIRE( std::is_trivially_copyable<load::reading>::value );
+  REQUIRE( sizeof(load::reading) == 16 );
+
+  load::reading original;
+  original.value = 150;
+  original.time = std::chrono::system_clock::now();
+
+  load::reading copy;
+  std::memcpy(&copy, &original, sizeof(original));
+  REQUIRE( copy.value == original.value );
+  REQUIRE( copy.time == original.time );
 }
 
 TEST_CASE("load::reading::percent()")
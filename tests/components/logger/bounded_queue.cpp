@@ -0,0 +1,162 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <memory>
+#include <thread>
+#include <vector>
+#include "../../../src/logger/bounded_queue.hpp"
+
+TEST_CASE("logger: bounded_queue")
+{
+  using namespace thermos;
+
+  SECTION("capacity is at least one")
+  {
+    REQUIRE( bounded_queue<int>(0).capacity() == 1 );
+    REQUIRE( bounded_queue<int>(5).capacity() == 5 );
+  }
+
+  SECTION("elements are removed in the order in which they were added")
+  {
+    bounded_queue<int> queue(4);
+    REQUIRE( queue.push(1) );
+    REQUIRE( queue.push(2) );
+    REQUIRE( queue.push(3) );
+
+    std::vector<int> out;
+    REQUIRE( queue.pop_batch(out, 2) );
+    REQUIRE( out == std::vector<int>{ 1, 2 } );
+    // Wrap around the end of the ring buffer.
+    REQUIRE( queue.push(4) );
+    REQUIRE( queue.push(5) );
+    REQUIRE( queue.push(6) );
+    REQUIRE( queue.pop_batch(out, 10) );
+    REQUIRE( out == std::vector<int>{ 1, 2, 3, 4, 5, 6 } );
+
+    const auto stats = queue.statistics();
+    REQUIRE( stats.depth == 0 );
+    REQUIRE( stats.max_depth == 4 );
+    REQUIRE( stats.pushed == 6 );
+    REQUIRE( stats.dropped == 0 );
+  }
+
+  SECTION("try_push fails when the queue is full")
+  {
+    bounded_queue<std::unique_ptr<int>> queue(2);
+    auto one = std::make_unique<int>(1);
+    auto two = std::make_unique<int>(2);
+    auto three = std::make_unique<int>(3);
+    REQUIRE( queue.try_push(one) );
+    REQUIRE( queue.try_push(two) );
+    REQUIRE_FALSE( queue.try_push(three) );
+    // The element is left untouched, if it was not added.
+    REQUIRE( three != nullptr );
+    REQUIRE( queue.statistics().depth == 2 );
+  }
+
+  SECTION("push_overwrite drops the oldest element")
+  {
+    bounded_queue<int> queue(3);
+    for (int i = 1; i <= 5; ++i)
+    {
+      REQUIRE( queue.push_overwrite(int(i)) );
+    }
+
+    const auto stats = queue.statistics();
+    REQUIRE( stats.depth == 3 );
+    REQUIRE( stats.pushed == 5 );
+    REQUIRE( stats.dropped == 2 );
+
+    std::vector<int> out;
+    REQUIRE( queue.pop_batch(out, 10) );
+    REQUIRE( out == std::vector<int>{ 3, 4, 5 } );
+  }
+
+  SECTION("closed queue")
+  {
+    bounded_queue<int> queue(2);
+    REQUIRE( queue.push(1) );
+    queue.close();
+
+    REQUIRE_FALSE( queue.push(2) );
+    int three = 3;
+    REQUIRE_FALSE( queue.try_push(three) );
+    REQUIRE_FALSE( queue.push_overwrite(4) );
+
+    // Remaining elements can still be removed.
+    std::vector<int> out;
+    REQUIRE( queue.pop_batch(out, 10) );
+    REQUIRE( out == std::vector<int>{ 1 } );
+    REQUIRE_FALSE( queue.pop_batch(out, 10) );
+  }
+
+  SECTION("close wakes up a waiting consumer")
+  {
+    bounded_queue<int> queue(2);
+    std::vector<int> out;
+    bool result = true;
+    std::thread consumer([&]() { result = queue.pop_batch(out, 1); });
+    queue.close();
+    consumer.join();
+    REQUIRE_FALSE( result );
+    REQUIRE( out.empty() );
+  }
+
+  SECTION("close wakes up a waiting producer")
+  {
+    bounded_queue<int> queue(1);
+    REQUIRE( queue.push(1) );
+    bool result = true;
+    std::thread producer([&]() { result = queue.push(2); });
+    queue.close();
+    producer.join();
+    REQUIRE_FALSE( result );
+  }
+
+  SECTION("producer and consumer threads")
+  {
+    constexpr int count = 10000;
+    bounded_queue<int> queue(8);
+    std::thread producer([&queue]()
+    {
+      for (int i = 0; i < count; ++i)
+      {
+        queue.push(int(i));
+      }
+      queue.close();
+    });
+
+    std::vector<int> out;
+    while (queue.pop_batch(out, 3))
+    {
+    }
+    producer.join();
+
+    REQUIRE( out.size() == count );
+    for (int i = 0; i < count; ++i)
+    {
+      REQUIRE( out[i] == i );
+    }
+    const auto stats = queue.statistics();
+    REQUIRE( stats.pushed == count );
+    REQUIRE( stats.max_depth <= 8 );
+  }
+}
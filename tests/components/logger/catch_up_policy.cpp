@@ -0,0 +1,48 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <stdexcept>
+#include "../../../src/logger/catch_up_policy.hpp"
+
+TEST_CASE("logger: catch_up_policy")
+{
+  using namespace thermos;
+
+  SECTION("names of the option --catch-up")
+  {
+    REQUIRE( parse_catch_up_policy("skip") == catch_up_policy::skip );
+    REQUIRE( parse_catch_up_policy("burst") == catch_up_policy::burst );
+    REQUIRE( to_string(catch_up_policy::skip) == "skip" );
+    REQUIRE( to_string(catch_up_policy::burst) == "burst" );
+  }
+
+  SECTION("unknown names")
+  {
+    REQUIRE_FALSE( parse_catch_up_policy("Skip").has_value() );
+    REQUIRE_FALSE( parse_catch_up_policy("bursts").has_value() );
+    REQUIRE_FALSE( parse_catch_up_policy("block").has_value() );
+  }
+
+  SECTION("invalid value")
+  {
+    REQUIRE_THROWS_AS( to_string(static_cast<catch_up_policy>(42)), std::invalid_argument );
+  }
+}
@@ -0,0 +1,51 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <stdexcept>
+#include "../../../src/logger/overflow_policy.hpp"
+
+TEST_CASE("logger: overflow_policy")
+{
+  using namespace thermos;
+
+  SECTION("names of the option --overflow")
+  {
+    REQUIRE( parse_overflow_policy("block") == overflow_policy::block );
+    REQUIRE( parse_overflow_policy("drop-oldest") == overflow_policy::drop_oldest );
+    REQUIRE( parse_overflow_policy("spill") == overflow_policy::spill );
+    REQUIRE( to_string(overflow_policy::block) == "block" );
+    REQUIRE( to_string(overflow_policy::drop_oldest) == "drop-oldest" );
+    REQUIRE( to_string(overflow_policy::spill) == "spill" );
+  }
+
+  SECTION("unknown names")
+  {
+    // The option uses a hyphen instead of the underscore of the enumeration.
+    REQUIRE_FALSE( parse_overflow_policy("drop_oldest").has_value() );
+    REQUIRE_FALSE( parse_overflow_policy("Block").has_value() );
+    REQUIRE_FALSE( parse_overflow_policy("skip").has_value() );
+  }
+
+  SECTION("invalid value")
+  {
+    REQUIRE_THROWS_AS( to_string(static_cast<overflow_policy>(42)), std::invalid_argument );
+  }
+}
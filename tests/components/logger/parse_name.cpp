@@ -0,0 +1,62 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../src/logger/parse_name.hpp"
+
+namespace
+{
+
+enum class colour
+{
+  red,
+  dark_green
+};
+
+std::string to_string(const colour c)
+{
+  return c == colour::red ? "red" : "dark-green";
+}
+
+} // anonymous namespace
+
+TEST_CASE("logger: parse_name")
+{
+  using namespace thermos;
+
+  SECTION("known names")
+  {
+    REQUIRE( parse_name("red", { colour::red, colour::dark_green }) == colour::red );
+    REQUIRE( parse_name("dark-green", { colour::red, colour::dark_green }) == colour::dark_green );
+  }
+
+  SECTION("names have to match exactly")
+  {
+    REQUIRE_FALSE( parse_name("", { colour::red, colour::dark_green }).has_value() );
+    REQUIRE_FALSE( parse_name("Red", { colour::red, colour::dark_green }).has_value() );
+    REQUIRE_FALSE( parse_name("red ", { colour::red, colour::dark_green }).has_value() );
+    REQUIRE_FALSE( parse_name("dark_green", { colour::red, colour::dark_green }).has_value() );
+  }
+
+  SECTION("only the given values are considered")
+  {
+    REQUIRE_FALSE( parse_name("dark-green", { colour::red }).has_value() );
+  }
+}
@@ -0,0 +1,152 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../src/logger/scheduler.hpp"
+
+TEST_CASE("logger: scheduler")
+{
+  using namespace thermos;
+  using namespace std::chrono_literals;
+  using clock = scheduler::clock;
+
+  const auto start = clock::time_point(1000s);
+
+  SECTION("deadlines are multiples of the interval after the start")
+  {
+    scheduler timer(10s, catch_up_policy::skip, start);
+    REQUIRE( timer.interval() == 10s );
+    REQUIRE( timer.deadline() == start );
+
+    // Late calls do not shift the following deadlines.
+    REQUIRE( timer.advance(start + 3s) == 0 );
+    REQUIRE( timer.deadline() == start + 10s );
+    REQUIRE( timer.advance(start + 19s) == 0 );
+    REQUIRE( timer.deadline() == start + 20s );
+    REQUIRE( timer.statistics().missed == 0 );
+  }
+
+  SECTION("skip continues with the next deadline in the future")
+  {
+    scheduler timer(10s, catch_up_policy::skip, start);
+    // Deadlines at 10 s and 20 s have passed.
+    REQUIRE( timer.advance(start + 25s) == 2 );
+    REQUIRE( timer.deadline() == start + 30s );
+    // Exactly at the deadline counts as passed, too.
+    REQUIRE( timer.advance(start + 40s) == 1 );
+    REQUIRE( timer.deadline() == start + 50s );
+    REQUIRE( timer.statistics().missed == 3 );
+  }
+
+  SECTION("burst takes passed deadlines one by one")
+  {
+    scheduler timer(10s, catch_up_policy::burst, start);
+    REQUIRE( timer.advance(start + 25s) == 2 );
+    REQUIRE( timer.deadline() == start + 10s );
+    // The deadline at 20 s has already been counted as missed.
+    REQUIRE( timer.advance(start + 26s) == 0 );
+    REQUIRE( timer.deadline() == start + 20s );
+    // Caught up again.
+    REQUIRE( timer.advance(start + 27s) == 0 );
+    REQUIRE( timer.deadline() == start + 30s );
+    REQUIRE( timer.statistics().missed == 2 );
+  }
+
+  SECTION("burst counts further overruns while catching up")
+  {
+    scheduler timer(10s, catch_up_policy::burst, start);
+    REQUIRE( timer.advance(start + 25s) == 2 );
+    REQUIRE( timer.deadline() == start + 10s );
+    // Meanwhile the deadline at 30 s passed, too.
+    REQUIRE( timer.advance(start + 31s) == 1 );
+    REQUIRE( timer.deadline() == start + 20s );
+    REQUIRE( timer.advance(start + 32s) == 0 );
+    REQUIRE( timer.deadline() == start + 30s );
+    REQUIRE( timer.advance(start + 33s) == 0 );
+    REQUIRE( timer.deadline() == start + 40s );
+    REQUIRE( timer.statistics().missed == 3 );
+  }
+
+  SECTION("catch-up cycles are not part of the jitter statistics")
+  {
+    // Deadlines at 100 ms and 200 ms have already passed.
+    scheduler timer(100ms, catch_up_policy::burst, clock::now() - 250ms);
+    REQUIRE( timer.wait() == 2 );
+    REQUIRE( timer.wait() == 0 );
+    REQUIRE( timer.statistics().cycles == 0 );
+    REQUIRE( timer.statistics().max_jitter == 0ns );
+    // The deadline at 300 ms lies in the future.
+    REQUIRE( timer.wait() == 0 );
+    REQUIRE( timer.statistics().cycles == 1 );
+    REQUIRE( timer.statistics().missed == 2 );
+  }
+
+  SECTION("wait sleeps until the deadlines")
+  {
+    const auto begin = clock::now();
+    scheduler timer(20ms, catch_up_policy::skip, begin);
+    for (int i = 0; i < 3; ++i)
+    {
+      timer.wait();
+      REQUIRE( clock::now() >= timer.deadline() );
+    }
+    REQUIRE( timer.deadline() == begin + 60ms );
+
+    const auto& stats = timer.statistics();
+    REQUIRE( stats.cycles == 3 );
+    REQUIRE( stats.max_jitter >= stats.mean_jitter() );
+    REQUIRE( stats.total_jitter >= stats.max_jitter );
+  }
+
+  SECTION("mean jitter without cycles")
+  {
+    schedule_statistics stats;
+    REQUIRE( stats.mean_jitter() == 0ns );
+  }
+}
+
+TEST_CASE("logger: parse_interval")
+{
+  using namespace thermos;
+  using namespace std::chrono_literals;
+
+  SECTION("valid intervals")
+  {
+    REQUIRE( parse_interval("100ms").value() == 100ms );
+    REQUIRE( parse_interval("10ms").value() == 10ms );
+    REQUIRE( parse_interval("1s").value() == 1s );
+    REQUIRE( parse_interval("300").value() == 300s );
+    REQUIRE( parse_interval("5m").value() == 5min );
+    REQUIRE( parse_interval("24h").value() == 24h );
+  }
+
+  SECTION("invalid intervals")
+  {
+    REQUIRE_FALSE( parse_interval("").has_value() );
+    REQUIRE_FALSE( parse_interval("ms").has_value() );
+    REQUIRE_FALSE( parse_interval("5d").has_value() );
+    REQUIRE_FALSE( parse_interval("1.5s").has_value() );
+    REQUIRE_FALSE( parse_interval("-1s").has_value() );
+    REQUIRE_FALSE( parse_interval("0s").has_value() );
+    REQUIRE_FALSE( parse_interval("9ms").has_value() );
+    REQUIRE_FALSE( parse_interval("25h").has_value() );
+    REQUIRE_FALSE( parse_interval("99999999999999999999s").has_value() );
+  }
+}
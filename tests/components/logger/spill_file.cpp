@@ -0,0 +1,147 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include "../../../lib/storage/utilities.hpp"
+#include "../../../src/logger/spill_file.hpp"
+
+namespace
+{
+
+thermos::thermal::device_reading thermal_reading(const std::string& name, const int64_t epoch, const int64_t value)
+{
+  thermos::thermal::device_reading dr;
+  dr.dev = thermos::device_registry::intern(thermos::device(name, "/sys/class/hwmon/" + name));
+  dr.reading.time = thermos::storage::epoch_to_time(epoch);
+  dr.reading.value = value;
+  return dr;
+}
+
+thermos::load::device_reading load_reading(const int64_t epoch, const int64_t value)
+{
+  thermos::load::device_reading dr;
+  dr.dev = thermos::device_registry::intern(thermos::device("cpu", "/proc/stat"));
+  dr.reading.time = thermos::storage::epoch_to_time(epoch);
+  dr.reading.value = value;
+  return dr;
+}
+
+} // anonymous namespace
+
+TEST_CASE("logger: spill_file")
+{
+  using namespace thermos;
+
+  SECTION("new file has no samples")
+  {
+    spill_file spill("logger-spill-new.spill");
+    REQUIRE( spill.name() == "logger-spill-new.spill" );
+    REQUIRE_FALSE( spill.pending() );
+
+    std::vector<thermal::device_reading> thermal_readings;
+    std::vector<load::device_reading> load_readings;
+    REQUIRE( spill.take(10, thermal_readings, load_readings).value() == 0 );
+    REQUIRE( thermal_readings.empty() );
+    REQUIRE( load_readings.empty() );
+    REQUIRE_FALSE( std::filesystem::exists("logger-spill-new.spill") );
+  }
+
+  SECTION("samples are read back in order")
+  {
+    const auto file_name = "logger-spill-order.spill";
+    spill_file spill(file_name);
+    for (int64_t i = 0; i < 5; ++i)
+    {
+      REQUIRE_FALSE( spill.append({ thermal_reading("sensor 1", 1650000000 + i, 40000 + i),
+                                    thermal_reading("sensor 2", 1650000000 + i, 50000 + i) },
+                                  { load_reading(1650000000 + i, i) }).has_value() );
+    }
+    REQUIRE( spill.pending() );
+
+    std::vector<thermal::device_reading> thermal_readings;
+    std::vector<load::device_reading> load_readings;
+    REQUIRE( spill.take(3, thermal_readings, load_readings).value() == 3 );
+    REQUIRE( thermal_readings.size() == 6 );
+    REQUIRE( load_readings.size() == 3 );
+    REQUIRE( spill.pending() );
+
+    // Samples appended in the meantime come after the remaining ones.
+    REQUIRE_FALSE( spill.append({ thermal_reading("sensor 1", 1650000005, 40005) },
+                                { load_reading(1650000005, 5) }).has_value() );
+    REQUIRE( spill.take(10, thermal_readings, load_readings).value() == 3 );
+    REQUIRE_FALSE( spill.pending() );
+    REQUIRE_FALSE( std::filesystem::exists(file_name) );
+
+    REQUIRE( thermal_readings.size() == 11 );
+    REQUIRE( load_readings.size() == 6 );
+    for (int64_t i = 0; i < 6; ++i)
+    {
+      REQUIRE( load_readings[i].reading.value == i );
+      REQUIRE( storage::time_to_epoch(load_readings[i].reading.time) == 1650000000 + i );
+      REQUIRE( device_registry::get(load_readings[i].dev).name == "cpu" );
+    }
+    REQUIRE( device_registry::get(thermal_readings[0].dev).name == "sensor 1" );
+    REQUIRE( device_registry::get(thermal_readings[1].dev).origin == "/sys/class/hwmon/sensor 2" );
+    REQUIRE( thermal_readings[9].reading.value == 50004 );
+    REQUIRE( thermal_readings[10].reading.value == 40005 );
+  }
+
+  SECTION("samples of a previous run are read back")
+  {
+    const auto file_name = "logger-spill-previous.spill";
+    {
+      spill_file previous(file_name);
+      REQUIRE_FALSE( previous.append({ thermal_reading("sensor 1", 1650000000, 40000) }, {}).has_value() );
+    }
+
+    spill_file spill(file_name);
+    REQUIRE( spill.pending() );
+    std::vector<thermal::device_reading> thermal_readings;
+    std::vector<load::device_reading> load_readings;
+    REQUIRE( spill.take(10, thermal_readings, load_readings).value() == 1 );
+    REQUIRE( thermal_readings.size() == 1 );
+    REQUIRE( thermal_readings[0].reading.value == 40000 );
+    REQUIRE( load_readings.empty() );
+    REQUIRE_FALSE( std::filesystem::exists(file_name) );
+  }
+
+  SECTION("incomplete sample at the end is skipped")
+  {
+    const auto file_name = "logger-spill-incomplete.spill";
+    {
+      spill_file previous(file_name);
+      REQUIRE_FALSE( previous.append({ thermal_reading("sensor 1", 1650000000, 40000) }, {}).has_value() );
+      REQUIRE_FALSE( previous.append({ thermal_reading("sensor 1", 1650000001, 40001) }, {}).has_value() );
+    }
+    // Cut off the value of the last reading.
+    std::filesystem::resize_file(file_name, std::filesystem::file_size(file_name) - 4);
+
+    spill_file spill(file_name);
+    std::vector<thermal::device_reading> thermal_readings;
+    std::vector<load::device_reading> load_readings;
+    REQUIRE( spill.take(10, thermal_readings, load_readings).value() == 1 );
+    REQUIRE( thermal_readings.size() == 1 );
+    REQUIRE( thermal_readings[0].reading.value == 40000 );
+    REQUIRE_FALSE( spill.pending() );
+    REQUIRE_FALSE( std::filesystem::exists(file_name) );
+  }
+}
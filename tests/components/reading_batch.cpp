@@ -0,0 +1,84 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "find_catch.hpp"
+#include "../../lib/load/reading.hpp"
+#include "../../lib/thermal/reading.hpp"
+#include "storage/to_time.hpp"
+
+TEST_CASE("reading_batch")
+{
+  using namespace thermos;
+
+  SECTION("new batch is empty")
+  {
+    thermal::reading_batch batch;
+    REQUIRE( batch.empty() );
+    REQUIRE( batch.size() == 0 );
+  }
+
+  SECTION("columns grow together")
+  {
+    thermal::reading_batch batch;
+    batch.reserve(10);
+    batch.push_back(device_registry::no_device, 1650000000, 42000);
+    batch.push_back(device_registry::no_device, 1650000060, 43000);
+    REQUIRE_FALSE( batch.empty() );
+    REQUIRE( batch.size() == 2 );
+    REQUIRE( batch.devices.size() == 2 );
+    REQUIRE( batch.times.size() == 2 );
+    REQUIRE( batch.values.size() == 2 );
+    REQUIRE( batch.times[1] == 1650000060 );
+    REQUIRE( batch.values[1] == 43000 );
+
+    batch.clear();
+    REQUIRE( batch.empty() );
+    REQUIRE( batch.devices.empty() );
+    REQUIRE( batch.times.empty() );
+  }
+
+  SECTION("readings survive the round trip")
+  {
+    thermal::device_reading reading;
+    reading.dev = device_registry::intern(device("batch sensor", "batch origin"));
+    reading.reading.value = 45678;
+    reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
+
+    thermal::reading_batch batch;
+    batch.push_back(reading);
+    REQUIRE( batch.size() == 1 );
+
+    const auto copy = batch.get(0);
+    REQUIRE( copy.dev == reading.dev );
+    REQUIRE( copy.reading.value == reading.reading.value );
+    REQUIRE( copy.reading.time == reading.reading.time );
+  }
+
+  SECTION("fractions of seconds are discarded")
+  {
+    load::device_reading reading;
+    reading.reading.value = 150;
+    reading.reading.time = to_time(2022, 4, 23, 19, 18, 17) + std::chrono::milliseconds(750);
+
+    load::reading_batch batch;
+    batch.push_back(reading);
+    REQUIRE( batch.get(0).reading.time == to_time(2022, 4, 23, 19, 18, 17) );
+  }
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,7 @@
 */
 
 #include "../find_catch.hpp"
+#include <filesystem>
 #include "../../../lib/sqlite/database.hpp"
 
 #if !defined(THERMOS_NO_SQLITE)
@@ -55,6 +56,107 @@ TEST_CASE("sqlite::database::open")
   }
 }
 
+TEST_CASE("sqlite::database::open with options")
+{
+  using namespace thermos::sqlite;
+
+  const auto query_text = [](database& db, const std::string& sql)
+  {
+    auto stmt = db.prepare(sql);
+    REQUIRE( stmt.has_value() );
+    REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+    return std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.value().ptr(), 0)));
+  };
+
+  const std::string file_name = "sqlite-database-open-options.db";
+
+  SECTION("pragmas are applied")
+  {
+    {
+      options opts;
+      opts.journal = journal_mode::wal;
+      opts.synchronous = synchronous_level::normal;
+      opts.mmap_size = 1048576;
+      opts.cache_size = 4096;
+      opts.busy_timeout = std::chrono::milliseconds(100);
+      auto db = database::open(file_name, opts);
+      REQUIRE( db.has_value() );
+      REQUIRE( query_text(db.value(), "PRAGMA journal_mode;") == "wal" );
+      REQUIRE( query_text(db.value(), "PRAGMA synchronous;") == "1" );
+      REQUIRE( query_text(db.value(), "PRAGMA mmap_size;") == "1048576" );
+      REQUIRE( query_text(db.value(), "PRAGMA cache_size;") == "-4096" );
+      REQUIRE( query_text(db.value(), "PRAGMA busy_timeout;") == "100" );
+      REQUIRE( db.value().exec("CREATE TABLE foo (bar INTEGER);") );
+    }
+
+    // The write-ahead log is a persistent setting of the file.
+    {
+      auto db = database::open(file_name);
+      REQUIRE( db.has_value() );
+      REQUIRE( query_text(db.value(), "PRAGMA journal_mode;") == "wal" );
+    }
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+
+  SECTION("read-only databases cannot be changed")
+  {
+    {
+      auto db = database::open(file_name);
+      REQUIRE( db.has_value() );
+      REQUIRE( db.value().exec("CREATE TABLE foo (bar INTEGER);") );
+    }
+
+    {
+      options opts;
+      opts.read_only = true;
+      auto db = database::open(file_name, opts);
+      REQUIRE( db.has_value() );
+      REQUIRE( db.value().table_exists("foo").value() );
+      REQUIRE_FALSE( db.value().exec("INSERT INTO foo (bar) VALUES (1);") );
+    }
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+
+  SECTION("immutable databases cannot be changed")
+  {
+    // Characters with special meaning in URIs have to be escaped.
+    const std::string special_name = "sqlite-database-immutable %25?#.db";
+    {
+      auto db = database::open(special_name);
+      REQUIRE( db.has_value() );
+      REQUIRE( db.value().exec("CREATE TABLE foo (bar INTEGER);") );
+    }
+
+    {
+      options opts;
+      opts.immutable = true;
+      auto db = database::open(special_name, opts);
+      REQUIRE( db.has_value() );
+      REQUIRE( db.value().table_exists("foo").value() );
+      REQUIRE_FALSE( db.value().exec("INSERT INTO foo (bar) VALUES (1);") );
+    }
+    REQUIRE( std::filesystem::remove(special_name) );
+  }
+
+  SECTION("read-only open does not create missing files")
+  {
+    options opts;
+    opts.read_only = true;
+    const auto db = database::open(file_name, opts);
+    REQUIRE_FALSE( db.has_value() );
+    REQUIRE_FALSE( std::filesystem::exists(file_name) );
+  }
+
+  SECTION("unavailable journal mode is an error")
+  {
+    options opts;
+    opts.journal = journal_mode::wal;
+    const auto db = database::open(":memory:", opts);
+    REQUIRE_FALSE( db.has_value() );
+    REQUIRE( db.error().find("journal mode") != std::string::npos );
+  }
+}
+
 TEST_CASE("sqlite::database::exec")
 {
   using namespace thermos::sqlite;
@@ -159,4 +261,26 @@ TEST_CASE("sqlite::database::table_exists")
     REQUIRE_FALSE( exists.value() );
   }
 }
+
+TEST_CASE("sqlite::database::user_version")
+{
+  using namespace thermos::sqlite;
+
+  SECTION("get and set version")
+  {
+    auto possible_db = database::open(":memory:");
+    REQUIRE( possible_db.has_value() );
+    auto& db = possible_db.value();
+
+    // New databases have version zero.
+    auto version = db.user_version();
+    REQUIRE( version.has_value() );
+    REQUIRE( version.value() == 0 );
+
+    REQUIRE( db.set_user_version(42) );
+    version = db.user_version();
+    REQUIRE( version.has_value() );
+    REQUIRE( version.value() == 42 );
+  }
+}
 #endif // SQLite feature guard
@@ -0,0 +1,135 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/sqlite/options.hpp"
+
+TEST_CASE("sqlite::journal_mode")
+{
+  using namespace thermos::sqlite;
+
+  SECTION("to_string and parse_journal_mode round trip")
+  {
+    for (const auto mode: { journal_mode::delete_journal, journal_mode::truncate,
+                            journal_mode::persist, journal_mode::wal })
+    {
+      REQUIRE( parse_journal_mode(to_string(mode)) == mode );
+    }
+    REQUIRE( to_string(journal_mode::delete_journal) == "delete" );
+    REQUIRE( to_string(journal_mode::wal) == "wal" );
+  }
+
+  SECTION("unknown names")
+  {
+    REQUIRE_FALSE( parse_journal_mode("").has_value() );
+    REQUIRE_FALSE( parse_journal_mode("WAL").has_value() );
+    REQUIRE_FALSE( parse_journal_mode("memory").has_value() );
+  }
+}
+
+TEST_CASE("sqlite::synchronous_level")
+{
+  using namespace thermos::sqlite;
+
+  for (const auto level: { synchronous_level::off, synchronous_level::normal,
+                           synchronous_level::full, synchronous_level::extra })
+  {
+    REQUIRE( parse_synchronous_level(to_string(level)) == level );
+  }
+  REQUIRE_FALSE( parse_synchronous_level("").has_value() );
+  REQUIRE_FALSE( parse_synchronous_level("2").has_value() );
+}
+
+TEST_CASE("sqlite::options")
+{
+  using namespace thermos::sqlite;
+  using namespace std::chrono_literals;
+
+  SECTION("default options keep the defaults of SQLite")
+  {
+    const options opts;
+    REQUIRE_FALSE( opts.journal.has_value() );
+    REQUIRE_FALSE( opts.synchronous.has_value() );
+    REQUIRE_FALSE( opts.mmap_size.has_value() );
+    REQUIRE_FALSE( opts.cache_size.has_value() );
+    REQUIRE( opts.busy_timeout == 0ms );
+    REQUIRE_FALSE( opts.read_only );
+    REQUIRE_FALSE( opts.immutable );
+  }
+
+  SECTION("writers use a write-ahead log")
+  {
+    const auto opts = options::for_writing();
+    REQUIRE( opts.journal == journal_mode::wal );
+    REQUIRE( opts.synchronous == synchronous_level::normal );
+    REQUIRE( opts.busy_timeout > 0ms );
+    REQUIRE_FALSE( opts.read_only );
+  }
+
+  SECTION("readers use memory-mapped I/O and do not write")
+  {
+    const auto opts = options::for_reading();
+    REQUIRE( opts.mmap_size.value_or(0) > 0 );
+    REQUIRE( opts.busy_timeout > 0ms );
+    REQUIRE( opts.read_only );
+  }
+
+  SECTION("parse all entries")
+  {
+    const auto opts = options::parse("journal_mode=wal,synchronous=extra,mmap_size=1048576,cache_size=4096,busy_timeout=250,read_only=true", options());
+    REQUIRE( opts.has_value() );
+    REQUIRE( opts.value().journal == journal_mode::wal );
+    REQUIRE( opts.value().synchronous == synchronous_level::extra );
+    REQUIRE( opts.value().mmap_size == 1048576 );
+    REQUIRE( opts.value().cache_size == 4096 );
+    REQUIRE( opts.value().busy_timeout == 250ms );
+    REQUIRE( opts.value().read_only );
+    REQUIRE_FALSE( opts.value().immutable );
+
+    const auto immutable = options::parse("immutable=true", options());
+    REQUIRE( immutable.has_value() );
+    REQUIRE( immutable.value().immutable );
+  }
+
+  SECTION("entries that are not given are taken from the base")
+  {
+    const auto opts = options::parse("synchronous=full", options::for_writing());
+    REQUIRE( opts.has_value() );
+    REQUIRE( opts.value().journal == journal_mode::wal );
+    REQUIRE( opts.value().synchronous == synchronous_level::full );
+    REQUIRE( opts.value().busy_timeout == options::for_writing().busy_timeout );
+  }
+
+  SECTION("invalid options")
+  {
+    REQUIRE_FALSE( options::parse("", options()).has_value() );
+    REQUIRE_FALSE( options::parse("wal", options()).has_value() );
+    REQUIRE_FALSE( options::parse("journal_mode=", options()).has_value() );
+    REQUIRE_FALSE( options::parse("journal_mode=memory", options()).has_value() );
+    REQUIRE_FALSE( options::parse("synchronous=1", options()).has_value() );
+    REQUIRE_FALSE( options::parse("mmap_size=-1", options()).has_value() );
+    REQUIRE_FALSE( options::parse("cache_size=1k", options()).has_value() );
+    REQUIRE_FALSE( options::parse("busy_timeout=", options()).has_value() );
+    REQUIRE_FALSE( options::parse("read_only=yes", options()).has_value() );
+    REQUIRE_FALSE( options::parse("immutable=1", options()).has_value() );
+    REQUIRE_FALSE( options::parse("page_size=4096", options()).has_value() );
+    REQUIRE_FALSE( options::parse("synchronous=full,", options()).has_value() );
+  }
+}
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -36,4 +36,44 @@ TEST_CASE("sqlite::database::ptr")
     REQUIRE_FALSE( stmt.value().ptr() == nullptr );
   }
 }
+
+TEST_CASE("sqlite::statement::reset")
+{
+  using namespace thermos::sqlite;
+
+  SECTION("statement can be executed again after reset")
+  {
+    auto db = database::open(":memory:");
+    REQUIRE( db.has_value() );
+    auto stmt = db.value().prepare("SELECT @a + 1;");
+    REQUIRE( stmt.has_value() );
+    auto& s = stmt.value();
+
+    REQUIRE( s.bind(1, static_cast<int64_t>(41)) );
+    REQUIRE( sqlite3_step(s.ptr()) == SQLITE_ROW );
+    REQUIRE( sqlite3_column_int64(s.ptr(), 0) == 42 );
+
+    REQUIRE( s.reset() );
+    REQUIRE( s.bind(1, static_cast<int64_t>(99)) );
+    REQUIRE( sqlite3_step(s.ptr()) == SQLITE_ROW );
+    REQUIRE( sqlite3_column_int64(s.ptr(), 0) == 100 );
+  }
+
+  SECTION("reset clears bound parameters")
+  {
+    auto db = database::open(":memory:");
+    REQUIRE( db.has_value() );
+    auto stmt = db.value().prepare("SELECT @a IS NULL;");
+    REQUIRE( stmt.has_value() );
+    auto& s = stmt.value();
+
+    REQUIRE( s.bind(1, static_cast<int64_t>(1)) );
+    REQUIRE( sqlite3_step(s.ptr()) == SQLITE_ROW );
+    REQUIRE( sqlite3_column_int(s.ptr(), 0) == 0 );
+
+    REQUIRE( s.reset() );
+    REQUIRE( sqlite3_step(s.ptr()) == SQLITE_ROW );
+    REQUIRE( sqlite3_column_int(s.ptr(), 0) == 1 );
+  }
+}
 #endif // SQLite feature guard
@@ -0,0 +1,194 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/sqlite/database.hpp"
+#include "../../../lib/sqlite/statement_cache.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+TEST_CASE("sqlite::statement_cache")
+{
+  using namespace thermos::sqlite;
+
+  auto db = database::open(":memory:");
+  REQUIRE( db.has_value() );
+  auto& conn = db.value();
+
+  const auto prepare_raw = [&conn](const std::string& sql)
+  {
+    // Bypass the cache of the connection to get an unmanaged statement.
+    sqlite3* handle = nullptr;
+    {
+      auto stmt = conn.prepare("SELECT 1;");
+      REQUIRE( stmt.has_value() );
+      handle = sqlite3_db_handle(stmt.value().ptr());
+    }
+    sqlite3_stmt* raw = nullptr;
+    REQUIRE( sqlite3_prepare_v2(handle, sql.c_str(), -1, &raw, nullptr) == SQLITE_OK );
+    return raw;
+  };
+
+  SECTION("empty cache")
+  {
+    statement_cache cache(4);
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.capacity() == 4 );
+    REQUIRE( cache.take("SELECT 1;") == nullptr );
+    REQUIRE( cache.hits() == 0 );
+    REQUIRE( cache.misses() == 1 );
+  }
+
+  SECTION("put and take")
+  {
+    statement_cache cache(4);
+    sqlite3_stmt* stmt = prepare_raw("SELECT 2;");
+    cache.put("SELECT 2;", stmt);
+    REQUIRE( cache.size() == 1 );
+
+    REQUIRE( cache.take("SELECT 2;") == stmt );
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.hits() == 1 );
+    REQUIRE( cache.misses() == 0 );
+    // Statement is no longer in the cache.
+    REQUIRE( cache.take("SELECT 2;") == nullptr );
+    REQUIRE( cache.misses() == 1 );
+    sqlite3_finalize(stmt);
+  }
+
+  SECTION("least recently used statement is evicted")
+  {
+    statement_cache cache(2);
+    cache.put("SELECT 1;", prepare_raw("SELECT 1;"));
+    cache.put("SELECT 2;", prepare_raw("SELECT 2;"));
+    cache.put("SELECT 3;", prepare_raw("SELECT 3;"));
+    REQUIRE( cache.size() == 2 );
+
+    REQUIRE( cache.take("SELECT 1;") == nullptr );
+    sqlite3_stmt* two = cache.take("SELECT 2;");
+    REQUIRE( two != nullptr );
+    // Handing the statement back makes it the most recently used one.
+    cache.put("SELECT 2;", two);
+    cache.put("SELECT 4;", prepare_raw("SELECT 4;"));
+    REQUIRE( cache.take("SELECT 3;") == nullptr );
+    REQUIRE( cache.size() == 2 );
+  }
+
+  SECTION("duplicate statements are not cached twice")
+  {
+    statement_cache cache(4);
+    cache.put("SELECT 5;", prepare_raw("SELECT 5;"));
+    cache.put("SELECT 5;", prepare_raw("SELECT 5;"));
+    REQUIRE( cache.size() == 1 );
+  }
+
+  SECTION("capacity of zero disables caching")
+  {
+    statement_cache cache(0);
+    cache.put("SELECT 6;", prepare_raw("SELECT 6;"));
+    REQUIRE( cache.size() == 0 );
+    REQUIRE( cache.take("SELECT 6;") == nullptr );
+  }
+}
+
+TEST_CASE("sqlite::database statement cache")
+{
+  using namespace thermos::sqlite;
+
+  auto db = database::open(":memory:");
+  REQUIRE( db.has_value() );
+  auto& conn = db.value();
+  const auto& cache = conn.cached_statements();
+  REQUIRE( cache.capacity() == database::default_cache_capacity );
+
+  SECTION("same SQL reuses the statement")
+  {
+    sqlite3_stmt* first = nullptr;
+    {
+      auto stmt = conn.prepare("SELECT @a * 2;");
+      REQUIRE( stmt.has_value() );
+      first = stmt.value().ptr();
+    }
+    REQUIRE( cache.misses() == 1 );
+    REQUIRE( cache.hits() == 0 );
+    REQUIRE( cache.size() == 1 );
+
+    auto stmt = conn.prepare("SELECT @a * 2;");
+    REQUIRE( stmt.has_value() );
+    REQUIRE( stmt.value().ptr() == first );
+    REQUIRE( cache.hits() == 1 );
+    REQUIRE( cache.size() == 0 );
+  }
+
+  SECTION("cached statement is reset and has no bindings")
+  {
+    {
+      auto stmt = conn.prepare("SELECT @a IS NULL;");
+      REQUIRE( stmt.has_value() );
+      REQUIRE( stmt.value().bind(1, static_cast<int64_t>(5)) );
+      REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+      REQUIRE( sqlite3_column_int(stmt.value().ptr(), 0) == 0 );
+      // Statement goes back to the cache without being stepped to the end.
+    }
+
+    auto stmt = conn.prepare("SELECT @a IS NULL;");
+    REQUIRE( stmt.has_value() );
+    REQUIRE( cache.hits() == 1 );
+    REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+    REQUIRE( sqlite3_column_int(stmt.value().ptr(), 0) == 1 );
+  }
+
+  SECTION("statements in use at the same time are distinct")
+  {
+    auto one = conn.prepare("SELECT 7;");
+    auto two = conn.prepare("SELECT 7;");
+    REQUIRE( one.has_value() );
+    REQUIRE( two.has_value() );
+    REQUIRE( one.value().ptr() != two.value().ptr() );
+    REQUIRE( cache.misses() == 2 );
+  }
+
+  SECTION("moved statement is handed back only once")
+  {
+    {
+      auto stmt = conn.prepare("SELECT 8;");
+      REQUIRE( stmt.has_value() );
+      statement moved = std::move(stmt.value());
+      REQUIRE( moved.ptr() != nullptr );
+    }
+    REQUIRE( cache.size() == 1 );
+  }
+
+  SECTION("statement outliving its connection is finalized")
+  {
+    auto other = database::open(":memory:");
+    REQUIRE( other.has_value() );
+    auto stmt = other.value().prepare("SELECT 9;");
+    REQUIRE( stmt.has_value() );
+    statement kept = std::move(stmt.value());
+    {
+      // The connection is only closed after the statement has been
+      // finalized, and the statement must not be handed back to the
+      // destroyed cache.
+      database gone = std::move(other.value());
+    }
+    REQUIRE( sqlite3_step(kept.ptr()) == SQLITE_ROW );
+  }
+}
+#endif // SQLite feature guard
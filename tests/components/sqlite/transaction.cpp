@@ -0,0 +1,95 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/sqlite/database.hpp"
+#include "../../../lib/sqlite/transaction.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+namespace
+{
+
+int64_t count_rows(thermos::sqlite::database& db)
+{
+  auto stmt = db.prepare("SELECT COUNT(*) FROM foo;");
+  REQUIRE( stmt.has_value() );
+  REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+  return sqlite3_column_int64(stmt.value().ptr(), 0);
+}
+
+} // anonymous namespace
+
+TEST_CASE("sqlite::transaction")
+{
+  using namespace thermos::sqlite;
+
+  auto possible_db = database::open(":memory:");
+  REQUIRE( possible_db.has_value() );
+  auto& db = possible_db.value();
+  REQUIRE( db.exec("CREATE TABLE foo (fooId INTEGER PRIMARY KEY NOT NULL, blah TEXT NOT NULL);") );
+
+  SECTION("committed changes are kept")
+  {
+    {
+      auto trans = transaction::begin(db);
+      REQUIRE( trans.has_value() );
+      REQUIRE( trans.value().active() );
+      REQUIRE( db.exec("INSERT INTO foo (blah) VALUES ('one');") );
+      REQUIRE( db.exec("INSERT INTO foo (blah) VALUES ('two');") );
+      REQUIRE_FALSE( trans.value().commit().has_value() );
+      REQUIRE_FALSE( trans.value().active() );
+    }
+    REQUIRE( count_rows(db) == 2 );
+  }
+
+  SECTION("changes are rolled back when transaction goes out of scope")
+  {
+    {
+      auto trans = transaction::begin(db);
+      REQUIRE( trans.has_value() );
+      REQUIRE( db.exec("INSERT INTO foo (blah) VALUES ('one');") );
+      REQUIRE( count_rows(db) == 1 );
+    }
+    REQUIRE( count_rows(db) == 0 );
+  }
+
+  SECTION("explicit rollback")
+  {
+    auto trans = transaction::begin(db);
+    REQUIRE( trans.has_value() );
+    REQUIRE( db.exec("INSERT INTO foo (blah) VALUES ('one');") );
+    REQUIRE( trans.value().rollback() );
+    REQUIRE_FALSE( trans.value().active() );
+    REQUIRE( count_rows(db) == 0 );
+
+    // Neither commit nor rollback work on inactive transaction.
+    REQUIRE( trans.value().commit().has_value() );
+    REQUIRE_FALSE( trans.value().rollback() );
+  }
+
+  SECTION("nested transactions are not possible")
+  {
+    auto trans = transaction::begin(db);
+    REQUIRE( trans.has_value() );
+    auto nested = transaction::begin(db);
+    REQUIRE_FALSE( nested.has_value() );
+  }
+}
+#endif // SQLite feature guard
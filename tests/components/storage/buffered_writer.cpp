@@ -0,0 +1,161 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <filesystem>
+#include <fstream>
+#include "../../../lib/storage/buffered_writer.hpp"
+
+TEST_CASE("buffered_writer")
+{
+  using namespace thermos::storage;
+
+  SECTION("file cannot be opened / created")
+  {
+    const auto writer = buffered_writer::open("/path/may-not/exist/for-real.csv");
+    REQUIRE_FALSE( writer.has_value() );
+    REQUIRE( writer.error().find("Failed to create or open file") != std::string::npos );
+  }
+
+  SECTION("write strings, characters and integers")
+  {
+    const auto file_name = "buffered-writer-write.txt";
+    {
+      auto writer = buffered_writer::open(file_name);
+      REQUIRE( writer.has_value() );
+      writer.value().write(std::string_view("foo;"));
+      writer.value().write(static_cast<int64_t>(0));
+      writer.value().write(';');
+      writer.value().write(static_cast<int64_t>(-9223372036854775807 - 1));
+      writer.value().write(';');
+      writer.value().write(static_cast<int64_t>(9223372036854775807));
+      writer.value().write('\n');
+      REQUIRE_FALSE( writer.value().flush().has_value() );
+    }
+
+    std::string line;
+    {
+      std::ifstream stream(file_name);
+      REQUIRE( stream.good() );
+      std::getline(stream, line);
+      REQUIRE( line == "foo;0;-9223372036854775808;9223372036854775807" );
+    }
+
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+
+  SECTION("data larger than the buffer")
+  {
+    const auto file_name = "buffered-writer-large.txt";
+    const std::string long_text(1000, 'x');
+    {
+      auto writer = buffered_writer::open(file_name, 100);
+      REQUIRE( writer.has_value() );
+      for (int64_t i = 0; i < 100; ++i)
+      {
+        writer.value().write(i);
+        writer.value().write('\n');
+      }
+      writer.value().write(std::string_view(long_text));
+      writer.value().write('\n');
+      // Data is flushed by the destructor.
+    }
+
+    std::string line;
+    {
+      std::ifstream stream(file_name);
+      REQUIRE( stream.good() );
+      for (int64_t i = 0; i < 100; ++i)
+      {
+        std::getline(stream, line);
+        REQUIRE( line == std::to_string(i) );
+      }
+      std::getline(stream, line);
+      REQUIRE( line == long_text );
+    }
+
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+
+  SECTION("writer appends to existing file")
+  {
+    const auto file_name = "buffered-writer-append.txt";
+    {
+      auto writer = buffered_writer::open(file_name);
+      REQUIRE( writer.has_value() );
+      writer.value().write(std::string_view("first\n"));
+    }
+    {
+      auto writer = buffered_writer::open(file_name);
+      REQUIRE( writer.has_value() );
+      writer.value().write(std::string_view("second\n"));
+    }
+
+    std::string line;
+    {
+      std::ifstream stream(file_name);
+      REQUIRE( stream.good() );
+      std::getline(stream, line);
+      REQUIRE( line == "first" );
+      std::getline(stream, line);
+      REQUIRE( line == "second" );
+    }
+
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+
+  SECTION("move assignment flushes data of the target")
+  {
+    const auto first_name = "buffered-writer-move-first.txt";
+    const auto second_name = "buffered-writer-move-second.txt";
+    {
+      auto first = buffered_writer::open(first_name);
+      REQUIRE( first.has_value() );
+      first.value().write(std::string_view("first\n"));
+      auto second = buffered_writer::open(second_name);
+      REQUIRE( second.has_value() );
+      second.value().write(std::string_view("second\n"));
+
+      first.value() = std::move(second.value());
+      first.value().write(std::string_view("more\n"));
+    }
+
+    std::string line;
+    {
+      std::ifstream stream(first_name);
+      REQUIRE( stream.good() );
+      std::getline(stream, line);
+      REQUIRE( line == "first" );
+      REQUIRE_FALSE( std::getline(stream, line) );
+    }
+    {
+      std::ifstream stream(second_name);
+      REQUIRE( stream.good() );
+      std::getline(stream, line);
+      REQUIRE( line == "second" );
+      std::getline(stream, line);
+      REQUIRE( line == "more" );
+      REQUIRE_FALSE( std::getline(stream, line) );
+    }
+
+    REQUIRE( std::filesystem::remove(first_name) );
+    REQUIRE( std::filesystem::remove(second_name) );
+  }
+}
@@ -0,0 +1,207 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/storage/compaction.hpp"
+#include "../../../lib/storage/schema.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+namespace
+{
+
+int64_t query_int(thermos::sqlite::database& db, const std::string& sql)
+{
+  auto stmt = db.prepare(sql);
+  REQUIRE( stmt.has_value() );
+  REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+  return sqlite3_column_int64(stmt.value().ptr(), 0);
+}
+
+} // anonymous namespace
+
+TEST_CASE("storage compaction")
+{
+  using namespace thermos::sqlite;
+  using namespace thermos::storage;
+  using namespace std::chrono_literals;
+
+  auto possible_db = database::open(":memory:");
+  REQUIRE( possible_db.has_value() );
+  auto& db = possible_db.value();
+  REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+
+  // One reading every ten minutes for ten days, ending at 'now'.
+  constexpr int64_t now = 1650000000;
+  constexpr int64_t count = 6 * 24 * 10;
+  REQUIRE( db.exec("INSERT INTO device (deviceId, name, origin) VALUES (1, 'foo', 'here');") );
+  REQUIRE( db.exec(R"SQL(
+      WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i + 1 < 1440)
+      INSERT INTO reading (deviceId, type, date, value)
+        SELECT 1, 'temperature', 1650000000 - 600 * i, i FROM n;
+      )SQL") );
+  REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading;") == count );
+  const int64_t hours = query_int(db, "SELECT COUNT(*) FROM rollup_hour;");
+  const int64_t days = query_int(db, "SELECT COUNT(*) FROM rollup_day;");
+
+  SECTION("policy that keeps everything deletes nothing")
+  {
+    const auto deleted = compaction::run(db, retention_policy(), now, 10s);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( deleted.value() == 0 );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading;") == count );
+  }
+
+  SECTION("step deletes bounded batches of raw readings")
+  {
+    retention_policy policy;
+    policy.raw = 48h;
+    // Readings from 'now - 48h' up to 'now' are kept.
+    const int64_t expired = count - (6 * 48 + 1);
+
+    auto deleted = compaction::step(db, policy, now, 1000);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( deleted.value() == 1000 );
+
+    deleted = compaction::step(db, policy, now, 1000);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( deleted.value() == expired - 1000 );
+
+    deleted = compaction::step(db, policy, now, 1000);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( deleted.value() == 0 );
+
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading;") == count - expired );
+    REQUIRE( query_int(db, "SELECT MIN(date) FROM reading;") == now - 48 * 3600 );
+    // Rollups still cover the deleted readings.
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM rollup_hour;") == hours );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM rollup_day;") == days );
+    REQUIRE( query_int(db, "SELECT SUM(value_count) FROM rollup_hour;") == count );
+  }
+
+  SECTION("rollups are only deleted when their whole bucket has expired")
+  {
+    retention_policy policy;
+    policy.hourly = 24h;
+    policy.daily = 72h;
+
+    const auto deleted = compaction::run(db, policy, now, 10s, 7);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading;") == count );
+    REQUIRE( query_int(db, "SELECT MIN(bucket) FROM rollup_hour;") == now - now % 3600 - 24 * 3600 );
+    REQUIRE( query_int(db, "SELECT MIN(bucket) FROM rollup_day;") == now - now % 86400 - 3 * 86400 );
+    REQUIRE( deleted.value() == (hours - query_int(db, "SELECT COUNT(*) FROM rollup_hour;"))
+                               + (days - query_int(db, "SELECT COUNT(*) FROM rollup_day;")) );
+  }
+
+  SECTION("run only releases free pages after deleting rows")
+  {
+    REQUIRE( db.exec("DELETE FROM reading WHERE date < 1650000000 - 48 * 3600;") );
+    const int64_t free_pages = query_int(db, "PRAGMA freelist_count;");
+    REQUIRE( free_pages > 0 );
+
+    retention_policy policy;
+    policy.raw = 48h;
+    auto deleted = compaction::run(db, policy, now, 10s);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( deleted.value() == 0 );
+    REQUIRE( query_int(db, "PRAGMA freelist_count;") == free_pages );
+
+    policy.raw = 24h;
+    deleted = compaction::run(db, policy, now, 10s);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( deleted.value() == 6 * 24 );
+    REQUIRE( query_int(db, "PRAGMA freelist_count;") < free_pages );
+  }
+
+  SECTION("expired readings are found via the date index")
+  {
+    auto stmt = db.prepare("EXPLAIN QUERY PLAN SELECT readingId FROM reading WHERE date < 1650000000 LIMIT 10;");
+    REQUIRE( stmt.has_value() );
+    REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+    const std::string plan = reinterpret_cast<const char*>(sqlite3_column_text(stmt.value().ptr(), 3));
+    REQUIRE( plan.find("reading_date") != std::string::npos );
+  }
+
+  SECTION("run with exhausted budget still deletes one batch")
+  {
+    retention_policy policy;
+    policy.raw = 1h;
+
+    const auto deleted = compaction::run(db, policy, now, 0s, 100);
+    REQUIRE( deleted.has_value() );
+    REQUIRE( deleted.value() == 100 );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading;") == count - 100 );
+  }
+}
+
+TEST_CASE("storage compaction: vacuum")
+{
+  using namespace thermos::sqlite;
+  using namespace thermos::storage;
+
+  auto possible_db = database::open(":memory:");
+  REQUIRE( possible_db.has_value() );
+  auto& db = possible_db.value();
+
+  SECTION("new databases use incremental auto vacuum")
+  {
+    REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+    REQUIRE( query_int(db, "PRAGMA auto_vacuum;") == 2 );
+  }
+
+  SECTION("older databases are not switched to incremental auto vacuum")
+  {
+    REQUIRE( db.exec(R"SQL(
+        CREATE TABLE device (deviceId INTEGER PRIMARY KEY NOT NULL, name TEXT NOT NULL, origin TEXT NOT NULL);
+        WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i + 1 < 20000)
+        INSERT INTO device (deviceId, name, origin)
+          SELECT i, 'device ' || i, 'here' FROM n;
+        DELETE FROM device;
+        )SQL") );
+    REQUIRE( query_int(db, "PRAGMA auto_vacuum;") == 0 );
+    const int64_t free_pages = query_int(db, "PRAGMA freelist_count;");
+    REQUIRE( free_pages > 10 );
+
+    REQUIRE_FALSE( compaction::vacuum(db).has_value() );
+    REQUIRE( query_int(db, "PRAGMA auto_vacuum;") == 0 );
+    REQUIRE( query_int(db, "PRAGMA freelist_count;") == free_pages );
+  }
+
+  SECTION("free pages are released")
+  {
+    REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+    REQUIRE( db.exec(R"SQL(
+        INSERT INTO device (deviceId, name, origin) VALUES (1, 'foo', 'here');
+        WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i + 1 < 20000)
+        INSERT INTO reading (deviceId, type, date, value)
+          SELECT 1, 'temperature', 1650000000 + 60 * i, i FROM n;
+        DELETE FROM reading;
+        )SQL") );
+    const int64_t free_pages = query_int(db, "PRAGMA freelist_count;");
+    REQUIRE( free_pages > 10 );
+
+    REQUIRE_FALSE( compaction::vacuum(db, 10).has_value() );
+    REQUIRE( query_int(db, "PRAGMA freelist_count;") == free_pages - 10 );
+
+    REQUIRE_FALSE( compaction::vacuum(db, free_pages).has_value() );
+    REQUIRE( query_int(db, "PRAGMA freelist_count;") == 0 );
+  }
+}
+#endif // SQLite feature guard
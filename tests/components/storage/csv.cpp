@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -33,8 +33,7 @@ TEST_CASE("csv storage: thermal data")
   {
     std::vector<thermos::thermal::device_reading> data;
     thermal::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "ori";
+    reading.dev = device_registry::intern(device("foo", "ori"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -49,8 +48,7 @@ TEST_CASE("csv storage: thermal data")
   {
     std::vector<thermos::thermal::device_reading> data;
     thermal::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -86,8 +84,7 @@ TEST_CASE("csv storage: thermal data")
   {
     std::vector<thermos::thermal::device_reading> data;
     thermal::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -105,8 +102,7 @@ TEST_CASE("csv storage: thermal data")
 
     // prepare data for append operation
     data.clear();
-    reading.dev.name = "bar";
-    reading.dev.origin = "somewhere else";
+    reading.dev = device_registry::intern(device("bar", "somewhere else"));
     reading.reading.value = 43210;
     reading.reading.time = to_time(2022, 4, 23, 20, 19, 18);
     data.push_back(reading);
@@ -151,8 +147,7 @@ TEST_CASE("csv storage: load data")
   {
     std::vector<thermos::load::device_reading> data;
     load::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "ori";
+    reading.dev = device_registry::intern(device("foo", "ori"));
     reading.reading.value = 2400;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -167,8 +162,7 @@ TEST_CASE("csv storage: load data")
   {
     std::vector<thermos::load::device_reading> data;
     load::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 2400;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -204,8 +198,7 @@ TEST_CASE("csv storage: load data")
   {
     std::vector<thermos::load::device_reading> data;
     load::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 2400;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -223,8 +216,7 @@ TEST_CASE("csv storage: load data")
 
     // prepare data for append operation
     data.clear();
-    reading.dev.name = "bar";
-    reading.dev.origin = "somewhere else";
+    reading.dev = device_registry::intern(device("bar", "somewhere else"));
     reading.reading.value = 3210;
     reading.reading.time = to_time(2022, 4, 23, 20, 19, 18);
     data.push_back(reading);
@@ -259,3 +251,65 @@ TEST_CASE("csv storage: load data")
     REQUIRE( std::filesystem::remove(file_name) );
   }
 }
+
+TEST_CASE("csv storage: reading batch")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  SECTION("file cannot be opened / created")
+  {
+    thermal::reading_batch batch;
+    batch.push_back(device_registry::intern(device("foo", "ori")), 1650000000, 42000);
+
+    csv store;
+    const auto opt = store.save(batch, "/path/may-not/exist/for-real.csv");
+    REQUIRE( opt.has_value() );
+    REQUIRE( opt.value().find("Failed to create or open file") != std::string::npos );
+  }
+
+  SECTION("batch is written like a vector of readings")
+  {
+    std::vector<load::device_reading> data;
+    load::device_reading reading;
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
+    reading.reading.value = 2400;
+    reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
+    data.push_back(reading);
+    reading.dev = device_registry::intern(device("bar", "somewhere else"));
+    reading.reading.value = 600;
+    reading.reading.time = to_time(2022, 4, 23, 19, 20, 21);
+    data.push_back(reading);
+
+    load::reading_batch batch;
+    for (const auto& elem: data)
+    {
+      batch.push_back(elem);
+    }
+
+    const auto vector_file = "storage-batch-vector.csv";
+    const auto batch_file = "storage-batch-batch.csv";
+    csv store;
+    REQUIRE_FALSE( store.save(data, vector_file).has_value() );
+    REQUIRE_FALSE( store.save(batch, batch_file).has_value() );
+
+    std::string vector_line;
+    std::string batch_line;
+    {
+      std::ifstream vector_stream(vector_file);
+      std::ifstream batch_stream(batch_file);
+      REQUIRE( vector_stream.good() );
+      REQUIRE( batch_stream.good() );
+      for (unsigned int i = 0; i < 2; ++i)
+      {
+        std::getline(vector_stream, vector_line);
+        std::getline(batch_stream, batch_line);
+        REQUIRE( batch_line == vector_line );
+      }
+      REQUIRE( batch_line == "bar;somewhere else;load;600;2022-04-23 19:20:21" );
+    }
+
+    REQUIRE( std::filesystem::remove(vector_file) );
+    REQUIRE( std::filesystem::remove(batch_file) );
+  }
+}
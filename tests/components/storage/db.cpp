@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -22,6 +22,7 @@
 #include <array>
 #include <filesystem>
 #include <fstream>
+#include <map>
 #include "../../../lib/storage/db.hpp"
 #include "to_time.hpp"
 
@@ -35,8 +36,7 @@ TEST_CASE("db storage: save thermal data")
   {
     std::vector<thermos::thermal::device_reading> data;
     thermal::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "ori";
+    reading.dev = device_registry::intern(device("foo", "ori"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -61,8 +61,7 @@ TEST_CASE("db storage: save thermal data")
 
     std::vector<thermos::thermal::device_reading> data;
     thermal::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "ori";
+    reading.dev = device_registry::intern(device("foo", "ori"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -79,8 +78,7 @@ TEST_CASE("db storage: save thermal data")
   {
     std::vector<thermos::thermal::device_reading> data;
     thermal::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -90,9 +88,11 @@ TEST_CASE("db storage: save thermal data")
 
     const auto file_name = "storage-normal-thermal.db";
 
-    db store;
-    const auto opt = store.save(data, file_name);
-    REQUIRE_FALSE( opt.has_value() );
+    {
+      db store;
+      const auto opt = store.save(data, file_name);
+      REQUIRE_FALSE( opt.has_value() );
+    }
     REQUIRE( std::filesystem::exists(file_name) );
 
     // read data back to check file format
@@ -125,8 +125,7 @@ TEST_CASE("db storage: save thermal data")
   {
     std::vector<thermos::thermal::device_reading> data;
     thermal::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -136,40 +135,47 @@ TEST_CASE("db storage: save thermal data")
 
     const auto file_name = "storage-append-existing-thermal.db";
 
-    db store;
-    // save first part of data
-    const auto opt = store.save(data, file_name);
-    REQUIRE_FALSE( opt.has_value() );
-    REQUIRE( std::filesystem::exists(file_name) );
+    // The database connection of the store has to be closed before the file
+    // can be removed, so the store only lives within this block.
+    std::uintmax_t size_one = 0;
+    std::uintmax_t size_two = 0;
+    {
+      db store;
+      // save first part of data
+      const auto opt = store.save(data, file_name);
+      REQUIRE_FALSE( opt.has_value() );
+      REQUIRE( std::filesystem::exists(file_name) );
 
-    const auto size_one = std::filesystem::file_size(file_name);
-    REQUIRE( size_one > 0 );
+      size_one = std::filesystem::file_size(file_name);
+      REQUIRE( size_one > 0 );
 
-    // prepare data for append operation
-    data.clear();
-    reading.dev.name = "bar";
-    reading.dev.origin = "somewhere else";
-    reading.reading.value = 43210;
-    reading.reading.time = to_time(2022, 4, 23, 20, 19, 18);
-    data.push_back(reading);
-    reading.reading.value = 12345;
-    reading.reading.time = to_time(2022, 4, 23, 22, 23, 24);
-    data.push_back(reading);
-    // Generate more data to force resize.
-    for (unsigned int i = 1; i < 60; ++i)
-    {
-      reading.dev.origin.append(" abc");
-      reading.reading.value += 100;
-      reading.reading.time = to_time(2022, 4, 23, 22, 24, i);
+      // prepare data for append operation
+      data.clear();
+      reading.dev = device_registry::intern(device("bar", "somewhere else"));
+      reading.reading.value = 43210;
+      reading.reading.time = to_time(2022, 4, 23, 20, 19, 18);
+      data.push_back(reading);
+      reading.reading.value = 12345;
+      reading.reading.time = to_time(2022, 4, 23, 22, 23, 24);
       data.push_back(reading);
+      // Generate more data to force resize.
+      std::string origin = "somewhere else";
+      for (unsigned int i = 1; i < 60; ++i)
+      {
+        origin.append(" abc");
+        reading.dev = device_registry::intern(device("bar", origin));
+        reading.reading.value += 100;
+        reading.reading.time = to_time(2022, 4, 23, 22, 24, i);
+        data.push_back(reading);
+      }
+
+      const auto opt_append = store.save(data, file_name);
+      REQUIRE_FALSE( opt_append.has_value() );
+      REQUIRE( std::filesystem::exists(file_name) );
+
+      size_two = std::filesystem::file_size(file_name);
     }
 
-    const auto opt_append = store.save(data, file_name);
-    REQUIRE_FALSE( opt_append.has_value() );
-    REQUIRE( std::filesystem::exists(file_name) );
-
-    const auto size_two = std::filesystem::file_size(file_name);
-
     REQUIRE( std::filesystem::remove(file_name) );
 
     // Append means that the file size increased.
@@ -177,6 +183,50 @@ TEST_CASE("db storage: save thermal data")
   }
 }
 
+TEST_CASE("db storage: save batch with several devices")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  const auto file_name = "storage-batch-several-devices.db";
+
+  std::vector<thermos::thermal::device_reading> data;
+  thermal::device_reading reading;
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    reading.dev = device_registry::intern(device("sensor " + std::to_string(i % 5), "origin " + std::to_string(i % 5)));
+    reading.reading.value = 40000 + i;
+    reading.reading.time = to_time(2022, 4, 23, 19, i, 17);
+    data.push_back(reading);
+  }
+
+  {
+    db store;
+    const auto opt = store.save(data, file_name);
+    REQUIRE_FALSE( opt.has_value() );
+  }
+
+  // Every distinct device gets only one entry in the device table.
+  std::vector<thermos::device> devices;
+  db store;
+  auto opt = store.get_devices(devices, reading_type::temperature, file_name);
+  REQUIRE_FALSE( opt.has_value() );
+  REQUIRE( devices.size() == 5 );
+
+  // All readings have been saved.
+  std::vector<thermos::thermal::device_reading> loaded;
+  opt = store.load(loaded, file_name);
+  REQUIRE_FALSE( opt.has_value() );
+  REQUIRE( loaded.size() == data.size() );
+  for (const auto& elem: loaded)
+  {
+    // Value was chosen so that the last digit matches the device suffix.
+    REQUIRE( device_registry::get(elem.dev).name == "sensor " + std::to_string((elem.reading.value - 40000) % 5) );
+  }
+
+  REQUIRE( std::filesystem::remove(file_name) );
+}
+
 TEST_CASE("db storage: save CPU load data")
 {
   using namespace thermos;
@@ -186,8 +236,7 @@ TEST_CASE("db storage: save CPU load data")
   {
     std::vector<thermos::load::device_reading> data;
     load::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "ori";
+    reading.dev = device_registry::intern(device("foo", "ori"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -212,8 +261,7 @@ TEST_CASE("db storage: save CPU load data")
 
     std::vector<thermos::load::device_reading> data;
     load::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "ori";
+    reading.dev = device_registry::intern(device("foo", "ori"));
     reading.reading.value = 42000;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -230,8 +278,7 @@ TEST_CASE("db storage: save CPU load data")
   {
     std::vector<thermos::load::device_reading> data;
     load::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 2400;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -241,9 +288,11 @@ TEST_CASE("db storage: save CPU load data")
 
     const auto file_name = "storage-normal-load.db";
 
-    db store;
-    const auto opt = store.save(data, file_name);
-    REQUIRE_FALSE( opt.has_value() );
+    {
+      db store;
+      const auto opt = store.save(data, file_name);
+      REQUIRE_FALSE( opt.has_value() );
+    }
     REQUIRE( std::filesystem::exists(file_name) );
 
     // read data back to check file format
@@ -276,8 +325,7 @@ TEST_CASE("db storage: save CPU load data")
   {
     std::vector<thermos::load::device_reading> data;
     load::device_reading reading;
-    reading.dev.name = "foo";
-    reading.dev.origin = "origin is here";
+    reading.dev = device_registry::intern(device("foo", "origin is here"));
     reading.reading.value = 2400;
     reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     data.push_back(reading);
@@ -287,40 +335,47 @@ TEST_CASE("db storage: save CPU load data")
 
     const auto file_name = "storage-append-existing-load.db";
 
-    db store;
-    // save first part of data
-    const auto opt = store.save(data, file_name);
-    REQUIRE_FALSE( opt.has_value() );
-    REQUIRE( std::filesystem::exists(file_name) );
+    // The database connection of the store has to be closed before the file
+    // can be removed, so the store only lives within this block.
+    std::uintmax_t size_one = 0;
+    std::uintmax_t size_two = 0;
+    {
+      db store;
+      // save first part of data
+      const auto opt = store.save(data, file_name);
+      REQUIRE_FALSE( opt.has_value() );
+      REQUIRE( std::filesystem::exists(file_name) );
 
-    const auto size_one = std::filesystem::file_size(file_name);
-    REQUIRE( size_one > 0 );
+      size_one = std::filesystem::file_size(file_name);
+      REQUIRE( size_one > 0 );
 
-    // prepare data for append operation
-    data.clear();
-    reading.dev.name = "bar";
-    reading.dev.origin = "somewhere else";
-    reading.reading.value = 4321;
-    reading.reading.time = to_time(2022, 4, 23, 20, 19, 18);
-    data.push_back(reading);
-    reading.reading.value = 1234;
-    reading.reading.time = to_time(2022, 4, 23, 22, 23, 24);
-    data.push_back(reading);
-    // Generate more data to force resize.
-    for (unsigned int i = 1; i < 60; ++i)
-    {
-      reading.dev.origin.append(" abc");
-      reading.reading.value += 1;
-      reading.reading.time = to_time(2022, 4, 23, 22, 24, i);
+      // prepare data for append operation
+      data.clear();
+      reading.dev = device_registry::intern(device("bar", "somewhere else"));
+      reading.reading.value = 4321;
+      reading.reading.time = to_time(2022, 4, 23, 20, 19, 18);
       data.push_back(reading);
+      reading.reading.value = 1234;
+      reading.reading.time = to_time(2022, 4, 23, 22, 23, 24);
+      data.push_back(reading);
+      // Generate more data to force resize.
+      std::string origin = "somewhere else";
+      for (unsigned int i = 1; i < 60; ++i)
+      {
+        origin.append(" abc");
+        reading.dev = device_registry::intern(device("bar", origin));
+        reading.reading.value += 1;
+        reading.reading.time = to_time(2022, 4, 23, 22, 24, i);
+        data.push_back(reading);
+      }
+
+      const auto opt_append = store.save(data, file_name);
+      REQUIRE_FALSE( opt_append.has_value() );
+      REQUIRE( std::filesystem::exists(file_name) );
+
+      size_two = std::filesystem::file_size(file_name);
     }
 
-    const auto opt_append = store.save(data, file_name);
-    REQUIRE_FALSE( opt_append.has_value() );
-    REQUIRE( std::filesystem::exists(file_name) );
-
-    const auto size_two = std::filesystem::file_size(file_name);
-
     REQUIRE( std::filesystem::remove(file_name) );
 
     // Append means that the file size increased.
@@ -366,13 +421,11 @@ TEST_CASE("db storage: load thermal data")
   SECTION("normal read operation")
   {
     thermal::device_reading reading_one;
-    reading_one.dev.name = "foo_therm";
-    reading_one.dev.origin = "origin is here";
+    reading_one.dev = device_registry::intern(device("foo_therm", "origin is here"));
     reading_one.reading.value = 42000;
     reading_one.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     thermal::device_reading reading_two;
-    reading_two.dev.name = "foo_therm";
-    reading_two.dev.origin = "origin is here";
+    reading_two.dev = device_registry::intern(device("foo_therm", "origin is here"));
     reading_two.reading.value = 60000;
     reading_two.reading.time = to_time(2022, 4, 23, 19, 20, 21);
 
@@ -388,8 +441,7 @@ TEST_CASE("db storage: load thermal data")
       // Add some CPU load data (should not be retrieved later).
       std::vector<thermos::load::device_reading> data2;
       load::device_reading reading_other;
-      reading_other.dev.name = "foo";
-      reading_other.dev.origin = "origin is here";
+      reading_other.dev = device_registry::intern(device("foo", "origin is here"));
       reading_other.reading.value = 2400;
       reading_other.reading.time = to_time(2022, 4, 23, 19, 19, 19);
       data2.push_back(reading_other);
@@ -407,13 +459,11 @@ TEST_CASE("db storage: load thermal data")
 
     REQUIRE( data.size() == 2 );
     // Check first value.
-    REQUIRE( reading_one.dev.name == data[0].dev.name );
-    REQUIRE( reading_one.dev.origin == data[0].dev.origin );
+    REQUIRE( reading_one.dev == data[0].dev );
     REQUIRE( reading_one.reading.value == data[0].reading.value );
     REQUIRE( reading_one.reading.time == data[0].reading.time );
     // Check second value.
-    REQUIRE( reading_two.dev.name == data[1].dev.name );
-    REQUIRE( reading_two.dev.origin == data[1].dev.origin );
+    REQUIRE( reading_two.dev == data[1].dev );
     REQUIRE( reading_two.reading.value == data[1].reading.value );
     REQUIRE( reading_two.reading.time == data[1].reading.time );
   }
@@ -458,13 +508,11 @@ TEST_CASE("db storage: load CPU load data")
   SECTION("normal read operation")
   {
     load::device_reading reading_one;
-    reading_one.dev.name = "foo";
-    reading_one.dev.origin = "origin is here";
+    reading_one.dev = device_registry::intern(device("foo", "origin is here"));
     reading_one.reading.value = 2400;
     reading_one.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     load::device_reading reading_two;
-    reading_two.dev.name = "foo";
-    reading_two.dev.origin = "origin is here";
+    reading_two.dev = device_registry::intern(device("foo", "origin is here"));
     reading_two.reading.value = 600;
     reading_two.reading.time = to_time(2022, 4, 23, 19, 20, 21);
 
@@ -480,8 +528,7 @@ TEST_CASE("db storage: load CPU load data")
       // Add some thermal data (should not be retrieved later).
       std::vector<thermos::thermal::device_reading> data2;
       thermal::device_reading reading_other;
-      reading_other.dev.name = "foo2";
-      reading_other.dev.origin = "origin was here";
+      reading_other.dev = device_registry::intern(device("foo2", "origin was here"));
       reading_other.reading.value = 24000;
       reading_other.reading.time = to_time(2022, 4, 23, 19, 19, 19);
       data2.push_back(reading_other);
@@ -499,13 +546,11 @@ TEST_CASE("db storage: load CPU load data")
 
     REQUIRE( data.size() == 2 );
     // Check first value.
-    REQUIRE( reading_one.dev.name == data[0].dev.name );
-    REQUIRE( reading_one.dev.origin == data[0].dev.origin );
+    REQUIRE( reading_one.dev == data[0].dev );
     REQUIRE( reading_one.reading.value == data[0].reading.value );
     REQUIRE( reading_one.reading.time == data[0].reading.time );
     // Check second value.
-    REQUIRE( reading_two.dev.name == data[1].dev.name );
-    REQUIRE( reading_two.dev.origin == data[1].dev.origin );
+    REQUIRE( reading_two.dev == data[1].dev );
     REQUIRE( reading_two.reading.value == data[1].reading.value );
     REQUIRE( reading_two.reading.time == data[1].reading.time );
   }
@@ -549,13 +594,11 @@ TEST_CASE("db storage: load device list")
   SECTION("normal query")
   {
     load::device_reading reading_one;
-    reading_one.dev.name = "foo";
-    reading_one.dev.origin = "origin is here";
+    reading_one.dev = device_registry::intern(device("foo", "origin is here"));
     reading_one.reading.value = 2400;
     reading_one.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     load::device_reading reading_two;
-    reading_two.dev.name = "bar";
-    reading_two.dev.origin = "baz is here";
+    reading_two.dev = device_registry::intern(device("bar", "baz is here"));
     reading_two.reading.value = 600;
     reading_two.reading.time = to_time(2022, 4, 23, 19, 20, 21);
 
@@ -574,8 +617,7 @@ TEST_CASE("db storage: load device list")
       // Save some temperature data.
       std::vector<thermos::thermal::device_reading> data;
       thermal::device_reading reading_temperature;
-      reading_temperature.dev.name = "foo's thermal sibling";
-      reading_temperature.dev.origin = "origin was here";
+      reading_temperature.dev = device_registry::intern(device("foo's thermal sibling", "origin was here"));
       reading_temperature.reading.value = 25000;
       reading_temperature.reading.time = to_time(2022, 4, 23, 19, 18, 17);
       data.push_back(reading_temperature);
@@ -595,11 +637,11 @@ TEST_CASE("db storage: load device list")
     REQUIRE( data.size() == 2 );
     // Check first value.
     // (Values are sorted by device name, so 2nd device is 1st now.)
-    REQUIRE( reading_two.dev.name == data[0].name );
-    REQUIRE( reading_two.dev.origin == data[0].origin );
+    REQUIRE( device_registry::get(reading_two.dev).name == data[0].name );
+    REQUIRE( device_registry::get(reading_two.dev).origin == data[0].origin );
     // Check second value.
-    REQUIRE( reading_one.dev.name == data[1].name );
-    REQUIRE( reading_one.dev.origin == data[1].origin );
+    REQUIRE( device_registry::get(reading_one.dev).name == data[1].name );
+    REQUIRE( device_registry::get(reading_one.dev).origin == data[1].origin );
 
     // Load thermal devices from file.
     const auto opt_thermal = store.get_devices(data, thermos::reading_type::temperature, file_name);
@@ -655,13 +697,11 @@ TEST_CASE("db storage: get_device_id")
   SECTION("normal query")
   {
     load::device_reading reading_one;
-    reading_one.dev.name = "foo";
-    reading_one.dev.origin = "bar";
+    reading_one.dev = device_registry::intern(device("foo", "bar"));
     reading_one.reading.value = 2400;
     reading_one.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     load::device_reading reading_two;
-    reading_two.dev.name = "bar";
-    reading_two.dev.origin = "baz is here";
+    reading_two.dev = device_registry::intern(device("bar", "baz is here"));
     reading_two.reading.value = 600;
     reading_two.reading.time = to_time(2022, 4, 23, 19, 20, 21);
 
@@ -758,13 +798,11 @@ TEST_CASE("db storage: get_device_readings - CPU load")
   SECTION("normal query")
   {
     load::device_reading reading_zero;
-    reading_zero.dev.name = "foo";
-    reading_zero.dev.origin = "bar";
+    reading_zero.dev = device_registry::intern(device("foo", "bar"));
     reading_zero.reading.value = 1600;
     reading_zero.reading.time = to_time(2022, 4, 23, 14, 12, 12);
     load::device_reading reading_one;
-    reading_one.dev.name = "foo";
-    reading_one.dev.origin = "bar";
+    reading_one.dev = device_registry::intern(device("foo", "bar"));
     reading_one.reading.value = 2400;
     reading_one.reading.time = to_time(2022, 4, 23, 19, 18, 17);
     load::device_reading reading_two;
@@ -786,7 +824,7 @@ TEST_CASE("db storage: get_device_readings - CPU load")
 
     // Get data from file.
     {
-      const device dev = reading_one.dev;
+      const device dev = device_registry::get(reading_one.dev);
       std::vector<thermos::load::reading> data;
 
       db store;
@@ -803,7 +841,7 @@ TEST_CASE("db storage: get_device_readings - CPU load")
 
     // Get data from file, but with "wrong" type.
     {
-      const device dev = reading_one.dev;
+      const device dev = device_registry::get(reading_one.dev);
       std::vector<thermos::thermal::reading> data;
 
       db store;
@@ -814,7 +852,7 @@ TEST_CASE("db storage: get_device_readings - CPU load")
 
     // Get data from file, but with longer time span.
     {
-      const device dev = reading_one.dev;
+      const device dev = device_registry::get(reading_one.dev);
       std::vector<thermos::load::reading> data;
 
       db store;
@@ -835,4 +873,525 @@ TEST_CASE("db storage: get_device_readings - CPU load")
     REQUIRE( std::filesystem::remove(file_name) );
   }
 }
+
+TEST_CASE("db storage: stream readings")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  const auto file_name = "storage-stream-readings.db";
+  {
+    std::vector<thermal::device_reading> thermal_data;
+    thermal::device_reading reading;
+    for (unsigned int i = 0; i < 12; ++i)
+    {
+      reading.dev = device_registry::intern(device("sensor " + std::to_string(i % 3), "origin"));
+      reading.reading.value = 40000 + i;
+      reading.reading.time = to_time(2022, 4, 23, 19, i, 17);
+      thermal_data.push_back(reading);
+    }
+    std::vector<load::device_reading> load_data;
+    load::device_reading load_reading;
+    load_reading.dev = device_registry::intern(device("cpu", "/proc/stat"));
+    load_reading.reading.value = 150;
+    load_reading.reading.time = to_time(2022, 4, 23, 19, 5, 0);
+    load_data.push_back(load_reading);
+
+    db store;
+    REQUIRE_FALSE( store.save(thermal_data, file_name).has_value() );
+    REQUIRE_FALSE( store.save(load_data, file_name).has_value() );
+  }
+
+  SECTION("all readings")
+  {
+    std::map<int64_t, device> devices;
+    std::vector<int64_t> ids;
+    std::vector<thermal::reading> readings;
+    bool readings_started = false;
+    bool device_after_reading = false;
+
+    db store;
+    const auto error = store.load(file_name,
+        [&](const int64_t id, const device& dev)
+        {
+          device_after_reading = device_after_reading || readings_started;
+          devices[id] = dev;
+          return true;
+        },
+        [&](const int64_t id, const thermal::reading& r)
+        {
+          readings_started = true;
+          ids.push_back(id);
+          readings.push_back(r);
+          return true;
+        });
+    REQUIRE_FALSE( error.has_value() );
+    REQUIRE_FALSE( device_after_reading );
+    REQUIRE( devices.size() == 3 );
+    REQUIRE( readings.size() == 12 );
+
+    // Readings are ordered by device and time and refer to known devices.
+    for (std::size_t i = 0; i < readings.size(); ++i)
+    {
+      REQUIRE( devices.find(ids[i]) != devices.end() );
+      const auto& name = devices[ids[i]].name;
+      REQUIRE( name == "sensor " + std::to_string((readings[i].value - 40000) % 3) );
+      if (i > 0)
+      {
+        REQUIRE( ids[i - 1] <= ids[i] );
+        if (ids[i - 1] == ids[i])
+        {
+          REQUIRE( readings[i - 1].time < readings[i].time );
+        }
+      }
+    }
+  }
+
+  SECTION("readings of other type")
+  {
+    std::vector<device> devices;
+    std::size_t count = 0;
+
+    db store;
+    const auto error = store.load(file_name,
+        [&](const int64_t, const device& dev)
+        {
+          devices.push_back(dev);
+          return true;
+        },
+        [&](const int64_t, const load::reading& r)
+        {
+          ++count;
+          REQUIRE( r.value == 150 );
+          return true;
+        });
+    REQUIRE_FALSE( error.has_value() );
+    REQUIRE( devices.size() == 1 );
+    REQUIRE( devices[0].name == "cpu" );
+    REQUIRE( count == 1 );
+  }
+
+  SECTION("visitor stops streaming")
+  {
+    std::size_t count = 0;
+
+    db store;
+    const auto error = store.load(file_name,
+        [](const int64_t, const device&) { return true; },
+        [&count](const int64_t, const thermal::reading&)
+        {
+          ++count;
+          return count < 5;
+        });
+    REQUIRE_FALSE( error.has_value() );
+    REQUIRE( count == 5 );
+  }
+
+  SECTION("readings of a single device")
+  {
+    device dev;
+    dev.name = "sensor 1";
+    dev.origin = "origin";
+    std::vector<thermal::reading> readings;
+
+    db store;
+    const auto id = store.get_device_id(dev, file_name);
+    REQUIRE( id.has_value() );
+    const auto error = store.get_device_readings(dev, file_name, std::chrono::hours(1),
+        [&](const int64_t device_id, const thermal::reading& r)
+        {
+          REQUIRE( device_id == id.value() );
+          readings.push_back(r);
+          return true;
+        });
+    REQUIRE_FALSE( error.has_value() );
+    REQUIRE( readings.size() == 4 );
+    REQUIRE( readings[0].time == to_time(2022, 4, 23, 19, 1, 17) );
+    REQUIRE( readings[3].time == to_time(2022, 4, 23, 19, 10, 17) );
+  }
+
+  SECTION("all readings into a batch")
+  {
+    std::vector<thermal::device_reading> data;
+    thermal::reading_batch batch;
+
+    db store;
+    REQUIRE_FALSE( store.load(data, file_name).has_value() );
+    REQUIRE_FALSE( store.load(batch, file_name).has_value() );
+    REQUIRE( batch.size() == 12 );
+    REQUIRE( batch.size() == data.size() );
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+      const auto reading = batch.get(i);
+      REQUIRE( reading.dev == data[i].dev );
+      REQUIRE( reading.reading.time == data[i].reading.time );
+      REQUIRE( reading.reading.value == data[i].reading.value );
+    }
+  }
+
+  SECTION("readings of a single device into a batch")
+  {
+    const device dev("sensor 1", "origin");
+    thermal::reading_batch batch;
+    // Previous content of the batch shall be replaced.
+    batch.push_back(device_registry::no_device, 1, 2);
+
+    db store;
+    const auto error = store.get_device_readings(dev, batch, file_name, std::chrono::hours(1));
+    REQUIRE_FALSE( error.has_value() );
+    REQUIRE( batch.size() == 4 );
+    REQUIRE( batch.devices[0] == device_registry::intern(dev) );
+    REQUIRE( batch.devices[3] == device_registry::intern(dev) );
+    REQUIRE( batch.get(0).reading.time == to_time(2022, 4, 23, 19, 1, 17) );
+    REQUIRE( batch.get(3).reading.time == to_time(2022, 4, 23, 19, 10, 17) );
+    REQUIRE( batch.values[0] == 40001 );
+    REQUIRE( batch.values[3] == 40010 );
+  }
+
+  REQUIRE( std::filesystem::remove(file_name) );
+}
+
+TEST_CASE("db storage: get_latest_readings")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  const auto file_name = "storage-get-latest-readings.db";
+  db store;
+
+  SECTION("file cannot be opened / created")
+  {
+    thermal::reading_batch batch;
+    const auto error = store.get_latest_readings(batch, "/path/may-not/exist/for-real/get_latest_readings.db", std::chrono::hours(1));
+    REQUIRE( error.has_value() );
+  }
+
+  SECTION("normal query")
+  {
+    {
+      // Devices end at different times: "b" has its last reading two hours
+      // after "a", so each device must get its own time window.
+      std::vector<thermal::device_reading> thermal_data;
+      thermal::device_reading reading;
+      for (unsigned int i = 0; i < 10; ++i)
+      {
+        reading.dev = device_registry::intern(device("b", "origin"));
+        reading.reading.value = 50000 + i;
+        reading.reading.time = to_time(2022, 4, 23, 12 + i / 2, (i % 2) * 30, 0);
+        thermal_data.push_back(reading);
+        reading.dev = device_registry::intern(device("a", "origin"));
+        reading.reading.value = 40000 + i;
+        reading.reading.time = to_time(2022, 4, 23, 10 + i / 2, (i % 2) * 30, 0);
+        thermal_data.push_back(reading);
+      }
+      std::vector<load::device_reading> load_data;
+      load::device_reading load_reading;
+      load_reading.dev = device_registry::intern(device("cpu", "/proc/stat"));
+      load_reading.reading.value = 150;
+      load_reading.reading.time = to_time(2022, 4, 23, 19, 5, 0);
+      load_data.push_back(load_reading);
+
+      REQUIRE_FALSE( store.save(thermal_data, file_name).has_value() );
+      REQUIRE_FALSE( store.save(load_data, file_name).has_value() );
+    }
+
+    thermal::reading_batch batch;
+    // Previous content of the batch shall be replaced.
+    batch.push_back(device_registry::no_device, 1, 2);
+    const auto error = store.get_latest_readings(batch, file_name, std::chrono::hours(2));
+    REQUIRE_FALSE( error.has_value() );
+
+    // Result has to match the separate queries per device, in order of the
+    // device names.
+    std::size_t index = 0;
+    for (const std::string name : { "a", "b" })
+    {
+      const device dev(name, "origin");
+      thermal::reading_batch single;
+      REQUIRE_FALSE( store.get_device_readings(dev, single, file_name, std::chrono::hours(2)).has_value() );
+      REQUIRE( single.size() == 5 );
+      for (std::size_t i = 0; i < single.size(); ++i)
+      {
+        REQUIRE( index < batch.size() );
+        REQUIRE( batch.devices[index] == device_registry::intern(dev) );
+        REQUIRE( batch.times[index] == single.times[i] );
+        REQUIRE( batch.values[index] == single.values[i] );
+        ++index;
+      }
+    }
+    REQUIRE( index == batch.size() );
+
+    load::reading_batch load_batch;
+    REQUIRE_FALSE( store.get_latest_readings(load_batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( load_batch.size() == 1 );
+    REQUIRE( load_batch.devices[0] == device_registry::intern(device("cpu", "/proc/stat")) );
+    REQUIRE( load_batch.values[0] == 150 );
+
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+}
+
+TEST_CASE("db storage: connection options")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  const auto file_name = "storage-connection-options.db";
+
+  std::vector<thermal::device_reading> data;
+  thermal::device_reading reading;
+  reading.dev = device_registry::intern(device("foo", "origin"));
+  reading.reading.value = 45000;
+  reading.reading.time = to_time(2022, 4, 23, 12, 0, 0);
+  data.push_back(reading);
+
+  {
+    db writer(sqlite::options::for_writing());
+    REQUIRE_FALSE( writer.save(data, file_name).has_value() );
+
+    db reader(sqlite::options::for_reading());
+
+    // The reader sees the committed readings while the writer keeps its
+    // connection open, and the writer can still save new readings.
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( reader.get_latest_readings(batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 1 );
+
+    data[0].reading.time = to_time(2022, 4, 23, 12, 5, 0);
+    REQUIRE_FALSE( writer.save(data, file_name).has_value() );
+    REQUIRE_FALSE( reader.get_latest_readings(batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 2 );
+
+    // Read-only connections cannot save readings.
+    REQUIRE( reader.save(data, file_name).has_value() );
+  }
+
+  {
+    // Immutable files are read without any locking. The connection is kept
+    // for further reads of the same file.
+    sqlite::options immutable;
+    immutable.immutable = true;
+    db reader(immutable);
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( reader.get_latest_readings(batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 2 );
+    REQUIRE_FALSE( reader.get_latest_readings(batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 2 );
+    // Switching to another file and back again works, too.
+    REQUIRE( reader.get_latest_readings(batch, "/path/may-not/exist/for-real.db", std::chrono::hours(2)).has_value() );
+    REQUIRE_FALSE( reader.get_latest_readings(batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 2 );
+  }
+
+  {
+    // Readers are read-only by default, even when no writer is open.
+    db reader(sqlite::options::for_reading());
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( reader.get_latest_readings(batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 2 );
+    REQUIRE( reader.save(data, file_name).has_value() );
+  }
+
+  {
+    auto maybe_db = sqlite::database::open(file_name);
+    REQUIRE( maybe_db.has_value() );
+    auto stmt = maybe_db.value().prepare("PRAGMA journal_mode;");
+    REQUIRE( stmt.has_value() );
+    REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+    REQUIRE( std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt.value().ptr(), 0))) == "wal" );
+  }
+
+  REQUIRE( std::filesystem::remove(file_name) );
+}
+
+TEST_CASE("db storage: readers do not upgrade the schema")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  const auto file_name = "storage-readers-schema.db";
+  {
+    // Schema and data as created by older versions of thermos.
+    auto maybe_db = sqlite::database::open(file_name);
+    REQUIRE( maybe_db.has_value() );
+    REQUIRE( maybe_db.value().exec(R"SQL(
+        CREATE TABLE device (deviceId INTEGER PRIMARY KEY NOT NULL, name TEXT NOT NULL, origin TEXT NOT NULL);
+        CREATE TABLE reading (readingId INTEGER PRIMARY KEY NOT NULL, deviceId INTEGER NOT NULL, type TEXT, date TEXT, value INTEGER);
+        INSERT INTO device (deviceId, name, origin) VALUES (1, 'foo', 'here');
+        INSERT INTO reading (deviceId, type, date, value) VALUES (1, 'temperature', '2022-04-23 19:18:17', 45000);
+        )SQL") );
+  }
+
+  const auto read_only = GENERATE(true, false);
+  sqlite::options opts = sqlite::options::for_reading();
+  opts.read_only = read_only;
+  {
+    db reader(opts);
+    thermal::reading_batch batch;
+    const auto error = reader.get_latest_readings(batch, file_name, std::chrono::hours(2));
+    REQUIRE( error.has_value() );
+    REQUIRE( error.value().find("schema version 0") != std::string::npos );
+  }
+  {
+    auto maybe_db = sqlite::database::open(file_name);
+    REQUIRE( maybe_db.has_value() );
+    REQUIRE( maybe_db.value().user_version().value() == 0 );
+  }
+
+  // Once the logger has upgraded the database, readers can use it.
+  {
+    db writer(sqlite::options::for_writing());
+    REQUIRE_FALSE( writer.save(std::vector<thermal::device_reading>(), file_name).has_value() );
+  }
+  {
+    db reader(opts);
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( reader.get_latest_readings(batch, file_name, std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 1 );
+  }
+
+  REQUIRE( std::filesystem::remove(file_name) );
+}
+
+TEST_CASE("db storage: readings from rollups")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  const auto file_name = "storage-readings-from-rollups.db";
+  db store;
+  const device dev("sensor", "origin");
+  {
+    // one reading every ten minutes for three days, starting at midnight UTC
+    thermal::reading_batch batch;
+    for (int64_t i = 0; i < 3 * 24 * 6; ++i)
+    {
+      batch.push_back(device_registry::intern(dev), 1650240000 + 600 * i, 40000 + (i % 6) * 100);
+    }
+    std::vector<thermal::device_reading> data;
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+      data.push_back(batch.get(i));
+    }
+    // The writing session has to be closed before the file can be removed.
+    db writer;
+    REQUIRE_FALSE( writer.save(data, file_name).has_value() );
+  }
+
+  SECTION("coarsest resolution")
+  {
+    REQUIRE( db::coarsest_resolution(std::chrono::seconds(0)) == resolution::raw );
+    REQUIRE( db::coarsest_resolution(std::chrono::minutes(59)) == resolution::raw );
+    REQUIRE( db::coarsest_resolution(std::chrono::hours(1)) == resolution::hourly );
+    REQUIRE( db::coarsest_resolution(std::chrono::hours(23)) == resolution::hourly );
+    REQUIRE( db::coarsest_resolution(std::chrono::hours(24)) == resolution::daily );
+    REQUIRE( db::coarsest_resolution(std::chrono::hours(24 * 365)) == resolution::daily );
+  }
+
+  SECTION("raw readings")
+  {
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( store.get_device_readings(dev, batch, file_name, std::chrono::hours(2), std::chrono::minutes(30)).has_value() );
+    REQUIRE( batch.size() == 13 );
+  }
+
+  SECTION("hourly readings")
+  {
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( store.get_device_readings(dev, batch, file_name, std::chrono::hours(5), std::chrono::hours(2)).has_value() );
+    REQUIRE( batch.size() == 6 );
+    REQUIRE( batch.times[0] == 1650240000 + 3 * 86400 - 6 * 3600 );
+    REQUIRE( batch.times[5] == 1650240000 + 3 * 86400 - 3600 );
+    // average of 40000, 40100, ..., 40500
+    REQUIRE( batch.values[0] == 40250 );
+    REQUIRE( batch.devices[0] == device_registry::intern(dev) );
+
+    thermal::reading_batch latest;
+    REQUIRE_FALSE( store.get_latest_readings(latest, file_name, std::chrono::hours(5), std::chrono::hours(2)).has_value() );
+    REQUIRE( latest.times == batch.times );
+    REQUIRE( latest.values == batch.values );
+  }
+
+  SECTION("hourly extremes")
+  {
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, std::chrono::hours(5), std::chrono::hours(2), rollup_value::extremes).has_value() );
+    REQUIRE( batch.size() == 12 );
+    // minimum and maximum of each hour with the same time
+    REQUIRE( batch.times[0] == 1650240000 + 3 * 86400 - 6 * 3600 );
+    REQUIRE( batch.times[1] == batch.times[0] );
+    REQUIRE( batch.values[0] == 40000 );
+    REQUIRE( batch.values[1] == 40500 );
+    REQUIRE( batch.times[11] == 1650240000 + 3 * 86400 - 3600 );
+
+    thermal::reading_batch device_batch;
+    REQUIRE_FALSE( store.get_device_readings(dev, device_batch, file_name, std::chrono::hours(5), std::chrono::hours(2), rollup_value::extremes).has_value() );
+    REQUIRE( device_batch.times == batch.times );
+    REQUIRE( device_batch.values == batch.values );
+  }
+
+  SECTION("daily readings")
+  {
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, std::chrono::hours(24 * 365), std::chrono::hours(24 * 7)).has_value() );
+    REQUIRE( batch.size() == 3 );
+    REQUIRE( batch.times[0] == 1650240000 );
+    REQUIRE( batch.times[2] == 1650240000 + 2 * 86400 );
+    REQUIRE( batch.values[1] == 40250 );
+
+    // Rollups remain after the raw readings are gone.
+    {
+      auto maybe_db = sqlite::database::open(file_name);
+      REQUIRE( maybe_db.has_value() );
+      REQUIRE( maybe_db.value().exec("DELETE FROM reading;") );
+    }
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, std::chrono::hours(24 * 365), std::chrono::hours(24 * 7)).has_value() );
+    REQUIRE( batch.size() == 3 );
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, std::chrono::hours(24 * 365)).has_value() );
+    REQUIRE( batch.empty() );
+  }
+
+  SECTION("rollups replace readings deleted by the retention policy")
+  {
+    // Raw readings are kept for one day.
+    {
+      auto maybe_db = sqlite::database::open(file_name);
+      REQUIRE( maybe_db.has_value() );
+      REQUIRE( maybe_db.value().exec("DELETE FROM reading WHERE date < 1650240000 + 2 * 86400;") );
+    }
+    REQUIRE( store.covering_resolution(reading_type::temperature, file_name, std::chrono::hours(12), resolution::raw).value() == resolution::raw );
+    REQUIRE( store.covering_resolution(reading_type::temperature, file_name, std::chrono::hours(48), resolution::raw).value() == resolution::hourly );
+    REQUIRE( store.covering_resolution(reading_type::temperature, file_name, std::chrono::hours(48), resolution::daily).value() == resolution::daily );
+    // There are no CPU load readings at all.
+    REQUIRE( store.covering_resolution(reading_type::load, file_name, std::chrono::hours(48), resolution::raw).value() == resolution::raw );
+
+    thermal::reading_batch batch;
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, std::chrono::hours(48), std::chrono::seconds(0)).has_value() );
+    REQUIRE( batch.size() == 49 );
+    REQUIRE( batch.times[0] == 1650240000 + 3 * 86400 - 3600 - 48 * 3600 );
+    REQUIRE( batch.times[48] == 1650240000 + 3 * 86400 - 3600 );
+
+    thermal::reading_batch device_batch;
+    REQUIRE_FALSE( store.get_device_readings(dev, device_batch, file_name, std::chrono::hours(48), std::chrono::seconds(0)).has_value() );
+    REQUIRE( device_batch.times == batch.times );
+
+    // An explicit resolution is used as it is.
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, std::chrono::hours(48), resolution::raw).has_value() );
+    REQUIRE( batch.size() == 144 );
+
+    // Hourly rollups are kept for two days.
+    {
+      auto maybe_db = sqlite::database::open(file_name);
+      REQUIRE( maybe_db.has_value() );
+      REQUIRE( maybe_db.value().exec("DELETE FROM rollup_hour WHERE bucket < 1650240000 + 86400;") );
+    }
+    REQUIRE( store.covering_resolution(reading_type::temperature, file_name, std::chrono::hours(24), resolution::raw).value() == resolution::hourly );
+    REQUIRE( store.covering_resolution(reading_type::temperature, file_name, std::chrono::hours(48), resolution::raw).value() == resolution::daily );
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, std::chrono::hours(48), std::chrono::seconds(0)).has_value() );
+    REQUIRE( batch.size() == 3 );
+    REQUIRE( batch.times[0] == 1650240000 );
+  }
+
+  REQUIRE( std::filesystem::remove(file_name) );
+}
 #endif // SQLite feature guard
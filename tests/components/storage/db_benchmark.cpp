@@ -0,0 +1,185 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+// Benchmarks for the database storage. They are hidden from the default test
+// run, because they take a while. Run them explicitly via
+//
+//     component_tests "[benchmark]"
+
+#include "../find_catch.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include "../../../lib/storage/db.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+namespace
+{
+
+std::vector<thermos::thermal::device_reading> generate_readings(const std::size_t count, const std::size_t devices)
+{
+  std::vector<thermos::thermal::device_reading> data;
+  data.reserve(count);
+  thermos::thermal::device_reading reading;
+  const auto start = std::chrono::system_clock::now();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    reading.dev = thermos::device_registry::intern(thermos::device("sensor " + std::to_string(i % devices),
+        "/sys/class/hwmon/hwmon" + std::to_string(i % devices) + "/temp1_input"));
+    reading.reading.value = 40000 + static_cast<int64_t>(i % 1000);
+    reading.reading.time = start + std::chrono::seconds(300 * (i / devices));
+    data.push_back(reading);
+  }
+  return data;
+}
+
+/* Inserts readings the way db::save() did before bulk inserts were used:
+   one autocommit statement per reading, with a device lookup per reading. */
+void legacy_insert(thermos::sqlite::database& db, const std::vector<thermos::thermal::device_reading>& data)
+{
+  using namespace thermos;
+  for (const auto& reading: data)
+  {
+    const auto& dev = device_registry::get(reading.dev);
+    int64_t dev_id = 0;
+    {
+      auto stmt = db.prepare("SELECT deviceId FROM device WHERE origin = @ori AND name = @name LIMIT 1;");
+      REQUIRE( stmt.has_value() );
+      REQUIRE( stmt.value().bind(1, dev.origin) );
+      REQUIRE( stmt.value().bind(2, dev.name) );
+      if (sqlite3_step(stmt.value().ptr()) == SQLITE_ROW)
+      {
+        dev_id = sqlite3_column_int64(stmt.value().ptr(), 0);
+      }
+    }
+    if (dev_id == 0)
+    {
+      REQUIRE( db.exec("INSERT INTO device (origin, name) VALUES ("
+                       + sqlite::database::quote(dev.origin) + ", "
+                       + sqlite::database::quote(dev.name) + ");") );
+      dev_id = db.last_insert_id();
+    }
+    const auto time_string = storage::time_to_string(reading.reading.time);
+    REQUIRE( time_string.has_value() );
+    REQUIRE( db.exec("INSERT INTO reading (deviceId, type, date, value) VALUES ("
+             + std::to_string(dev_id) + ", '" + to_string(reading.reading.type())
+             + "', '" + time_string.value() + "', " + std::to_string(reading.reading.value)
+             + ");") );
+  }
+}
+
+double rows_per_second(const std::size_t rows, const std::chrono::steady_clock::duration elapsed)
+{
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0.0 ? static_cast<double>(rows) / seconds : 0.0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("db storage: benchmark inserts", "[.][benchmark]")
+{
+  using namespace thermos;
+
+  constexpr std::size_t rows = 10000;
+  constexpr std::size_t devices = 25;
+  const auto data = generate_readings(rows, devices);
+
+  // per-row autocommit (previous implementation)
+  const auto legacy_file = "benchmark-insert-legacy.db";
+  {
+    storage::db store;
+    // Saving an empty batch just creates the schema.
+    REQUIRE_FALSE( store.save(std::vector<thermal::device_reading>(), legacy_file).has_value() );
+  }
+  const auto legacy_start = std::chrono::steady_clock::now();
+  {
+    auto maybe_db = sqlite::database::open(legacy_file);
+    REQUIRE( maybe_db.has_value() );
+    legacy_insert(maybe_db.value(), data);
+  }
+  const auto legacy_elapsed = std::chrono::steady_clock::now() - legacy_start;
+
+  // bulk insert via db::save()
+  const auto bulk_file = "benchmark-insert-bulk.db";
+  const auto bulk_start = std::chrono::steady_clock::now();
+  {
+    storage::db store;
+    REQUIRE_FALSE( store.save(data, bulk_file).has_value() );
+  }
+  const auto bulk_elapsed = std::chrono::steady_clock::now() - bulk_start;
+
+  std::cout << "Inserting " << rows << " readings of " << devices << " devices:\n"
+            << "  per-row autocommit: " << rows_per_second(rows, legacy_elapsed) << " rows/s\n"
+            << "  bulk transaction:   " << rows_per_second(rows, bulk_elapsed) << " rows/s\n";
+
+  REQUIRE( std::filesystem::remove(legacy_file) );
+  REQUIRE( std::filesystem::remove(bulk_file) );
+}
+
+TEST_CASE("db storage: benchmark rollups", "[.][benchmark]")
+{
+  using namespace thermos;
+
+  // one reading every five minutes of eight sensors for one year
+  constexpr int64_t devices = 8;
+  constexpr int64_t rows = devices * 365 * 24 * 12;
+  const auto file_name = "benchmark-rollups.db";
+  {
+    storage::db store;
+    // Saving an empty batch just creates the schema.
+    REQUIRE_FALSE( store.save(std::vector<thermal::device_reading>(), file_name).has_value() );
+  }
+  const auto insert_start = std::chrono::steady_clock::now();
+  {
+    auto maybe_db = sqlite::database::open(file_name);
+    REQUIRE( maybe_db.has_value() );
+    auto& dbase = maybe_db.value();
+    REQUIRE( dbase.exec("INSERT INTO device (deviceId, origin, name) "
+        "WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < "
+        + std::to_string(devices) + ") "
+        "SELECT i, '/sys/class/hwmon/hwmon' || i || '/temp1_input', 'sensor ' || i FROM n;") );
+    // The trigger updates the rollups for every inserted reading.
+    REQUIRE( dbase.exec("INSERT INTO reading (deviceId, type, date, value) "
+        "WITH RECURSIVE n(i) AS (SELECT 0 UNION ALL SELECT i + 1 FROM n WHERE i < "
+        + std::to_string(rows) + " - 1) "
+        "SELECT i % " + std::to_string(devices) + " + 1, 'temperature', "
+        "1650000000 + 300 * (i / " + std::to_string(devices) + "), 40000 + i % 1000 FROM n;") );
+  }
+  const auto insert_elapsed = std::chrono::steady_clock::now() - insert_start;
+
+  std::cout << "Inserting " << rows << " readings of " << devices << " devices, including rollups: "
+            << rows_per_second(rows, insert_elapsed) << " rows/s\n"
+            << "Loading readings of one year:\n";
+  const std::chrono::hours year(365 * 24);
+  for (const auto max_interval: { std::chrono::hours(0), std::chrono::hours(1), std::chrono::hours(24) })
+  {
+    storage::db store;
+    thermal::reading_batch batch;
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE_FALSE( store.get_latest_readings(batch, file_name, year, max_interval).has_value() );
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    REQUIRE_FALSE( batch.empty() );
+    std::cout << "  max. interval " << max_interval.count() << " h: " << batch.size() << " readings in "
+              << std::chrono::duration<double, std::milli>(elapsed).count() << " ms\n";
+  }
+
+  REQUIRE( std::filesystem::remove(file_name) );
+}
+#endif // SQLite feature guard
@@ -0,0 +1,78 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/storage/retention.hpp"
+
+TEST_CASE("retention_policy")
+{
+  using namespace thermos::storage;
+  using namespace std::chrono_literals;
+
+  SECTION("default policy keeps everything")
+  {
+    const retention_policy policy;
+    REQUIRE( policy.keeps_everything() );
+  }
+
+  SECTION("parse all resolutions")
+  {
+    const auto policy = retention_policy::parse("raw=14d,hourly=1y,daily=48h");
+    REQUIRE( policy.has_value() );
+    REQUIRE( policy.value().raw == std::optional(24h * 14) );
+    REQUIRE( policy.value().hourly == std::optional(24h * 365) );
+    REQUIRE( policy.value().daily == std::optional(48h) );
+    REQUIRE_FALSE( policy.value().keeps_everything() );
+  }
+
+  SECTION("missing resolutions are kept forever")
+  {
+    const auto policy = retention_policy::parse("hourly=30d");
+    REQUIRE( policy.has_value() );
+    REQUIRE_FALSE( policy.value().raw.has_value() );
+    REQUIRE( policy.value().hourly == std::optional(24h * 30) );
+    REQUIRE_FALSE( policy.value().daily.has_value() );
+  }
+
+  SECTION("forever")
+  {
+    const auto policy = retention_policy::parse("daily=forever,raw=forever");
+    REQUIRE( policy.has_value() );
+    REQUIRE( policy.value().keeps_everything() );
+  }
+
+  SECTION("invalid policies")
+  {
+    REQUIRE_FALSE( retention_policy::parse("").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=d").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=14").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=14w").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=0d").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=-1d").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=1.5d").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=99999999999y").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("weekly=1y").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=1d,raw=2d").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw=1d,").has_value() );
+    REQUIRE_FALSE( retention_policy::parse("raw = 1d").has_value() );
+  }
+}
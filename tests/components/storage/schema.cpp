@@ -0,0 +1,177 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/storage/schema.hpp"
+#include "../../../lib/storage/utilities.hpp"
+#include "to_time.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+namespace
+{
+
+bool index_exists(thermos::sqlite::database& db, const std::string& name)
+{
+  auto stmt = db.prepare("SELECT COUNT(*) FROM sqlite_master WHERE type='index' AND name = @n;");
+  REQUIRE( stmt.has_value() );
+  REQUIRE( stmt.value().bind(1, name) );
+  REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+  return sqlite3_column_int(stmt.value().ptr(), 0) > 0;
+}
+
+int64_t query_int(thermos::sqlite::database& db, const std::string& sql)
+{
+  auto stmt = db.prepare(sql);
+  REQUIRE( stmt.has_value() );
+  REQUIRE( sqlite3_step(stmt.value().ptr()) == SQLITE_ROW );
+  return sqlite3_column_int64(stmt.value().ptr(), 0);
+}
+
+} // anonymous namespace
+
+TEST_CASE("storage schema")
+{
+  using namespace thermos::sqlite;
+  using namespace thermos::storage;
+
+  auto possible_db = database::open(":memory:");
+  REQUIRE( possible_db.has_value() );
+  auto& db = possible_db.value();
+
+  SECTION("new database gets current schema")
+  {
+    REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+
+    REQUIRE( db.table_exists("device").value() );
+    REQUIRE( db.table_exists("reading").value() );
+    REQUIRE( db.user_version().value() == schema::current_version );
+    REQUIRE( index_exists(db, "device_origin_name") );
+    REQUIRE( index_exists(db, "reading_device_type_date") );
+    REQUIRE( index_exists(db, "reading_type_device") );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM pragma_table_info('reading') WHERE name = 'date' AND type = 'INTEGER';") == 1 );
+    REQUIRE( db.table_exists("rollup_hour").value() );
+    REQUIRE( db.table_exists("rollup_day").value() );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM sqlite_master WHERE type = 'trigger' AND name = 'reading_rollup';") == 1 );
+
+    // Second call does not change anything.
+    REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+    REQUIRE( db.user_version().value() == schema::current_version );
+  }
+
+  SECTION("migration of version zero merges devices and converts dates")
+  {
+    // Schema and data as created by older versions of thermos.
+    REQUIRE( db.exec(R"SQL(
+        CREATE TABLE device (deviceId INTEGER PRIMARY KEY NOT NULL, name TEXT NOT NULL, origin TEXT NOT NULL);
+        CREATE TABLE reading (readingId INTEGER PRIMARY KEY NOT NULL, deviceId INTEGER NOT NULL, type TEXT, date TEXT, value INTEGER);
+        INSERT INTO device (deviceId, name, origin) VALUES (1, 'foo', 'here'), (2, 'bar', 'here'), (3, 'foo', 'here'), (4, 'foo', 'there');
+        INSERT INTO reading (deviceId, type, date, value) VALUES
+          (1, 'temperature', '2022-04-23 19:18:17', 1),
+          (2, 'temperature', '2022-04-23 19:18:17', 2),
+          (3, 'temperature', '2022-04-23 19:23:17', 3),
+          (4, 'temperature', '2022-04-23 19:23:17', 4);
+        )SQL") );
+
+    REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+    REQUIRE( db.user_version().value() == schema::current_version );
+
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM device;") == 3 );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading;") == 4 );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading WHERE deviceId = 1;") == 2 );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading WHERE deviceId = 3;") == 0 );
+    REQUIRE( query_int(db, "SELECT deviceId FROM reading WHERE value = 4;") == 4 );
+
+    // Dates are converted from local time text to epoch seconds.
+    REQUIRE( query_int(db, "SELECT date FROM reading WHERE value = 1;")
+             == time_to_epoch(to_time(2022, 4, 23, 19, 18, 17)) );
+    REQUIRE( query_int(db, "SELECT date FROM reading WHERE value = 3;")
+             == time_to_epoch(to_time(2022, 4, 23, 19, 23, 17)) );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM reading WHERE typeof(date) <> 'integer';") == 0 );
+
+    // Unique index prevents new duplicates.
+    REQUIRE_FALSE( db.exec("INSERT INTO device (name, origin) VALUES ('foo', 'here');") );
+
+    // Existing readings are aggregated into the rollups.
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM rollup_hour;") == 3 );
+    REQUIRE( query_int(db, "SELECT value_count FROM rollup_hour WHERE deviceId = 1;") == 2 );
+    REQUIRE( query_int(db, "SELECT value_sum FROM rollup_hour WHERE deviceId = 1;") == 4 );
+    REQUIRE( query_int(db, "SELECT min_value FROM rollup_day WHERE deviceId = 1;") == 1 );
+    REQUIRE( query_int(db, "SELECT max_value FROM rollup_day WHERE deviceId = 1;") == 3 );
+  }
+
+  SECTION("inserted readings update the rollups")
+  {
+    REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+    REQUIRE( db.exec(R"SQL(
+        INSERT INTO device (deviceId, name, origin) VALUES (1, 'foo', 'here');
+        INSERT INTO reading (deviceId, type, date, value) VALUES
+          (1, 'temperature', 1650000000, 40000),
+          (1, 'temperature', 1650000300, 42000),
+          (1, 'temperature', 1650000600, 35000),
+          (1, 'load', 1650000600, 25),
+          (1, 'temperature', 1650006000, 41000),
+          (1, 'temperature', NULL, 41000);
+        )SQL") );
+
+    // 1650000000 is 05:20 UTC, so the first three readings are in one hour.
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM rollup_hour WHERE type = 'temperature';") == 2 );
+    REQUIRE( query_int(db, "SELECT bucket FROM rollup_hour WHERE type = 'temperature' ORDER BY bucket LIMIT 1;") == 1649998800 );
+    REQUIRE( query_int(db, "SELECT min_value FROM rollup_hour WHERE bucket = 1649998800 AND type = 'temperature';") == 35000 );
+    REQUIRE( query_int(db, "SELECT max_value FROM rollup_hour WHERE bucket = 1649998800 AND type = 'temperature';") == 42000 );
+    REQUIRE( query_int(db, "SELECT value_sum FROM rollup_hour WHERE bucket = 1649998800 AND type = 'temperature';") == 117000 );
+    REQUIRE( query_int(db, "SELECT value_count FROM rollup_hour WHERE bucket = 1649998800 AND type = 'temperature';") == 3 );
+    REQUIRE( query_int(db, "SELECT COUNT(*) FROM rollup_day WHERE type = 'temperature';") == 1 );
+    REQUIRE( query_int(db, "SELECT bucket FROM rollup_day WHERE type = 'temperature';") == 1649980800 );
+    REQUIRE( query_int(db, "SELECT value_count FROM rollup_day WHERE type = 'temperature';") == 4 );
+    REQUIRE( query_int(db, "SELECT value_sum FROM rollup_day WHERE type = 'load';") == 25 );
+
+    // Deleting readings keeps the aggregates.
+    REQUIRE( db.exec("DELETE FROM reading;") );
+    REQUIRE( query_int(db, "SELECT SUM(value_count) FROM rollup_day;") == 5 );
+  }
+
+  SECTION("newer schema version is rejected")
+  {
+    REQUIRE( db.set_user_version(schema::current_version + 1) );
+    auto error = schema::ensure_current(db);
+    REQUIRE( error.has_value() );
+    REQUIRE( error.value().find("newer version") != std::string::npos );
+    error = schema::check_current(db);
+    REQUIRE( error.has_value() );
+    REQUIRE( error.value().find("newer version") != std::string::npos );
+  }
+
+  SECTION("check accepts only the current schema and changes nothing")
+  {
+    REQUIRE( db.exec(R"SQL(
+        CREATE TABLE device (deviceId INTEGER PRIMARY KEY NOT NULL, name TEXT NOT NULL, origin TEXT NOT NULL);
+        CREATE TABLE reading (readingId INTEGER PRIMARY KEY NOT NULL, deviceId INTEGER NOT NULL, type TEXT, date TEXT, value INTEGER);
+        )SQL") );
+    const auto error = schema::check_current(db);
+    REQUIRE( error.has_value() );
+    REQUIRE( error.value().find("thermos-logger") != std::string::npos );
+    REQUIRE( db.user_version().value() == 0 );
+    REQUIRE_FALSE( index_exists(db, "device_origin_name") );
+
+    REQUIRE_FALSE( schema::ensure_current(db).has_value() );
+    REQUIRE_FALSE( schema::check_current(db).has_value() );
+  }
+}
+#endif // SQLite feature guard
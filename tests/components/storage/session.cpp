@@ -0,0 +1,157 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <filesystem>
+#include "../../../lib/storage/db.hpp"
+#include "../../../lib/storage/session.hpp"
+#include "to_time.hpp"
+
+#if !defined(THERMOS_NO_SQLITE)
+TEST_CASE("storage session")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  SECTION("file cannot be opened / created")
+  {
+    const auto s = session::open("/path/may-not/exist/for-real.db");
+    REQUIRE_FALSE( s.has_value() );
+    REQUIRE( s.error().find("Could not open") != std::string::npos );
+  }
+
+  SECTION("open creates tables")
+  {
+    const auto file_name = "session-open-creates-tables.db";
+    {
+      auto s = session::open(file_name);
+      REQUIRE( s.has_value() );
+      REQUIRE( s.value().file_name() == file_name );
+
+      const auto exists = s.value().database().table_exists("reading");
+      REQUIRE( exists.has_value() );
+      REQUIRE( exists.value() );
+    }
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+
+  SECTION("device ids are stable")
+  {
+    const auto file_name = "session-device-ids.db";
+    {
+      auto s = session::open(file_name);
+      REQUIRE( s.has_value() );
+      auto& sess = s.value();
+
+      device first;
+      first.name = "foo";
+      first.origin = "origin";
+      device second;
+      second.name = "bar";
+      second.origin = "origin";
+      const auto id_first = sess.device_id(device_registry::intern(first));
+      REQUIRE( id_first.has_value() );
+      const auto id_second = sess.device_id(device_registry::intern(second));
+      REQUIRE( id_second.has_value() );
+      REQUIRE( id_first.value() != id_second.value() );
+
+      const auto id_again = sess.device_id(device_registry::intern(first));
+      REQUIRE( id_again.has_value() );
+      REQUIRE( id_again.value() == id_first.value() );
+    }
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+
+  SECTION("multiple inserts on one session")
+  {
+    const auto file_name = "session-multiple-inserts.db";
+    {
+      auto s = session::open(file_name);
+      REQUIRE( s.has_value() );
+      auto& sess = s.value();
+
+      std::vector<thermal::device_reading> data;
+      thermal::device_reading reading;
+      reading.dev = device_registry::intern(device("foo", "origin"));
+      reading.reading.value = 42000;
+      reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
+      data.push_back(reading);
+
+      // Empty data is a no-op.
+      REQUIRE_FALSE( sess.insert(std::vector<thermal::device_reading>()).has_value() );
+
+      for (int i = 0; i < 3; ++i)
+      {
+        data[0].reading.time = to_time(2022, 4, 23, 19, 20 + i, 17);
+        REQUIRE_FALSE( sess.insert(data).has_value() );
+      }
+    }
+
+    db store;
+    std::vector<thermal::device_reading> loaded;
+    REQUIRE_FALSE( store.load(loaded, file_name).has_value() );
+    REQUIRE( loaded.size() == 3 );
+    REQUIRE( loaded[0].reading.time == to_time(2022, 4, 23, 19, 20, 17) );
+    REQUIRE( loaded[2].reading.time == to_time(2022, 4, 23, 19, 22, 17) );
+    REQUIRE( device_registry::get(loaded[2].dev).name == "foo" );
+
+    REQUIRE( std::filesystem::remove(file_name) );
+  }
+}
+
+TEST_CASE("db storage: repeated saves to the same and other files")
+{
+  using namespace thermos;
+  using namespace thermos::storage;
+
+  const auto first_file = "db-repeated-saves-first.db";
+  const auto second_file = "db-repeated-saves-second.db";
+
+  std::vector<load::device_reading> data;
+  load::device_reading reading;
+  reading.dev = device_registry::intern(device("cpu", "/proc/loadavg"));
+  reading.reading.value = 150;
+  reading.reading.time = to_time(2022, 4, 23, 19, 18, 17);
+  data.push_back(reading);
+
+  {
+    db store;
+    REQUIRE_FALSE( store.save(data, first_file).has_value() );
+    REQUIRE_FALSE( store.save(data, first_file).has_value() );
+    REQUIRE_FALSE( store.save(data, second_file).has_value() );
+    REQUIRE_FALSE( store.save(data, first_file).has_value() );
+  }
+
+  db store;
+  std::vector<load::device_reading> loaded;
+  REQUIRE_FALSE( store.load(loaded, first_file).has_value() );
+  REQUIRE( loaded.size() == 3 );
+  loaded.clear();
+  REQUIRE_FALSE( store.load(loaded, second_file).has_value() );
+  REQUIRE( loaded.size() == 1 );
+
+  std::vector<device> devices;
+  REQUIRE_FALSE( store.get_devices(devices, reading_type::load, first_file).has_value() );
+  REQUIRE( devices.size() == 1 );
+
+  REQUIRE( std::filesystem::remove(first_file) );
+  REQUIRE( std::filesystem::remove(second_file) );
+}
+#endif
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,7 @@
 */
 
 #include "../find_catch.hpp"
+#include <ctime>
 #include "../../../lib/storage/utilities.hpp"
 
 TEST_CASE("time_to_string function")
@@ -97,6 +98,91 @@ TEST_CASE("time_to_string function")
   }
 }
 
+TEST_CASE("time_formatter")
+{
+  using namespace thermos::storage;
+
+  const auto expected_string = [](const std::time_t tt)
+  {
+    std::tm tm{};
+    #if !defined(_MSC_VER) && !defined(__MINGW32__) && !defined(__MINGW64__)
+    localtime_r(&tt, &tm);
+    #else
+    localtime_s(&tm, &tt);
+    #endif
+    char buffer[32];
+    const auto len = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
+    return std::string(buffer, len);
+  };
+
+  SECTION("specific date")
+  {
+    std::tm tm{};
+    tm.tm_year = 2022 - 1900;
+    tm.tm_mon = 4 - 1;
+    tm.tm_mday = 23;
+    tm.tm_hour = 19;
+    tm.tm_min = 8;
+    tm.tm_sec = 1;
+    tm.tm_isdst = -1;
+    const std::time_t tt = std::mktime(&tm);
+    REQUIRE( tt != static_cast<std::time_t>(-1) );
+
+    time_formatter formatter;
+    time_formatter::buffer_t buffer;
+    REQUIRE_FALSE( formatter.format(std::chrono::system_clock::from_time_t(tt), buffer).has_value() );
+    REQUIRE( std::string(buffer.data(), buffer.size()) == "2022-04-23 19:08:01" );
+
+    // Same day, later time
+    REQUIRE_FALSE( formatter.format(std::chrono::system_clock::from_time_t(tt + 3 * 3600 + 59), buffer).has_value() );
+    REQUIRE( std::string(buffer.data(), buffer.size()) == "2022-04-23 22:09:00" );
+
+    // Same day, earlier time
+    REQUIRE_FALSE( formatter.format(std::chrono::system_clock::from_time_t(tt - 19 * 3600 - 8 * 60 - 1), buffer).has_value() );
+    REQUIRE( std::string(buffer.data(), buffer.size()) == "2022-04-23 00:00:00" );
+
+    // Previous day
+    REQUIRE_FALSE( formatter.format(std::chrono::system_clock::from_time_t(tt - 19 * 3600 - 8 * 60 - 2), buffer).has_value() );
+    REQUIRE( std::string(buffer.data(), buffer.size()) == "2022-04-22 23:59:59" );
+  }
+
+  SECTION("matches localtime for a whole year")
+  {
+    // Steps of 17 minutes and 3 seconds include any DST transitions of the
+    // local time zone and all kinds of times of the day.
+    time_formatter formatter;
+    time_formatter::buffer_t buffer;
+    int mismatches = 0;
+    const std::time_t start = 1640995200; // 2022-01-01 00:00:00 UTC
+    for (std::time_t tt = start; tt < start + 366 * 86400; tt += 17 * 60 + 3)
+    {
+      if (formatter.format(std::chrono::system_clock::from_time_t(tt), buffer).has_value()
+          || (std::string(buffer.data(), buffer.size()) != expected_string(tt)))
+      {
+        ++mismatches;
+      }
+    }
+    REQUIRE( mismatches == 0 );
+  }
+
+  SECTION("matches localtime in reverse order")
+  {
+    time_formatter formatter;
+    time_formatter::buffer_t buffer;
+    int mismatches = 0;
+    const std::time_t end = 1672531200; // 2023-01-01 00:00:00 UTC
+    for (std::time_t tt = end; tt > end - 366 * 86400; tt -= 23 * 60 + 7)
+    {
+      if (formatter.format(std::chrono::system_clock::from_time_t(tt), buffer).has_value()
+          || (std::string(buffer.data(), buffer.size()) != expected_string(tt)))
+      {
+        ++mismatches;
+      }
+    }
+    REQUIRE( mismatches == 0 );
+  }
+}
+
 TEST_CASE("string_to_time function")
 {
   using namespace thermos::storage;
@@ -242,6 +328,44 @@ TEST_CASE("string_to_time function")
   }
 }
 
+TEST_CASE("string_to_time matches mktime")
+{
+  using namespace thermos::storage;
+
+  // Covers a whole year in steps of 17 minutes, so that any DST transitions
+  // of the local time zone are included.
+  const auto start = std::chrono::system_clock::from_time_t(1640995200); // 2022-01-01 00:00:00 UTC
+  int mismatches = 0;
+  for (int i = 0; i < 366 * 24 * 60 / 17; ++i)
+  {
+    const auto time = start + std::chrono::minutes(17 * i);
+    const auto str = time_to_string(time);
+    if (!str.has_value())
+    {
+      ++mismatches;
+      continue;
+    }
+    const std::string& s = str.value();
+
+    std::tm tm{};
+    tm.tm_year = std::stoi(s.substr(0, 4)) - 1900;
+    tm.tm_mon = std::stoi(s.substr(5, 2)) - 1;
+    tm.tm_mday = std::stoi(s.substr(8, 2));
+    tm.tm_hour = std::stoi(s.substr(11, 2));
+    tm.tm_min = std::stoi(s.substr(14, 2));
+    tm.tm_sec = std::stoi(s.substr(17, 2));
+    tm.tm_isdst = -1;
+    const std::time_t tt = std::mktime(&tm);
+
+    const auto parsed = string_to_time(s);
+    if (!parsed.has_value() || (parsed.value() != std::chrono::system_clock::from_time_t(tt)))
+    {
+      ++mismatches;
+    }
+  }
+  REQUIRE( mismatches == 0 );
+}
+
 TEST_CASE("time_to_string and string_to_time roundtrip")
 {
   using namespace thermos::storage;
@@ -264,3 +388,36 @@ TEST_CASE("time_to_string and string_to_time roundtrip")
     REQUIRE( s.value() == "2030-12-24 19:20:35");
   }
 }
+
+TEST_CASE("time_to_epoch and epoch_to_time")
+{
+  using namespace thermos::storage;
+
+  SECTION("Unix epoch is zero")
+  {
+    const auto epoch = std::chrono::system_clock::from_time_t(0);
+    REQUIRE( time_to_epoch(epoch) == 0 );
+    REQUIRE( epoch_to_time(0) == epoch );
+  }
+
+  SECTION("specific date")
+  {
+    // 2022-04-23 19:08:01 UTC
+    const int64_t seconds = 1650740881;
+    const auto time = epoch_to_time(seconds);
+    REQUIRE( std::chrono::system_clock::to_time_t(time) == seconds );
+    REQUIRE( time_to_epoch(time) == seconds );
+  }
+
+  SECTION("fractions of a second are discarded")
+  {
+    const auto time = epoch_to_time(1650740881) + std::chrono::milliseconds(999);
+    REQUIRE( time_to_epoch(time) == 1650740881 );
+  }
+
+  SECTION("roundtrip with now()")
+  {
+    const auto now = std::chrono::floor<std::chrono::seconds>(std::chrono::system_clock::now());
+    REQUIRE( epoch_to_time(time_to_epoch(now)) == now );
+  }
+}
@@ -0,0 +1,197 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+// Benchmarks for the time conversion functions. They are hidden from the
+// default test run, because they take a while. Run them explicitly via
+//
+//     component_tests "[benchmark]"
+
+#include "../find_catch.hpp"
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../../lib/storage/utilities.hpp"
+
+namespace
+{
+
+/* Parses a date the way string_to_time() did before: std::stoi on substring
+   temporaries and mktime() for every value. Validation is omitted. */
+std::chrono::system_clock::time_point legacy_string_to_time(const std::string& value)
+{
+  std::size_t pos;
+  struct tm tm;
+  tm.tm_year = std::stoi(value, &pos) - 1900;
+  tm.tm_mon = std::stoi(value.substr(5, 2), &pos) - 1;
+  tm.tm_mday = std::stoi(value.substr(8, 2), &pos);
+  tm.tm_hour = std::stoi(value.substr(11, 2), &pos);
+  tm.tm_min = std::stoi(value.substr(14, 2), &pos);
+  tm.tm_sec = std::stoi(value.substr(17, 2), &pos);
+  tm.tm_isdst = -1;
+  return std::chrono::system_clock::from_time_t(mktime(&tm));
+}
+
+/* Formats a time point the way time_to_string() did before: localtime_r()
+   for every value and a chain of std::to_string() temporaries. */
+std::string legacy_time_to_string(const std::chrono::system_clock::time_point& date_time)
+{
+  const std::time_t tt = std::chrono::system_clock::to_time_t(date_time);
+  struct tm tm;
+  #if !defined(_MSC_VER) && !defined(__MINGW32__) && !defined(__MINGW64__)
+  localtime_r(&tt, &tm);
+  #else
+  localtime_s(&tm, &tt);
+  #endif
+  const int realYear = tm.tm_year + 1900;
+  const int realMonth = tm.tm_mon + 1;
+  return std::string((realYear < 1000) + (realYear < 100) + (realYear < 10), '0')
+         .append(std::to_string(realYear))
+         .append("-")
+         .append(realMonth < 10, '0').append(std::to_string(realMonth))
+         .append("-")
+         .append(tm.tm_mday < 10, '0').append(std::to_string(tm.tm_mday))
+         .append(" ")
+         .append(tm.tm_hour < 10, '0').append(std::to_string(tm.tm_hour))
+         .append(":")
+         .append(tm.tm_min < 10, '0').append(std::to_string(tm.tm_min))
+         .append(":")
+         .append(tm.tm_sec < 10, '0').append(std::to_string(tm.tm_sec));
+}
+
+double per_second(const std::size_t count, const std::chrono::steady_clock::duration elapsed)
+{
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("string_to_time: benchmark", "[.][benchmark]")
+{
+  using namespace thermos::storage;
+
+  // One timestamp every 30 seconds, i. e. roughly one year of data.
+  constexpr std::size_t count = 1000000;
+  const auto start = std::chrono::system_clock::from_time_t(1640995200);
+  std::vector<std::string> dates;
+  dates.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto str = time_to_string(start + std::chrono::seconds(30 * i));
+    dates.push_back(str.value_or(""));
+  }
+
+  // Sums of the epoch values keep the compiler from discarding the results
+  // and allow to check that both variants agree.
+  int64_t legacy_sum = 0;
+  const auto legacy_start = std::chrono::steady_clock::now();
+  for (const auto& date: dates)
+  {
+    legacy_sum += std::chrono::system_clock::to_time_t(legacy_string_to_time(date));
+  }
+  const auto legacy_elapsed = std::chrono::steady_clock::now() - legacy_start;
+
+  int64_t fast_sum = 0;
+  std::size_t failures = 0;
+  const auto fast_start = std::chrono::steady_clock::now();
+  for (const auto& date: dates)
+  {
+    const auto time = string_to_time(date);
+    if (time.has_value())
+    {
+      fast_sum += time_to_epoch(time.value());
+    }
+    else
+    {
+      ++failures;
+    }
+  }
+  const auto fast_elapsed = std::chrono::steady_clock::now() - fast_start;
+
+  std::cout << "Parsing " << count << " timestamps:\n"
+            << "  stoi + mktime:        " << per_second(count, legacy_elapsed) << " values/s\n"
+            << "  digits + day offsets: " << per_second(count, fast_elapsed) << " values/s\n";
+
+  REQUIRE( failures == 0 );
+  REQUIRE( fast_sum == legacy_sum );
+}
+
+TEST_CASE("time_formatter: benchmark", "[.][benchmark]")
+{
+  using namespace thermos::storage;
+
+  // A synthetic year of readings: eight devices are read every five minutes,
+  // so every timestamp occurs eight times in a row.
+  constexpr std::size_t devices = 8;
+  constexpr std::size_t intervals = 365 * 24 * 12;
+  constexpr std::size_t count = devices * intervals;
+  const auto start = std::chrono::system_clock::from_time_t(1640995200);
+  std::vector<std::chrono::system_clock::time_point> times;
+  times.reserve(count);
+  for (std::size_t i = 0; i < intervals; ++i)
+  {
+    for (std::size_t d = 0; d < devices; ++d)
+    {
+      times.push_back(start + std::chrono::seconds(300 * i + d));
+    }
+  }
+
+  // Total length of all strings / sum of all characters keeps the compiler
+  // from discarding the results and allows to compare both variants.
+  std::size_t legacy_sum = 0;
+  const auto legacy_start = std::chrono::steady_clock::now();
+  for (const auto& time: times)
+  {
+    const std::string str = legacy_time_to_string(time);
+    for (const char c: str)
+    {
+      legacy_sum += static_cast<unsigned char>(c);
+    }
+  }
+  const auto legacy_elapsed = std::chrono::steady_clock::now() - legacy_start;
+
+  std::size_t formatter_sum = 0;
+  std::size_t failures = 0;
+  const auto formatter_start = std::chrono::steady_clock::now();
+  time_formatter formatter;
+  time_formatter::buffer_t buffer;
+  for (const auto& time: times)
+  {
+    if (formatter.format(time, buffer).has_value())
+    {
+      ++failures;
+      continue;
+    }
+    for (const char c: buffer)
+    {
+      formatter_sum += static_cast<unsigned char>(c);
+    }
+  }
+  const auto formatter_elapsed = std::chrono::steady_clock::now() - formatter_start;
+
+  std::cout << "Formatting " << count << " timestamps:\n"
+            << "  localtime + to_string: " << per_second(count, legacy_elapsed) << " values/s\n"
+            << "  time_formatter:        " << per_second(count, formatter_elapsed) << " values/s\n";
+
+  REQUIRE( failures == 0 );
+  REQUIRE( formatter_sum == legacy_sum );
+}
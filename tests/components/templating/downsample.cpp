@@ -0,0 +1,156 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include <algorithm>
+#include "../../../lib/templating/downsample.hpp"
+#include "../../../lib/thermal/reading.hpp"
+
+namespace
+{
+
+/* Creates readings of a sine-like zigzag pattern with one reading per minute
+   and a single spike. */
+void fill(std::vector<int64_t>& times, std::vector<int64_t>& values, const std::size_t count, const std::size_t spike)
+{
+  times.clear();
+  values.clear();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    times.push_back(1650000000 + 60 * static_cast<int64_t>(i));
+    values.push_back(40000 + static_cast<int64_t>(i % 20) * 100);
+  }
+  values[spike] = 90000;
+}
+
+} // anonymous namespace
+
+TEST_CASE("downsampling method names")
+{
+  using namespace thermos;
+
+  for (const auto method: { downsampling_method::none, downsampling_method::lttb,
+                            downsampling_method::min_max, downsampling_method::average })
+  {
+    const auto parsed = parse_downsampling_method(to_string(method));
+    REQUIRE( parsed.has_value() );
+    REQUIRE( parsed.value() == method );
+  }
+  REQUIRE( to_string(downsampling_method::min_max) == "minmax" );
+  REQUIRE_FALSE( parse_downsampling_method("").has_value() );
+  REQUIRE_FALSE( parse_downsampling_method("LTTB").has_value() );
+}
+
+TEST_CASE("downsample")
+{
+  using namespace thermos;
+
+  std::vector<int64_t> times;
+  std::vector<int64_t> values;
+  fill(times, values, 10000, 4321);
+  std::vector<int64_t> out_times;
+  std::vector<int64_t> out_values;
+  downsampling options;
+  options.points = 100;
+
+  SECTION("no downsampling copies the range")
+  {
+    options.method = downsampling_method::none;
+    downsample(times, values, 10, 5000, options, out_times, out_values);
+    REQUIRE( out_times == std::vector<int64_t>(times.begin() + 10, times.begin() + 5000) );
+    REQUIRE( out_values == std::vector<int64_t>(values.begin() + 10, values.begin() + 5000) );
+  }
+
+  SECTION("ranges with few readings are copied")
+  {
+    options.method = GENERATE(downsampling_method::lttb, downsampling_method::min_max, downsampling_method::average);
+    downsample(times, values, 100, 200, options, out_times, out_values);
+    REQUIRE( out_times == std::vector<int64_t>(times.begin() + 100, times.begin() + 200) );
+    REQUIRE( out_values == std::vector<int64_t>(values.begin() + 100, values.begin() + 200) );
+
+    downsample(times, values, 100, 100, options, out_times, out_values);
+    REQUIRE( out_times.empty() );
+    REQUIRE( out_values.empty() );
+  }
+
+  SECTION("LTTB")
+  {
+    options.method = downsampling_method::lttb;
+    downsample(times, values, 0, times.size(), options, out_times, out_values);
+    REQUIRE( out_times.size() == 100 );
+    REQUIRE( out_values.size() == 100 );
+    REQUIRE( out_times.front() == times.front() );
+    REQUIRE( out_times.back() == times.back() );
+    REQUIRE( std::is_sorted(out_times.begin(), out_times.end()) );
+    // The spike forms the largest triangle in its bucket.
+    REQUIRE( std::find(out_times.begin(), out_times.end(), times[4321]) != out_times.end() );
+    REQUIRE( *std::max_element(out_values.begin(), out_values.end()) == 90000 );
+
+    // at least three points
+    options.points = 1;
+    downsample(times, values, 0, times.size(), options, out_times, out_values);
+    REQUIRE( out_times.size() == 3 );
+  }
+
+  SECTION("minimum and maximum")
+  {
+    options.method = downsampling_method::min_max;
+    downsample(times, values, 0, times.size(), options, out_times, out_values);
+    REQUIRE( out_times.size() == 100 );
+    REQUIRE( out_values.size() == 100 );
+    REQUIRE( std::is_sorted(out_times.begin(), out_times.end()) );
+    REQUIRE( std::find(out_times.begin(), out_times.end(), times[4321]) != out_times.end() );
+    REQUIRE( *std::max_element(out_values.begin(), out_values.end()) == 90000 );
+    REQUIRE( *std::min_element(out_values.begin(), out_values.end()) == 40000 );
+  }
+
+  SECTION("average")
+  {
+    options.method = downsampling_method::average;
+    options.points = 500;
+    downsample(times, values, 0, times.size(), options, out_times, out_values);
+    REQUIRE( out_times.size() == 500 );
+    REQUIRE( out_values.size() == 500 );
+    REQUIRE( std::is_sorted(out_times.begin(), out_times.end()) );
+    // Every bucket contains exactly one period of the zigzag pattern.
+    REQUIRE( out_times[0] == times[0] + 60 * 19 / 2 );
+    REQUIRE( out_values[0] == 40950 );
+    REQUIRE( out_values[216] == 40950 + (90000 - 40000 - 100) / 20 );
+  }
+
+  SECTION("batch of readings")
+  {
+    thermal::reading_batch batch;
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+      batch.push_back(device_registry::intern(device((i < 5000) ? "a" : "b", "origin")), times[i], values[i]);
+    }
+    thermal::reading_batch result;
+    result.push_back(device_registry::no_device, 1, 2);
+    options.method = downsampling_method::lttb;
+    downsample(batch, 5000, 10000, options, result);
+    REQUIRE( result.size() == 100 );
+    REQUIRE( result.devices.size() == 100 );
+    REQUIRE( std::all_of(result.devices.begin(), result.devices.end(),
+        [](const device_handle h) { return h == device_registry::intern(device("b", "origin")); }) );
+    REQUIRE( result.times.front() == times[5000] );
+    REQUIRE( result.times.back() == times.back() );
+  }
+}
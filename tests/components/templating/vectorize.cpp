@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -83,3 +83,69 @@ TEST_CASE("vectorize")
     }
   }
 }
+
+TEST_CASE("vectorize: reading batch")
+{
+  using namespace thermos;
+
+  SECTION("empty")
+  {
+    const auto vec = vectorize(thermal::reading_batch());
+    REQUIRE( vec.has_value() );
+    REQUIRE( vec.value().dates == "[]" );
+    REQUIRE( vec.value().values == "[]" );
+  }
+
+  SECTION("CPU load readings")
+  {
+    load::reading_batch batch;
+    load::device_reading reading;
+    reading.reading.value = 450;
+    reading.reading.time = to_time(1999, 12, 31, 12, 34, 56);
+    batch.push_back(reading);
+    reading.reading.value = 26;
+    reading.reading.time = to_time(2022, 1, 2, 3, 4, 5);
+    batch.push_back(reading);
+
+    const auto vec = vectorize(batch);
+    REQUIRE( vec.has_value() );
+    REQUIRE( vec.value().dates == "[\"1999-12-31 12:34:56\",\"2022-01-02 03:04:05\"]" );
+    REQUIRE( vec.value().values == "[450,26]" );
+  }
+
+  SECTION("temperature readings")
+  {
+    thermal::reading_batch batch;
+    thermal::device_reading reading;
+    reading.reading.value = 24500;
+    reading.reading.time = to_time(2022, 4, 23, 14, 12, 12);
+    batch.push_back(reading);
+    reading.reading.value = 26000;
+    reading.reading.time = to_time(2022, 5, 23, 15, 16, 17);
+    batch.push_back(reading);
+
+    const auto vec = vectorize(batch);
+    REQUIRE( vec.has_value() );
+    REQUIRE( vec.value().dates == "[\"2022-04-23 14:12:12\",\"2022-05-23 15:16:17\"]" );
+    REQUIRE( vec.value().values == "[24.5,26]" );
+  }
+
+  SECTION("range of readings")
+  {
+    thermal::reading_batch batch;
+    batch.push_back(device_registry::no_device, 1650723132, 24500);
+    batch.push_back(device_registry::no_device, 1650723133, 25000);
+    batch.push_back(device_registry::no_device, 1650723134, 25500);
+
+    auto vec = vectorize(batch, 1, 3);
+    REQUIRE( vec.has_value() );
+    REQUIRE( vec.value().values == "[25,25.5]" );
+
+    vec = vectorize(batch, 1, 1);
+    REQUIRE( vec.has_value() );
+    REQUIRE( vec.value().values == "[]" );
+
+    REQUIRE_FALSE( vectorize(batch, 2, 1).has_value() );
+    REQUIRE_FALSE( vectorize(batch, 0, 4).has_value() );
+  }
+}
@@ -0,0 +1,130 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+// Benchmark for a complete sample of the Linux readers, i. e. what the logger
+// does for every reading. It is hidden from the default test run, because it
+// takes a while. Run it explicitly via
+//
+//     component_tests "[benchmark]"
+
+#include "../find_catch.hpp"
+#include "../../../lib/thermal/read_linux.hpp"
+#if defined(__linux__) || defined(linux)
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+#include "../../../lib/load/read_linux.hpp"
+#include "../fake_sysfs.hpp"
+
+namespace
+{
+
+/* Gets the number of read system calls of the process so far, as counted by
+   the kernel in /proc/self/io. Returns an empty optional, if the kernel does
+   not provide that information. */
+std::optional<uint64_t> read_syscalls()
+{
+  std::ifstream stream("/proc/self/io");
+  std::string key;
+  uint64_t value = 0;
+  while (stream >> key >> value)
+  {
+    if (key == "syscr:")
+      return value;
+  }
+  return std::nullopt;
+}
+
+double per_second(const std::size_t count, const std::chrono::steady_clock::duration elapsed)
+{
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("Linux readers: benchmark", "[.][benchmark]")
+{
+  struct tree_size
+  {
+    unsigned int zones;
+    unsigned int chips;
+    unsigned int sensors;
+  };
+
+  // From a small laptop up to a large server.
+  const tree_size sizes[] = { { 2, 2, 4 }, { 8, 6, 8 }, { 32, 16, 32 } };
+  constexpr std::size_t samples = 2000;
+
+  for (const auto& size: sizes)
+  {
+    // Sensors are cached per root directory, so every tree needs its own.
+    const std::filesystem::path root = "linux-readers-benchmark-" + std::to_string(size.zones)
+        + "-" + std::to_string(size.chips) + "-" + std::to_string(size.sensors);
+    REQUIRE( create_fake_sysfs(root, size.zones, size.chips, size.sensors) );
+    const std::size_t sensors = size.zones + size.chips * size.sensors;
+
+    // The first call discovers the sensors. Like the logger, the benchmark
+    // keeps /proc/loadavg open between samples.
+    const auto discovery_start = std::chrono::steady_clock::now();
+    REQUIRE( thermos::linux_like::thermal::read_all(root).has_value() );
+    const auto loadavg = thermos::linux_like::load::loadavg_reader::open(root);
+    REQUIRE( loadavg.has_value() );
+    const auto discovery_elapsed = std::chrono::steady_clock::now() - discovery_start;
+
+    std::size_t readings = 0;
+    std::size_t failures = 0;
+    const auto syscalls_before = read_syscalls();
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < samples; ++i)
+    {
+      const auto thermal = thermos::linux_like::thermal::read_all(root);
+      const auto load = loadavg.value().read();
+      if (thermal.has_value() && load.has_value())
+      {
+        readings += thermal.value().size() + load.value().size();
+      }
+      else
+      {
+        ++failures;
+      }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const auto syscalls_after = read_syscalls();
+
+    std::cout << size.zones << " zones, " << size.chips << " chips with "
+              << size.sensors << " sensors each (" << sensors << " sensors):\n"
+              << "  discovery: " << std::chrono::duration<double, std::milli>(discovery_elapsed).count() << " ms\n"
+              << "  samples:   " << per_second(samples, elapsed) << " samples/s\n";
+    if (syscalls_before.has_value() && syscalls_after.has_value())
+    {
+      std::cout << "  read system calls per sample: "
+                << static_cast<double>(syscalls_after.value() - syscalls_before.value()) / samples << "\n";
+    }
+
+    REQUIRE( failures == 0 );
+    REQUIRE( readings == samples * (sensors + 3) );
+    REQUIRE( std::filesystem::remove_all(root) > 0 );
+  }
+}
+
+#endif // Linux
@@ -1,7 +1,7 @@
 /*
  -------------------------------------------------------------------------------
     This file is part of the test suite for thermos.
-    Copyright (C) 2022  Dirk Stolle
+    Copyright (C) 2022, 2026  Dirk Stolle
 
     This program is free software: you can redistribute it and/or modify
     it under the terms of the GNU General Public License as published by
@@ -19,6 +19,7 @@
 */
 
 #include "../find_catch.hpp"
+#include <cstring>
 #include "../../../lib/thermal/reading.hpp"
 
 TEST_CASE("thermal::reading constructor")
@@ -42,6 +43,29 @@ TEST_CASE("thermal::reading::type()")
     thermal::reading reading;
     REQUIRE( reading.type() == reading_type::temperature );
   }
+
+  SECTION("type is known at compile time")
+  {
+    constexpr reading_type type = thermal::reading::type();
+    REQUIRE( type == reading_type::temperature );
+  }
+}
+
+TEST_CASE("thermal::reading is a plain value")
+{
+  using namespace thermos;
+
+  REQUIRE( std::is_trivially_copyable<thermal::reading>::value );
+  REQUIRE( sizeof(thermal::reading) == 16 );
+
+  thermal::reading original;
+  original.value = 42000;
+  original.time = std::chrono::system_clock::now();
+
+  thermal::reading copy;
+  std::memcpy(&copy, &original, sizeof(original));
+  REQUIRE( copy.value == original.value );
+  REQUIRE( copy.time == original.time );
 }
 
 TEST_CASE("thermal::reading::celsius()")
@@ -0,0 +1,209 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+#include "../find_catch.hpp"
+#include "../../../lib/thermal/sensors_linux.hpp"
+#if defined(__linux__) || defined(linux)
+#include <algorithm>
+#include <fstream>
+#include "../../../lib/thermal/read_linux.hpp"
+#include "../fake_sysfs.hpp"
+
+TEST_CASE("thermal: parse_sensor_value")
+{
+  using namespace thermos::linux_like::thermal;
+
+  SECTION("valid values")
+  {
+    REQUIRE( parse_sensor_value("42000\n") == 42000 );
+    REQUIRE( parse_sensor_value("42000") == 42000 );
+    REQUIRE( parse_sensor_value("0\n") == 0 );
+    REQUIRE( parse_sensor_value("-5500\n") == -5500 );
+    REQUIRE( parse_sensor_value("123456789012345678") == 123456789012345678 );
+  }
+
+  SECTION("invalid values")
+  {
+    REQUIRE_FALSE( parse_sensor_value("").has_value() );
+    REQUIRE_FALSE( parse_sensor_value("\n").has_value() );
+    REQUIRE_FALSE( parse_sensor_value("-\n").has_value() );
+    REQUIRE_FALSE( parse_sensor_value("12a\n").has_value() );
+    REQUIRE_FALSE( parse_sensor_value("1 2\n").has_value() );
+    REQUIRE_FALSE( parse_sensor_value("+12\n").has_value() );
+    REQUIRE_FALSE( parse_sensor_value("12\n\n").has_value() );
+    REQUIRE_FALSE( parse_sensor_value("1234567890123456789").has_value() );
+  }
+}
+
+TEST_CASE("thermal: match_temperature_label")
+{
+  using namespace thermos::linux_like::thermal;
+
+  SECTION("matching names")
+  {
+    REQUIRE( match_temperature_label("temp1_label") == "temp1" );
+    REQUIRE( match_temperature_label("temp0_label") == "temp0" );
+    REQUIRE( match_temperature_label("temp123_label") == "temp123" );
+  }
+
+  SECTION("names that do not match")
+  {
+    REQUIRE_FALSE( match_temperature_label("").has_value() );
+    REQUIRE_FALSE( match_temperature_label("temp_label").has_value() );
+    REQUIRE_FALSE( match_temperature_label("temp1_input").has_value() );
+    REQUIRE_FALSE( match_temperature_label("temp1_label~").has_value() );
+    REQUIRE_FALSE( match_temperature_label("xtemp1_label").has_value() );
+    REQUIRE_FALSE( match_temperature_label("tempA_label").has_value() );
+    REQUIRE_FALSE( match_temperature_label("temp1a_label").has_value() );
+    REQUIRE_FALSE( match_temperature_label("in0_label").has_value() );
+    REQUIRE_FALSE( match_temperature_label("Temp1_label").has_value() );
+  }
+}
+
+TEST_CASE("thermal: sensor_set")
+{
+  using namespace thermos;
+  using namespace thermos::linux_like::thermal;
+
+  const std::filesystem::path root = "thermal-sensor-set";
+  REQUIRE( create_fake_sysfs(root, 3, 2, 4) );
+  const auto thermal_directory = root / "sys" / "devices" / "virtual" / "thermal";
+  const auto hwmon_directory = root / "sys" / "class" / "hwmon";
+
+  SECTION("discover sensors below a root directory")
+  {
+    const auto sensors = sensor_set::discover(root);
+    REQUIRE( sensors.has_value() );
+    REQUIRE( sensors.value().size() == 3 + 2 * 4 );
+    REQUIRE_FALSE( sensor_set::discover(root / "does-not-exist").has_value() );
+  }
+
+  SECTION("discover sensors of thermal zones and hardware monitors")
+  {
+    sensor_set sensors;
+    REQUIRE_FALSE( sensors.add_thermal(thermal_directory).has_value() );
+    REQUIRE( sensors.size() == 3 );
+    REQUIRE_FALSE( sensors.add_hwmon(hwmon_directory).has_value() );
+    REQUIRE( sensors.size() == 3 + 2 * 4 );
+
+    const auto readings = sensors.read();
+    REQUIRE( readings.has_value() );
+    REQUIRE( readings.value().size() == 11 );
+    for (unsigned int z = 0; z < 3; ++z)
+    {
+      const auto name = "zone " + std::to_string(z);
+      const auto found = std::find_if(readings.value().begin(), readings.value().end(),
+          [&name](const thermal::device_reading& r) { return device_registry::get(r.dev).name == name; });
+      REQUIRE( found != readings.value().end() );
+      REQUIRE( found->reading.value == fake_zone_temperature(z) );
+      REQUIRE( device_registry::get(found->dev).origin == (thermal_directory / ("thermal_zone" + std::to_string(z)) / "temp").native() );
+    }
+    for (unsigned int c = 0; c < 2; ++c)
+    {
+      for (unsigned int s = 1; s <= 4; ++s)
+      {
+        const auto name = "chip " + std::to_string(c) + " sensor " + std::to_string(s);
+        const auto found = std::find_if(readings.value().begin(), readings.value().end(),
+            [&name](const thermal::device_reading& r) { return device_registry::get(r.dev).name == name; });
+        REQUIRE( found != readings.value().end() );
+        REQUIRE( found->reading.value == fake_hwmon_temperature(c, s) );
+      }
+    }
+  }
+
+  SECTION("repeated reads see new values")
+  {
+    sensor_set sensors;
+    REQUIRE_FALSE( sensors.add_thermal(thermal_directory).has_value() );
+    const auto zone = thermal_directory / "thermal_zone1" / "temp";
+    {
+      std::ofstream stream(zone, std::ios::out | std::ios::trunc);
+      stream << "-1250\n";
+    }
+    const auto readings = sensors.read();
+    REQUIRE( readings.has_value() );
+    const auto found = std::find_if(readings.value().begin(), readings.value().end(),
+        [](const thermal::device_reading& r) { return device_registry::get(r.dev).name == "zone 1"; });
+    REQUIRE( found != readings.value().end() );
+    REQUIRE( found->reading.value == -1250 );
+  }
+
+  SECTION("thermal zones that cannot be read are skipped")
+  {
+    std::ofstream(thermal_directory / "thermal_zone0" / "temp", std::ios::out | std::ios::trunc) << "unavailable\n";
+    REQUIRE( std::filesystem::remove(thermal_directory / "thermal_zone2" / "temp") );
+    sensor_set sensors;
+    REQUIRE_FALSE( sensors.add_thermal(thermal_directory).has_value() );
+    REQUIRE( sensors.size() == 1 );
+  }
+
+  SECTION("invalid values fail the read")
+  {
+    sensor_set sensors;
+    REQUIRE_FALSE( sensors.add_hwmon(hwmon_directory).has_value() );
+    std::ofstream(hwmon_directory / "hwmon0" / "temp2_input", std::ios::out | std::ios::trunc) << "garbage\n";
+    const auto readings = sensors.read();
+    REQUIRE_FALSE( readings.has_value() );
+    REQUIRE( readings.error().find("temp2_input") != std::string::npos );
+  }
+
+  SECTION("labels without input file are skipped")
+  {
+    REQUIRE( std::filesystem::remove(hwmon_directory / "hwmon0" / "temp3_input") );
+    std::ofstream(hwmon_directory / "hwmon0" / "temp9_input") << "1000\n";
+    sensor_set sensors;
+    REQUIRE_FALSE( sensors.add_hwmon(hwmon_directory).has_value() );
+    REQUIRE( sensors.size() == 2 * 4 - 1 );
+  }
+
+  SECTION("missing directories")
+  {
+    sensor_set sensors;
+    REQUIRE( sensors.add_thermal(root / "does-not-exist").has_value() );
+    REQUIRE( sensors.add_hwmon(root / "does-not-exist").has_value() );
+    REQUIRE( sensors.size() == 0 );
+  }
+
+  SECTION("read_thermal and read_hwmon")
+  {
+    const auto zones = read_thermal(root);
+    REQUIRE( zones.has_value() );
+    REQUIRE( zones.value().size() == 3 );
+    const auto chips = read_hwmon(root);
+    REQUIRE( chips.has_value() );
+    REQUIRE( chips.value().size() == 8 );
+    REQUIRE_FALSE( read_thermal(root / "does-not-exist").has_value() );
+    REQUIRE_FALSE( read_hwmon(root / "does-not-exist").has_value() );
+  }
+
+  SECTION("read_all with root directory")
+  {
+    const auto readings = read_all(root);
+    REQUIRE( readings.has_value() );
+    REQUIRE( readings.value().size() == 3 + 2 * 4 );
+    // Sensors are cached per root directory.
+    REQUIRE_FALSE( read_all(root / "does-not-exist").has_value() );
+    REQUIRE( read_all(root).has_value() );
+  }
+
+  REQUIRE( std::filesystem::remove_all(root) > 0 );
+}
+
+#endif // Linux
@@ -0,0 +1,314 @@
+/*
+ -------------------------------------------------------------------------------
+    This file is part of the test suite for thermos.
+    Copyright (C) 2026  Dirk Stolle
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ -------------------------------------------------------------------------------
+*/
+
+// Benchmarks for finding and reading the temperature sensors. They are hidden
+// from the default test run, because they take a while. Run them explicitly via
+//
+//     component_tests "[benchmark]"
+
+#include "../find_catch.hpp"
+#include "../../../lib/thermal/sensors_linux.hpp"
+#if defined(__linux__) || defined(linux)
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <regex>
+#include "../fake_sysfs.hpp"
+
+namespace
+{
+
+using readings_t = std::vector<thermos::thermal::device_reading>;
+
+std::optional<std::string> legacy_first_line(const std::filesystem::path& path)
+{
+  std::ifstream stream(path);
+  std::string line;
+  if (!stream.good() || !std::getline(stream, line))
+    return std::nullopt;
+  return line;
+}
+
+/* Reads the thermal zones the way read_thermal() did before: the directory is
+   walked, checked via exists() and every file is opened via std::ifstream on
+   every call. */
+void legacy_read_thermal(const std::filesystem::path& directory, readings_t& readings)
+{
+  std::error_code error;
+  for (const auto& entry: std::filesystem::directory_iterator(directory, error))
+  {
+    if (!entry.is_directory(error) || error)
+      continue;
+    const auto type = entry.path() / "type";
+    const auto temperature = entry.path() / "temp";
+    if (!std::filesystem::exists(type, error) || !std::filesystem::exists(temperature, error))
+      continue;
+    const auto name = legacy_first_line(type);
+    const auto value = legacy_first_line(temperature);
+    if (!name.has_value() || !value.has_value())
+      continue;
+    thermos::thermal::device_reading reading;
+    reading.reading.value = std::stoll(value.value());
+    reading.dev = thermos::device_registry::intern(thermos::device(name.value(), temperature.native()));
+    reading.reading.time = std::chrono::system_clock::now();
+    readings.emplace_back(reading);
+  }
+}
+
+/* Reads one hardware monitor directory the way read_hwmon_devices() did
+   before, including the construction of the regular expression. */
+void legacy_read_hwmon_devices(const std::filesystem::path& directory, readings_t& readings)
+{
+  std::error_code error;
+  const auto iterator = std::filesystem::directory_iterator(directory, error);
+  if (error)
+    return;
+  const std::regex label_exp("temp([0-9]+)_label");
+  for (const auto& entry: iterator)
+  {
+    if (!entry.is_regular_file(error) || error)
+      continue;
+    const auto fn = entry.path().filename().native();
+    if (!std::regex_match(fn, label_exp))
+      continue;
+    auto path_input{entry.path()};
+    path_input.replace_filename(fn.substr(0, fn.find("_label")) + "_input");
+    if (!std::filesystem::exists(path_input, error) || error)
+      continue;
+    const auto name = legacy_first_line(entry.path());
+    const auto value = legacy_first_line(path_input);
+    if (!name.has_value() || !value.has_value())
+      continue;
+    thermos::thermal::device_reading reading;
+    reading.reading.value = std::stoll(value.value());
+    reading.dev = thermos::device_registry::intern(thermos::device(name.value(), path_input.native()));
+    reading.reading.time = std::chrono::system_clock::now();
+    readings.emplace_back(reading);
+  }
+}
+
+void legacy_read_hwmon(const std::filesystem::path& directory, readings_t& readings)
+{
+  std::error_code error;
+  for (const auto& entry: std::filesystem::directory_iterator(directory, error))
+  {
+    if (entry.is_directory(error) && !error)
+    {
+      legacy_read_hwmon_devices(entry.path() / "device", readings);
+      legacy_read_hwmon_devices(entry.path(), readings);
+    }
+  }
+}
+
+/* Discovers the sensors of one hardware monitor directory the way
+   sensor_set::add_hwmon_device() did before: a std::regex is constructed for
+   every directory and exists() is called for every matching label. */
+void legacy_discover_hwmon_devices(const std::filesystem::path& directory, std::vector<thermos::linux_like::thermal::sensor>& sensors)
+{
+  std::error_code error;
+  const auto iterator = std::filesystem::directory_iterator(directory, error);
+  if (error)
+    return;
+  const std::regex label_exp("temp([0-9]+)_label");
+  for (const auto& entry: iterator)
+  {
+    if (!entry.is_regular_file(error) || error)
+      continue;
+    const auto fn = entry.path().filename().native();
+    if (!std::regex_match(fn, label_exp))
+      continue;
+    auto path_input{entry.path()};
+    path_input.replace_filename(fn.substr(0, fn.find("_label")) + "_input");
+    if (!std::filesystem::exists(path_input, error) || error)
+      continue;
+    const auto name = legacy_first_line(entry.path());
+    if (!name.has_value())
+      continue;
+    const auto dev = thermos::device_registry::intern(thermos::device(name.value(), path_input.native()));
+    auto input = thermos::linux_like::thermal::sensor::open(dev, path_input);
+    if (input.has_value())
+      sensors.emplace_back(std::move(input.value()));
+  }
+}
+
+int64_t sum_of_values(const readings_t& readings)
+{
+  int64_t sum = 0;
+  for (const auto& r: readings)
+  {
+    sum += r.reading.value;
+  }
+  return sum;
+}
+
+double per_second(const std::size_t count, const std::chrono::steady_clock::duration elapsed)
+{
+  const double seconds = std::chrono::duration<double>(elapsed).count();
+  return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0;
+}
+
+} // anonymous namespace
+
+TEST_CASE("thermal sensors: benchmark", "[.][benchmark]")
+{
+  using namespace thermos::linux_like::thermal;
+
+  // A machine with a few thermal zones and some chips with several sensors.
+  const std::filesystem::path root = "thermal-sensors-benchmark";
+  constexpr unsigned int zones = 8;
+  constexpr unsigned int chips = 6;
+  constexpr unsigned int sensors_per_chip = 8;
+  REQUIRE( create_fake_sysfs(root, zones, chips, sensors_per_chip) );
+  const auto thermal_directory = root / "sys" / "devices" / "virtual" / "thermal";
+  const auto hwmon_directory = root / "sys" / "class" / "hwmon";
+  constexpr std::size_t samples = 2000;
+  constexpr std::size_t sensors_total = zones + chips * sensors_per_chip;
+
+  int64_t legacy_sum = 0;
+  readings_t readings;
+  const auto legacy_start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < samples; ++i)
+  {
+    readings.clear();
+    legacy_read_thermal(thermal_directory, readings);
+    legacy_read_hwmon(hwmon_directory, readings);
+    legacy_sum += sum_of_values(readings);
+  }
+  const auto legacy_elapsed = std::chrono::steady_clock::now() - legacy_start;
+  REQUIRE( readings.size() == sensors_total );
+
+  int64_t cached_sum = 0;
+  std::size_t failures = 0;
+  const auto cached_start = std::chrono::steady_clock::now();
+  sensor_set sensors;
+  REQUIRE_FALSE( sensors.add_thermal(thermal_directory).has_value() );
+  REQUIRE_FALSE( sensors.add_hwmon(hwmon_directory).has_value() );
+  for (std::size_t i = 0; i < samples; ++i)
+  {
+    const auto current = sensors.read();
+    if (current.has_value())
+    {
+      cached_sum += sum_of_values(current.value());
+    }
+    else
+    {
+      ++failures;
+    }
+  }
+  const auto cached_elapsed = std::chrono::steady_clock::now() - cached_start;
+  REQUIRE( sensors.size() == sensors_total );
+
+  std::cout << "Reading " << sensors_total << " sensors " << samples << " times:\n"
+            << "  directory walk + ifstream: " << per_second(samples, legacy_elapsed) << " samples/s\n"
+            << "  open files + pread:        " << per_second(samples, cached_elapsed) << " samples/s\n";
+
+  REQUIRE( failures == 0 );
+  REQUIRE( cached_sum == legacy_sum );
+  REQUIRE( std::filesystem::remove_all(root) > 0 );
+}
+
+TEST_CASE("hwmon discovery: benchmark", "[.][benchmark]")
+{
+  using namespace thermos::linux_like::thermal;
+
+  // A large server: many chips with lots of sensors and other files, i. e.
+  // several thousand directory entries.
+  const std::filesystem::path root = "hwmon-discovery-benchmark";
+  constexpr unsigned int chips = 16;
+  constexpr unsigned int sensors_per_chip = 32;
+  REQUIRE( create_fake_sysfs(root, 0, chips, sensors_per_chip) );
+  const auto hwmon_directory = root / "sys" / "class" / "hwmon";
+  constexpr std::size_t rounds = 50;
+
+  // Matching of file names alone.
+  std::vector<std::string> names;
+  std::error_code error;
+  for (const auto& entry: std::filesystem::recursive_directory_iterator(hwmon_directory, error))
+  {
+    names.emplace_back(entry.path().filename().native());
+  }
+  constexpr std::size_t match_rounds = 200;
+  std::size_t regex_matches = 0;
+  const auto regex_start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < match_rounds; ++i)
+  {
+    const std::regex label_exp("temp([0-9]+)_label");
+    for (const auto& name: names)
+    {
+      regex_matches += std::regex_match(name, label_exp);
+    }
+  }
+  const auto regex_elapsed = std::chrono::steady_clock::now() - regex_start;
+
+  std::size_t matcher_matches = 0;
+  const auto matcher_start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < match_rounds; ++i)
+  {
+    for (const auto& name: names)
+    {
+      matcher_matches += match_temperature_label(name).has_value();
+    }
+  }
+  const auto matcher_elapsed = std::chrono::steady_clock::now() - matcher_start;
+
+  // Complete discovery, including opening of the files.
+  std::size_t legacy_found = 0;
+  const auto legacy_start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < rounds; ++i)
+  {
+    std::vector<sensor> sensors;
+    for (const auto& entry: std::filesystem::directory_iterator(hwmon_directory, error))
+    {
+      legacy_discover_hwmon_devices(entry.path() / "device", sensors);
+      legacy_discover_hwmon_devices(entry.path(), sensors);
+    }
+    legacy_found += sensors.size();
+  }
+  const auto legacy_elapsed = std::chrono::steady_clock::now() - legacy_start;
+
+  std::size_t found = 0;
+  std::size_t failures = 0;
+  const auto discovery_start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < rounds; ++i)
+  {
+    sensor_set sensors;
+    if (sensors.add_hwmon(hwmon_directory).has_value())
+    {
+      ++failures;
+    }
+    found += sensors.size();
+  }
+  const auto discovery_elapsed = std::chrono::steady_clock::now() - discovery_start;
+
+  std::cout << "Matching " << names.size() << " file names " << match_rounds << " times:\n"
+            << "  std::regex:   " << per_second(match_rounds, regex_elapsed) << " rounds/s\n"
+            << "  hand-written: " << per_second(match_rounds, matcher_elapsed) << " rounds/s\n"
+            << "Discovering " << chips * sensors_per_chip << " sensors " << rounds << " times:\n"
+            << "  std::regex + exists: " << per_second(rounds, legacy_elapsed) << " rounds/s\n"
+            << "  sorted names:        " << per_second(rounds, discovery_elapsed) << " rounds/s\n";
+
+  REQUIRE( failures == 0 );
+  REQUIRE( regex_matches == matcher_matches );
+  REQUIRE( found == rounds * chips * sensors_per_chip );
+  REQUIRE( legacy_found == found );
+  REQUIRE( std::filesystem::remove_all(root) > 0 );
+}
+
+#endif // Linux